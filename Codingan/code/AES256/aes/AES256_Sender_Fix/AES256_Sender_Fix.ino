@@ -6,6 +6,27 @@
 #include <stdint.h>
 #include <chrono>
 #include "PlaintextData.h"
+
+// 1 = catat siklus per scope (key setup, enkripsi, esp_now_send, callback);
+//     kirim 'p' lewat serial untuk dump tabel, 'r' untuk reset
+#define WSN_PROFILE 0
+#include <WsnProfile.h>
+
+// Sumber plaintext: 0 = dataset tetap di flash (PlaintextData.h, indeks DATASET_INDEX),
+//                   1 = data DHT22 sintetis SYNTHETIC_SIZE byte; ubah saat jalan dengan "n<byte>"
+#include <WsnPayload.h>
+#define PAYLOAD_SOURCE 0
+#define DATASET_INDEX 1
+#define SYNTHETIC_SIZE 10011
+
+// 1 = rekaman "TT.TT,HH.HH" dikirim sebagai biner delta/varint (WsnSensorCodec.h, ~1 byte per
+//     rekaman, bukan 11); AES256_Receiver_Fix mengembalikannya ke teks sebelum disimpan
+#include <WsnSensorCodec.h>
+#define SENSOR_CODEC 0
+
+// 1 = pesan dikompres LZ (WsnLz.h) sebelum enkripsi
+#include <WsnLz.h>
+#define LZ_COMPRESS 0
 using namespace std::chrono;
 
 const size_t BLOCK_SIZE = 16;
@@ -25,6 +46,73 @@ uint8_t iv[BLOCK_SIZE] = {
     0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10
 };
 
+WsnFlashPayload datasetPayload(plaintextSets[DATASET_INDEX], plaintextSetSizes[DATASET_INDEX]);
+WsnDht22Payload syntheticPayload(SYNTHETIC_SIZE);
+#if PAYLOAD_SOURCE
+WsnPayloadSource &payload = syntheticPayload;
+#else
+WsnPayloadSource &payload = datasetPayload;
+#endif
+
+uint32_t sensorIndex = 0;  // indeks rekaman pertama pesan berikutnya
+
+const float LZ_ENERGY_PER_BYTE_UJ = 4.269f;  // AES-256: (0.049434 - 0.028087) J / 5000 byte
+WsnLzCompressor lzCompressor;
+
+// 1 = IV CBC per pesan = AES-256(kunci, ID node + counter pesan) (WsnNonce.h), dikirim di depan
+//     ciphertext; AES256_Receiver_Fix harus MESSAGE_IV 1 juga. 0 = IV tetap format lama
+//     (plaintext sama -> ciphertext sama)
+#include <WsnNonce.h>
+#define MESSAGE_IV 1
+WsnNonceManager nonces;
+
+// 1 = enkripsi + kirim hanya saat DHT22 berubah, alarm, atau heartbeat (WsnReportPolicy.h)
+#include <WsnReportPolicy.h>
+#define REPORT_POLICY 0
+#define REPORT_HEARTBEAT_MS 60000
+WsnReportPolicy reportPolicy(wsnReportSenderConfig(REPORT_HEARTBEAT_MS));
+
+// 1 = sisa periode SLEEP_PERIOD_MS dipakai tidur, deep sleep jika SLEEP_DEEP 1 (WsnSleep.h)
+#include <WsnSleep.h>
+#define SLEEP_SCHEDULER 0
+#define SLEEP_PERIOD_MS 2000
+#define SLEEP_DEEP 0
+
+// 1 = pembacaan DHT22 dikumpulkan dan dikirim per batch (WsnBatch.h)
+#include <WsnBatch.h>
+#define BATCH_MODE 0
+#define BATCH_FRAMES 1
+#define BATCH_MAX_AGE_MS 60000
+
+WsnBatchConfig batchConfig() {
+    WsnBatchConfig config;
+    config.maxFrames = BATCH_FRAMES;
+    config.frameBytes = 250;
+    config.reserveBytes = MESSAGE_IV ? 32 : 16;  // padding PKCS7 (+ IV)
+    config.maxAgeMs = BATCH_MAX_AGE_MS;
+    config.binary = SENSOR_CODEC;
+    config.messageEnergyUj = 6695.0f;  // 0.028087 J - 5011 byte x marginal AES-256
+    config.byteEnergyUj = LZ_ENERGY_PER_BYTE_UJ;
+    return config;
+}
+
+WsnBatch<WSN_BATCH_CAPACITY(SLEEP_SCHEDULER && SLEEP_DEEP)> batch(batchConfig());
+
+bool initESPNow();
+WsnSleepScheduler sleepScheduler(wsnSleepSenderConfig(SLEEP_PERIOD_MS, SLEEP_DEEP, initESPNow));
+
+// Waktu untuk timestamp laporan/batch; dengan scheduler tetap naik melewati deep sleep
+uint32_t nodeMillis() {
+#if SLEEP_SCHEDULER
+    return sleepScheduler.nowMs();
+#else
+    return wsnMillis();
+#endif
+}
+
+// Peer MAC address of the receiver
+uint8_t receiverMac[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7};
+
 // Transmission State Variables
 size_t totalChunks = 0;
 size_t chunksAcked = 0;
@@ -42,7 +130,10 @@ void applyPadding(uint8_t *data, size_t len, size_t paddedLen) {
 // AES-256 CBC Encryption
 void aes256CbcEncrypt(const uint8_t *input, uint8_t *output, size_t len, const uint8_t key[32], uint8_t iv[BLOCK_SIZE]) {
     AES aes;
-    aes.set_key(key, 32);
+    {
+        WSN_PROFILE_SCOPE(WSN_PROF_KEY_SETUP);
+        aes.set_key(key, 32);
+    }
     uint8_t currentIv[BLOCK_SIZE];
     memcpy(currentIv, iv, BLOCK_SIZE); // Preserves original IV
 
@@ -60,26 +151,45 @@ void aes256CbcEncrypt(const uint8_t *input, uint8_t *output, size_t len, const u
 }
 
 // Function to encrypt a message
-uint8_t* encryptMessage(const char *plaintext, size_t &encryptedLen, unsigned long &encryptionTime) {
-    size_t messageLen = strlen(plaintext);
+uint8_t* encryptMessage(const uint8_t *plaintext, size_t messageLen, size_t &encryptedLen, unsigned long &encryptionTime) {
     size_t paddedLen = (messageLen + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
-    encryptedLen = paddedLen;
+#if MESSAGE_IV
+    const size_t ivLen = BLOCK_SIZE;
+    uint8_t nonceBlock[BLOCK_SIZE];
+    if (!nonces.next(nonceBlock, sizeof(nonceBlock))) {
+        Serial.println("Nonce checkpoint failed");
+        return nullptr;
+    }
+#else
+    const size_t ivLen = 0;
+#endif
+    encryptedLen = ivLen + paddedLen;
 
-    uint8_t *ciphertext = (uint8_t *)malloc(paddedLen);
+    uint8_t *ciphertext = (uint8_t *)malloc(encryptedLen);
     if (!ciphertext) {
         Serial.println("Failed to allocate encryption buffer");
         return nullptr;
     }
+    uint8_t *body = ciphertext + ivLen;
 
     // Copy data to buffer and apply padding
-    memcpy(ciphertext, plaintext, messageLen);
-    applyPadding(ciphertext, messageLen, paddedLen);
+    memcpy(body, plaintext, messageLen);
+    applyPadding(body, messageLen, paddedLen);
 
     // Encrypt the data
     auto start = high_resolution_clock::now();
-    aes256CbcEncrypt(ciphertext, ciphertext, paddedLen, key, iv);
+    {
+        WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+#if MESSAGE_IV
+        // IV counter harus tidak bisa ditebak untuk CBC: enkripsi blok nonce dengan kunci pesan
+        AES aes;
+        aes.set_key(key, 32);
+        aes.encrypt(nonceBlock, iv);
+        memcpy(ciphertext, iv, BLOCK_SIZE);
+#endif
+        aes256CbcEncrypt(body, body, paddedLen, key, iv);
+    }
     auto end = high_resolution_clock::now();
-    delay(2000);
 
     encryptionTime = duration_cast<microseconds>(end - start).count();
 
@@ -94,7 +204,12 @@ bool sendEncryptedData(uint8_t *data, size_t len) {
 
     for (size_t i = 0; i < len; i += 250) {
         size_t chunkSize = min((size_t)250, len - i);
-        if (esp_now_send(nullptr, data + i, chunkSize) != 0) {
+        int sendResult;
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_ESPNOW_SEND);
+            sendResult = esp_now_send(nullptr, data + i, chunkSize);
+        }
+        if (sendResult != 0) {
             Serial.println("Error sending data");
             return false;
         }
@@ -112,6 +227,7 @@ bool sendEncryptedData(uint8_t *data, size_t len) {
 
 // Transmission Callback
 void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
+    WSN_PROFILE_SCOPE(WSN_PROF_SEND_CALLBACK);
     if (deliveryStatus == 0) {  // If transmission is successful
         status = true;
         chunksAcked++; // Increment ACK counter
@@ -129,35 +245,126 @@ void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
     // }
 }
 
-void setup() {
-    Serial.begin(115200);
-    WiFi.mode(WIFI_STA);
-
+bool initESPNow() {
     if (esp_now_init() != 0) {
         Serial.println("Error initializing ESP-NOW");
-        ESP.restart();
+        return false;
     }
 
     esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);
     esp_now_register_send_cb(onSend); // Register the send callback
+    return true;
+}
+
+// Akhir siklus: tidur sampai periode berikutnya, atau tunggu 2 detik
+void waitNextCycle() {
+#if SLEEP_SCHEDULER
+    Serial.flush();
+    sleepScheduler.sleep();
+#else
+    delay(2000);
+#endif
+}
 
-    // Set peer MAC address of the receiver
-    uint8_t receiverMac[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7};
-    esp_now_add_peer(receiverMac, ESP_NOW_ROLE_SLAVE, 1, NULL, 0);
+void setup() {
+    Serial.begin(115200);
+#if MESSAGE_IV
+    nonces.begin();
+#endif
+#if SLEEP_SCHEDULER
+    // Batch dan kebijakan laporan dipulihkan dari RTC memory saat bangun dari deep sleep
+    sleepScheduler.keep(wsnSleepPart(batch, WSN_RTC_BATCH_OFFSET));
+    sleepScheduler.keep(wsnSleepPart(reportPolicy, WSN_RTC_POLICY_OFFSET));
+    sleepScheduler.begin();
+#endif
+    sleepScheduler.startRadio(receiverMac, 1);
 }
 
 void loop() {
-    
-    size_t plaintextSize = strlen(plaintextSets[1]);
+#if REPORT_POLICY || BATCH_MODE
+    WsnReportCycle report = wsnReportCycle(REPORT_POLICY ? &reportPolicy : nullptr, nodeMillis(), Serial);
+    if (!report.send) {
+        waitNextCycle();
+        return;
+    }
+#endif
+#if BATCH_MODE
+    WsnBatchFlush flush = batch.add(report.temperature, report.humidity, nodeMillis());
+    if (flush == WSN_BATCH_KEEP) {
+        waitNextCycle();
+        return;
+    }
+#endif
+
+    // Plaintext hanya ada di heap selama satu siklus
+#if BATCH_MODE
+    size_t batchLen;
+    char *plaintext = batch.takeTextAlloc(flush, batchLen);
+#else
+    char *plaintext = wsnPayloadLoadText(payload);
+#endif
+    if (plaintext == nullptr) {
+        Serial.println("Memory allocation failed!");
+        waitNextCycle();
+        return;
+    }
+
+    size_t plaintextSize = strlen(plaintext);
     size_t encryptedLen = 0;
     unsigned long encryptionTime = 0;
 
+    const uint8_t *message = (const uint8_t *)plaintext;
+    size_t messageLen = plaintextSize;
+#if SENSOR_CODEC
+    // Teks tanpa rekaman sensor (plaintextTesting) tetap dikirim apa adanya
+    uint8_t *encoded = wsnSensorEncodeAlloc(plaintext, plaintextSize, messageLen, sensorIndex);
+    if (encoded != nullptr) {
+        message = encoded;
+        Serial.print("Sensor codec: ");
+        Serial.print(plaintextSize);
+        Serial.print(" -> ");
+        Serial.print(messageLen);
+        Serial.println(" Byte (B)");
+    } else {
+        messageLen = plaintextSize;
+    }
+#endif
+#if LZ_COMPRESS
+    WsnLzStats lzStats;
+    size_t compressedLen;
+    uint8_t *compressed = wsnLzCompressAlloc(lzCompressor, message, messageLen, compressedLen, &lzStats);
+    if (compressed != nullptr) {
+        message = compressed;
+        messageLen = compressedLen;
+        Serial.print("LZ: ");
+        Serial.print(lzStats.inputBytes);
+        Serial.print(" -> ");
+        Serial.print(lzStats.outputBytes);
+        Serial.print(" Byte (B), ");
+        Serial.print(lzStats.micros);
+        Serial.print(" us, hemat ~");
+        Serial.print(wsnLzEnergySavedUj(lzStats, LZ_ENERGY_PER_BYTE_UJ), 0);
+        Serial.println(" uJ");
+    }
+#endif
+
     // Encrypt the message
-    uint8_t *ciphertext = encryptMessage(plaintextSets[1], encryptedLen, encryptionTime);
+    uint8_t *ciphertext = encryptMessage(message, messageLen, encryptedLen, encryptionTime);
+#if SENSOR_CODEC
+    free(encoded);
+#endif
+#if LZ_COMPRESS
+    free(compressed);
+#endif
+    // Jeda ini dulu berada di dalam encryptMessage (di antara start dan cetak waktu);
+    // dipindah ke sini tanpa mengubah cadence pengiriman. Dengan scheduler node tidur setelah kirim.
+#if !SLEEP_SCHEDULER
+    delay(2000);
+#endif
 
     if (ciphertext != nullptr) {
         Serial.print("Plaintext:  ");
-        Serial.println(plaintextSets[1]);        
+        Serial.println(plaintext);
         Serial.print("Encrypted Data: ");
         for (size_t i = 0; i < encryptedLen; i++) {
             Serial.print(ciphertext[i], HEX); // Print each byte in hexadecimal
@@ -176,13 +383,42 @@ void loop() {
 
         // Send encrypted data
         sendEncryptedData(ciphertext, encryptedLen);
+#if REPORT_POLICY
+        reportPolicy.setFramesPerReport(totalChunks);
+#endif
+#if BATCH_MODE
+        const WsnBatchStats &batchStats = batch.stats();
+        Serial.print(F("Batch "));
+        Serial.print(flush == WSN_BATCH_AGE ? F("age: ") : F("size: "));
+        Serial.print(batchStats.lastCount);
+        Serial.print(F(" pembacaan, "));
+        Serial.print(batchStats.lastBytes);
+        Serial.print(F(" bytes, "));
+        Serial.print(batchStats.lastEnergyPerReadingUj, 1);
+        Serial.print(F(" uJ/pembacaan (tanpa batch "));
+        Serial.print(batchStats.unbatchedEnergyPerReadingUj, 1);
+        Serial.println(F(")"));
+#endif
         if (allChunksSent == false) {
         Serial.println("Chunks failed to send");
     };
         // Free dynamically allocated memory
         free(ciphertext);
     }
+    free(plaintext);
+
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') syntheticPayload.resize(Serial.parseInt());  // mis. "n4096"
+#if SLEEP_SCHEDULER
+        else if (command == 's') sleepScheduler.printResidency(Serial);
+#endif
+#if WSN_PROFILE
+        else if (command == 'p') WSN_PROFILE_DUMP(Serial);
+        else if (command == 'r') WSN_PROFILE_RESET();
+#endif
+    }
 
-    delay(2000); // Send data every 2 seconds
     Serial.println("------------------------------------------------");
+    waitNextCycle(); // Send data every 2 seconds
 }
@@ -2,10 +2,10 @@
 #define PLAINTEXTDATA_H
 
 // Define multiple plaintext arrays
-const char* plaintextTesting  = 
+static const char plaintextTesting[] PROGMEM =
     "Encryption and Decryption Testing";
 
-const char* plaintext10kb =
+static const char plaintext10kb[] PROGMEM =
     "Data Suhu: "
     "30.80,73.80"
     "30.80,73.80"
@@ -918,7 +918,7 @@ const char* plaintext10kb =
     "30.50,71.10"
     "dataEnd";
 
-const char* plaintext5kb = 
+static const char plaintext5kb[] PROGMEM =
     "Data Suhu: "
     "30.40,71.50"
     "30.40,71.50"
@@ -1377,12 +1377,9 @@ const char* plaintext5kb =
     "30.50,71.17"
     "dataEnd";
 
-// Array to hold pointers to the sets (optional for easier access)
-const char* plaintextSets[] = {plaintextTesting, plaintext10kb, plaintext5kb};
-
-// Get sizes of each array
-const size_t plaintextSet1Count = sizeof(plaintextTesting);
-const size_t plaintextSet2Count = sizeof(plaintext10kb);
-const size_t plaintextSet3Count = sizeof(plaintext5kb);
+// Dataset disimpan di flash (PROGMEM), tidak disalin ke DRAM. Jangan dibaca langsung dengan
+// strlen/Serial.print; pakai WsnFlashPayload (WsnPayload.h) dengan ukuran di bawah.
+const char *const plaintextSets[] = {plaintextTesting, plaintext10kb, plaintext5kb};
+const size_t plaintextSetSizes[] = {sizeof(plaintextTesting) - 1, sizeof(plaintext10kb) - 1, sizeof(plaintext5kb) - 1};
 
 #endif // PLAINTEXTDATA_H
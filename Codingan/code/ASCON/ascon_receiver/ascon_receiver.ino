@@ -0,0 +1,213 @@
+#include <ESP8266WiFi.h>
+#include <espnow.h>
+#include <SPI.h>
+#include <SD.h>
+#include <cstring>
+#include <stdint.h>
+#include <chrono>
+
+// Pasangan ascon_sender: pesan [nonce 16][tag 16][ciphertext] didekripsi dan diverifikasi
+// dengan ASCON (WsnAscon.h); pesan dengan tag salah dibuang tanpa ditulis ke SD.
+
+// 1 = catat siklus per scope (callback terima, dekripsi, tulis SD);
+//     kirim 'p' lewat serial untuk dump tabel, 'r' untuk reset
+#define WSN_PROFILE 0
+#include <WsnProfile.h>
+
+// Pesan biner (SENSOR_CODEC / LZ_COMPRESS di sender) dikembalikan ke teks asli sebelum disimpan
+#include <WsnSensorCodec.h>
+#include <WsnLz.h>
+
+// Harus sama dengan ASCON_VARIANT di ascon_sender
+#include <WsnAscon.h>
+#define ASCON_VARIANT WSN_ASCON_128A
+const size_t HEADER_SIZE = WSN_ASCON_NONCE_SIZE + WSN_ASCON_TAG_SIZE;
+uint32_t rejectedMessages = 0;
+using namespace std::chrono;
+
+#define MAX_INPUT_SIZE 16384
+#define MAX_CHUNK_SIZE 250
+#define TIMEOUT_MS 100 // Timeout 100ms untuk mendeteksi akhir transmisi
+#define SD_CS_PIN D8 // Ubah ini sesuai dengan Chip Select pin SD module
+
+// Key for ASCON
+uint8_t key[WSN_ASCON_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static int fileIndex = 0; // Untuk penamaan file data pada SD Card
+
+// Variabel untuk menyimpan data penerimaan
+uint8_t receivedData[MAX_INPUT_SIZE];
+size_t totalReceived = 0;
+unsigned long lastReceiveTime = 0;
+bool isReceiving = false;
+
+// Inisialisasi SD Card
+bool initSDCard() {
+    if (!SD.begin(SD_CS_PIN)) {
+        Serial.println("SD Card initialization failed!");
+        return false;
+    }
+    Serial.println("SD Card initialized successfully");
+    return true;
+}
+
+// Simpan hasil dekripsi ke SD Card
+bool saveDecryptedDataToSD(uint8_t* plaintext, size_t dataLen) {
+    WSN_PROFILE_SCOPE(WSN_PROF_SD_WRITE);
+    String filename = "/ascon_data_decrypted_" + String(fileIndex) + ".txt";
+    File dataFile = SD.open(filename, FILE_WRITE);
+
+    if (!dataFile) {
+        Serial.println("Error opening file for writing");
+        return false;
+    }
+
+    size_t bytesWritten = dataFile.write(plaintext, dataLen);
+    dataFile.close();
+
+    if (bytesWritten != dataLen) {
+        Serial.println("Error writing to file");
+        return false;
+    }
+
+    Serial.print("Data saved to ");
+    Serial.println(filename);
+    fileIndex++;
+    return true;
+}
+
+// Cetak hasil dekripsi
+void printDecryptedMessage(uint8_t* plaintext, uint64_t decryptionTime) {
+    Serial.print("Decrypted Data: ");
+    Serial.println((char*)plaintext);
+    Serial.print("Decryption Time: ");
+    Serial.print(decryptionTime);
+    Serial.println(" microseconds");
+    Serial.println("------------------------------------------------");
+}
+
+// Callback penerimaan data
+void onDataReceived(uint8_t *mac_addr, uint8_t *data, uint8_t len) {
+    WSN_PROFILE_SCOPE(WSN_PROF_RECV_CALLBACK);
+    if (totalReceived + len <= MAX_INPUT_SIZE) {
+        memcpy(receivedData + totalReceived, data, len);
+        totalReceived += len;
+        lastReceiveTime = millis();
+        isReceiving = true;
+    }
+}
+
+// Proses data diterima
+void processReceivedData() {
+    if (totalReceived > 0) {
+        if (totalReceived <= HEADER_SIZE) {
+            Serial.println("Invalid data! Not enough for header and ciphertext.");
+            totalReceived = 0;
+            isReceiving = false;
+            return;
+        }
+
+        const uint8_t* receivedNonce = receivedData;
+        const uint8_t* receivedTag = receivedData + WSN_ASCON_NONCE_SIZE;
+        size_t ciphertextLen = totalReceived - HEADER_SIZE;
+        uint8_t* ciphertext = receivedData + HEADER_SIZE;
+
+        Serial.print("Total Received Data Size: ");
+        Serial.print(ciphertextLen);
+        Serial.println(" bytes");
+
+        uint64_t decryptionTime = 0;
+        uint8_t* plaintext = (uint8_t *)malloc(ciphertextLen + 1);
+        if (plaintext == nullptr) {
+            Serial.println("Memory allocation failed!");
+            totalReceived = 0;
+            isReceiving = false;
+            return;
+        }
+
+        auto start = high_resolution_clock::now();
+        bool authentic = asconOpen(ASCON_VARIANT, key, receivedNonce, nullptr, 0, ciphertext, plaintext,
+                                   ciphertextLen, receivedTag);
+        auto end = high_resolution_clock::now();
+        decryptionTime = duration_cast<microseconds>(end - start).count();
+
+        if (!authentic) {
+            rejectedMessages++;
+            Serial.print("Tag mismatch, message dropped (");
+            Serial.print(rejectedMessages);
+            Serial.println(" total)");
+            free(plaintext);
+            totalReceived = 0;
+            isReceiving = false;
+            return;
+        }
+        plaintext[ciphertextLen] = '\0';
+
+        size_t plaintextLen = ciphertextLen;
+        // Pesan LZ dibuka dulu, baru sensor codec
+        size_t lzLen;
+        WsnLzStats lzStats;
+        uint8_t* unpacked = wsnLzDecompressAlloc(plaintext, plaintextLen, lzLen, &lzStats);
+        if (unpacked != nullptr) {
+            free(plaintext);
+            plaintext = unpacked;
+            plaintextLen = lzLen;
+        }
+
+        size_t textLen;
+        char* text = wsnSensorDecodeAlloc(plaintext, plaintextLen, textLen);
+        if (text != nullptr) {
+            free(plaintext);
+            plaintext = (uint8_t*)text;
+            plaintextLen = textLen;
+        }
+
+        printDecryptedMessage(plaintext, decryptionTime);
+        saveDecryptedDataToSD(plaintext, plaintextLen);
+
+        free(plaintext);
+        totalReceived = 0;
+        isReceiving = false;
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+
+    Serial.print("MAC Address: ");
+    Serial.println(WiFi.macAddress());
+
+    if (esp_now_init() != 0) {
+        Serial.println("Error initializing ESP-NOW");
+        ESP.restart();
+    }
+
+    if (!initSDCard()) {
+        Serial.println("SD Card initialization failed.");
+    }
+
+    esp_now_set_self_role(ESP_NOW_ROLE_SLAVE);
+    esp_now_register_recv_cb(onDataReceived);
+    Serial.println("Receiver Ready");
+}
+
+void loop() {
+    if (isReceiving && (millis() - lastReceiveTime > TIMEOUT_MS)) {
+        processReceivedData();
+    }
+
+    while (Serial.available()) {
+        char command = Serial.read();
+#if WSN_PROFILE
+        if (command == 'p') WSN_PROFILE_DUMP(Serial);
+        else if (command == 'r') WSN_PROFILE_RESET();
+#endif
+        (void)command;
+    }
+    yield();
+}
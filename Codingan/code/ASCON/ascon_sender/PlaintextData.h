@@ -0,0 +1,1385 @@
+#ifndef PLAINTEXTDATA_H
+#define PLAINTEXTDATA_H
+
+static const char plaintextTesting[] PROGMEM =
+    "Encryption and Decryption Testing";
+
+static const char plaintext10kb[] PROGMEM =
+    "Data Suhu: "
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.3"
+    "30.50,71.1"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "dataEnd";
+
+static const char plaintext5kb[] PROGMEM =
+    "Data Suhu: "
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.30"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.50,71.00"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.90"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.8"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.8"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.80"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.7"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,70.70"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.2"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.60,72.20"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.8"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.80,73.80"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.1"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,72.10"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.90"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.70"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.40,71.50"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.40"
+    "30.50,71.3"
+    "30.50,71.1"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.1"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.17"
+    "30.50,71.15"
+    "30.50,71.10"
+    "30.50,71.12"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.11"
+    "30.50,71.17"
+    "30.50,71.15"
+    "30.50,71.10"
+    "30.50,71.12"
+    "30.50,71.10"
+    "30.50,71.10"
+    "30.50,71.11"
+    "30.50,71.17"
+    "dataEnd";
+
+
+// Dataset disimpan di flash (PROGMEM), tidak disalin ke DRAM. Jangan dibaca langsung dengan
+// strlen/Serial.print; pakai WsnFlashPayload (WsnPayload.h) dengan ukuran di bawah.
+const char *const plaintextSets[] = {plaintextTesting, plaintext5kb, plaintext10kb};
+const size_t plaintextSetSizes[] = {sizeof(plaintextTesting) - 1, sizeof(plaintext5kb) - 1, sizeof(plaintext10kb) - 1};
+
+#endif // PLAINTEXTDATA_H
@@ -0,0 +1,286 @@
+#include <ESP8266WiFi.h>
+#include <espnow.h>
+#include <cstring>
+#include <stdint.h>
+#include <chrono>
+#include "PlaintextData.h"
+
+// Cipher kelima: ASCON-128 / ASCON-128a (WsnAscon.h, NIST Lightweight Cryptography),
+// dengan fragmentasi ESP-NOW yang sama seperti chacha_sender. Format pesan:
+//   [nonce 16][tag 16][ciphertext]
+// ascon_receiver memverifikasi tag sebelum menyimpan ke SD.
+
+// 1 = catat siklus per scope (enkripsi, fragment, esp_now_send, callback);
+//     kirim 'p' lewat serial untuk dump tabel, 'r' untuk reset
+#define WSN_PROFILE 0
+#include <WsnProfile.h>
+
+// Log per siklus sebagai record biner lewat ring buffer (WsnLog.h).
+// Baca dengan: python "visualisasi data/log_decode.py" COM3 --formats ascon_sender.ino
+#include <WsnLog.h>
+#define WSN_LOG_FORMATS(X)                                                \
+    X(LOG_ENCRYPT_TIME, "Encryption Time: %lu microseconds (us)")         \
+    X(LOG_PLAINTEXT, "Plaintext: %u bytes, awal \"%s\"")                  \
+    X(LOG_CIPHERTEXT, "Encrypted Data (HEX): %u bytes, header+awal %b")   \
+    X(LOG_SENSOR_CODEC, "Sensor codec: %u -> %u bytes (%u rekaman)")       \
+    X(LOG_LZ, "LZ: %u -> %u bytes, %u us")                                \
+    X(LOG_TOTAL_CHUNKS, "Total Chunks: %u")                               \
+    X(LOG_ALL_SENT, "All chunks sent successfully")                       \
+    X(LOG_CHUNK_FAILED, "Chunk Send Failed (chunk %u)")                   \
+    X(LOG_CYCLE_END, "------------------------------------------------")
+WSN_LOG_DECLARE(WSN_LOG_FORMATS)
+
+const size_t LOG_PREVIEW_BYTES = 16;  // cuplikan plaintext/ciphertext per pesan
+
+// Sumber plaintext: 0 = dataset tetap di flash (PlaintextData.h, indeks DATASET_INDEX),
+//                   1 = data DHT22 sintetis SYNTHETIC_SIZE byte; ubah saat jalan dengan "n<byte>"
+#include <WsnPayload.h>
+#define PAYLOAD_SOURCE 0
+#define DATASET_INDEX 2
+#define SYNTHETIC_SIZE 5011
+
+// 1 = rekaman "TT.TT,HH.HH" dikirim sebagai biner delta/varint (WsnSensorCodec.h)
+#include <WsnSensorCodec.h>
+#define SENSOR_CODEC 0
+uint32_t sensorIndex = 0;
+
+// 1 = pesan dikompres LZ (WsnLz.h) sebelum enkripsi; dilewati jika tidak lebih kecil
+#include <WsnLz.h>
+#define LZ_COMPRESS 0
+WsnLzCompressor lzCompressor;
+
+// WSN_ASCON_128 (rate 8 byte) atau WSN_ASCON_128A (rate 16 byte); harus sama dengan ascon_receiver
+#include <WsnAscon.h>
+#define ASCON_VARIANT WSN_ASCON_128A
+
+using namespace std::chrono;
+
+uint8_t receiverMAC[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7};
+
+// Global Configuration Constants
+const size_t MAX_CHUNK_SIZE = 250;
+const size_t MAX_INPUT_SIZE = 16384;
+
+// 128 bit key
+uint8_t key[WSN_ASCON_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+// Nonce 16 byte = ID node + counter pesan (WsnNonce.h) + 4 byte nol
+#include <WsnNonce.h>
+uint8_t nonce[WSN_ASCON_NONCE_SIZE];
+WsnNonceManager nonces;
+const size_t HEADER_SIZE = WSN_ASCON_NONCE_SIZE + WSN_ASCON_TAG_SIZE;
+
+WsnFlashPayload datasetPayload(plaintextSets[DATASET_INDEX], plaintextSetSizes[DATASET_INDEX]);
+WsnDht22Payload syntheticPayload(SYNTHETIC_SIZE);
+#if PAYLOAD_SOURCE
+WsnPayloadSource &payload = syntheticPayload;
+#else
+WsnPayloadSource &payload = datasetPayload;
+#endif
+
+// Transmission State Variables
+size_t totalChunks = 0;
+size_t chunksAcked = 0;
+bool allChunksSent = false;
+bool status = false;
+
+// Encryption Function
+uint8_t* encryptMessage(const uint8_t* plaintext, size_t len, size_t& encryptedLen, uint64_t& encryptionTime) {
+
+    // Validasi ukuran input
+    if (len > MAX_INPUT_SIZE) {
+        Serial.println("Input size exceeds maximum buffer size!");
+        return nullptr;
+    }
+
+    // Alokasikan memori untuk ciphertext (plaintext + nonce + tag)
+    size_t totalSize = len + HEADER_SIZE;
+    uint8_t* ciphertext = (uint8_t*)malloc(totalSize);
+    if (ciphertext == nullptr) {
+        Serial.println("Memory allocation failed!");
+        return nullptr;
+    }
+
+    if (!nonces.next(nonce, sizeof(nonce))) {
+        Serial.println("Nonce checkpoint failed!");
+        free(ciphertext);
+        return nullptr;
+    }
+
+    auto start = high_resolution_clock::now();
+
+    asconSeal(ASCON_VARIANT, key, nonce, nullptr, 0, plaintext, ciphertext + HEADER_SIZE, len,
+              ciphertext + WSN_ASCON_NONCE_SIZE);
+
+    auto end = high_resolution_clock::now();
+    encryptionTime = duration_cast<microseconds>(end - start).count();
+
+    // Salin nonce ke awal ciphertext
+    memcpy(ciphertext, nonce, sizeof(nonce));
+
+    wsnLog(LOG_ENCRYPT_TIME, (uint32_t)encryptionTime);
+    wsnLog(LOG_CIPHERTEXT, totalSize, wsnLogBlob(ciphertext, min(totalSize, HEADER_SIZE + LOG_PREVIEW_BYTES)));
+
+    encryptedLen = totalSize;
+    return ciphertext;
+}
+
+// Transmission Callback
+void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
+    WSN_PROFILE_SCOPE(WSN_PROF_SEND_CALLBACK);
+    if (deliveryStatus == 0) {  // Jika terkirim sukses
+        status = true;
+        chunksAcked++;  // Tambah counter ACK
+    } else {
+        status = false;
+    }
+
+    // Cek jika semua chunk sudah mendapat ACK
+    if (chunksAcked == totalChunks && deliveryStatus == 0) {
+        allChunksSent = true;
+        wsnLog(LOG_ALL_SENT);
+    }
+}
+
+// ESP-NOW Initialization
+bool initESPNow() {
+    if (esp_now_init() != 0) {  // ESP8266 menggunakan 0 sebagai indikator sukses
+        Serial.println("Error initializing ESP-NOW");
+        return false;
+    }
+    esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);  // Set peran sender
+    esp_now_register_send_cb(onSend);
+    return true;
+}
+
+// Pairing with Receiver
+bool pairWithPeer() {
+    if (esp_now_is_peer_exist(receiverMAC)) {
+        return true;  // Peer sudah ada
+    }
+
+    if (esp_now_add_peer(receiverMAC, ESP_NOW_ROLE_SLAVE, 1, NULL, 0) != 0) {
+        Serial.println("Failed to add peer");
+        return false;
+    }
+    Serial.println("Pairing successful");
+    return true;
+}
+
+// Send Encrypted Message in Chunks
+bool sendEncryptedData(uint8_t* ciphertext, size_t len) {
+    totalChunks = (len + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE;
+    wsnLog(LOG_TOTAL_CHUNKS, totalChunks);
+
+    chunksAcked = 0;  // Reset counter ACK
+    allChunksSent = false;
+
+    for (size_t chunkIndex = 0; chunkIndex < totalChunks; ++chunkIndex) {
+        size_t offset;
+        size_t chunkSize;
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_FRAGMENT);
+            offset = chunkIndex * MAX_CHUNK_SIZE;
+            chunkSize = min((size_t)MAX_CHUNK_SIZE, len - offset);
+        }
+
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_ESPNOW_SEND);
+            esp_now_send(receiverMAC, ciphertext + offset, chunkSize);
+        }
+        if (status == false) {
+            wsnLog(LOG_CHUNK_FAILED, chunkIndex);
+            return false;
+        }
+
+        wsnLogDrainFor(Serial, 10);  // Jeda agar tidak overload, sambil mengirim log
+    }
+    return true;
+}
+
+void setup() {
+    Serial.begin(115200);
+    nonces.begin();
+    WiFi.mode(WIFI_STA);
+
+    if (!initESPNow()) {
+        Serial.println("ESP-NOW initialization failed");
+        ESP.restart();
+    }
+
+    if (!pairWithPeer()) {
+        Serial.println("Peer pairing failed");
+        ESP.restart();
+    }
+}
+
+void loop() {
+    size_t encryptedLen = 0;
+    uint64_t encryptionTime = 0;
+
+    // Plaintext hanya ada di heap selama satu siklus
+    char* plaintext = wsnPayloadLoadText(payload);
+    if (plaintext == nullptr) {
+        Serial.println("Memory allocation failed!");
+        wsnLogDrainFor(Serial, 2000);
+        return;
+    }
+    size_t plaintextLen = strlen(plaintext);
+    char preview[LOG_PREVIEW_BYTES + 1];
+    strncpy(preview, plaintext, LOG_PREVIEW_BYTES);
+    preview[LOG_PREVIEW_BYTES] = '\0';
+    wsnLog(LOG_PLAINTEXT, plaintextLen, preview);
+
+    const uint8_t* message = (const uint8_t*)plaintext;
+    size_t messageLen = plaintextLen;
+#if SENSOR_CODEC
+    uint32_t firstIndex = sensorIndex;
+    uint8_t* encoded = wsnSensorEncodeAlloc(plaintext, plaintextLen, messageLen, sensorIndex);
+    if (encoded != nullptr) {
+        message = encoded;
+        wsnLog(LOG_SENSOR_CODEC, plaintextLen, messageLen, sensorIndex - firstIndex);
+    } else {
+        messageLen = plaintextLen;
+    }
+#endif
+#if LZ_COMPRESS
+    WsnLzStats lzStats;
+    size_t compressedLen;
+    uint8_t* compressed = wsnLzCompressAlloc(lzCompressor, message, messageLen, compressedLen, &lzStats);
+    if (compressed != nullptr) {
+        message = compressed;
+        messageLen = compressedLen;
+        wsnLog(LOG_LZ, lzStats.inputBytes, lzStats.outputBytes, lzStats.micros);
+    }
+#endif
+
+    // Encrypt the message
+    uint8_t* ciphertext = encryptMessage(message, messageLen, encryptedLen, encryptionTime);
+#if SENSOR_CODEC
+    free(encoded);
+#endif
+#if LZ_COMPRESS
+    free(compressed);
+#endif
+    free(plaintext);
+
+    if (ciphertext != nullptr) {
+        sendEncryptedData(ciphertext, encryptedLen);
+        free(ciphertext);
+    }
+
+    wsnLog(LOG_CYCLE_END);
+
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') syntheticPayload.resize(Serial.parseInt());  // mis. "n4096"
+#if WSN_PROFILE
+        else if (command == 'p') WSN_PROFILE_DUMP(Serial);
+        else if (command == 'r') WSN_PROFILE_RESET();
+#endif
+    }
+    wsnLogDrainFor(Serial, 2000);
+}
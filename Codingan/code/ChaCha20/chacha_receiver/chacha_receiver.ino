@@ -5,6 +5,34 @@
 #include <cstring>
 #include <stdint.h>
 #include <chrono>
+
+// 1 = catat siklus per scope (callback terima, dekripsi, tulis SD);
+//     kirim 'p' lewat serial untuk dump tabel, 'r' untuk reset
+#define WSN_PROFILE 0
+#include <WsnProfile.h>
+
+// 1 = breakdown latensi end-to-end per pesan (pasangan LATENCY_TRACE di chacha_sender):
+//     satu baris "lat,..." per pesan, kirim 'l' untuk ringkasan p50/p95/p99, 'c' untuk reset
+#define LATENCY_TRACE 0
+#include <WsnLatency.h>
+
+// Pesan biner dari chacha_sender dengan SENSOR_CODEC 1 dikembalikan ke teks asli sebelum disimpan
+#include <WsnSensorCodec.h>
+#include <WsnLz.h>
+
+// ChaCha20 dari library (WsnChaCha20.h). 1 = pesan membawa tag Poly1305 setelah nonce
+// (AEAD_TAG 1 di chacha_sender): tag diverifikasi sebelum dekripsi, pesan palsu/rusak dibuang
+// tanpa didekripsi dan tanpa ditulis ke SD
+#include <WsnXChaCha20.h>
+#define AEAD_TAG 0
+
+// 1 = nonce 24 byte XChaCha20 (XCHACHA_NONCE 1 di chacha_sender). Subkey HChaCha20 disimpan per
+// prefix nonce, jadi hanya dihitung ulang saat sender memulai sesi baru (boot/deep sleep)
+#define XCHACHA_NONCE 0
+const size_t NONCE_SIZE = XCHACHA_NONCE ? WSN_XCHACHA_NONCE_SIZE : 12;
+const size_t HEADER_SIZE = NONCE_SIZE + (AEAD_TAG ? WSN_POLY1305_TAG_SIZE : 0);
+XChaCha20Context xchacha;
+uint32_t rejectedMessages = 0;
 using namespace std::chrono;
 
 #define MAX_INPUT_SIZE 16384
@@ -29,6 +57,19 @@ size_t totalReceived = 0;
 unsigned long lastReceiveTime = 0;
 bool isReceiving = false;
 
+#if LATENCY_TRACE
+const unsigned long SYNC_INTERVAL_MS = 1000;
+
+uint8_t senderMAC[6];
+bool senderKnown = false;
+unsigned long lastSyncTime = 0;
+WsnClockSync clockSync;
+WsnLatencyStats latencyStats;
+WsnReceiveTimes receiveTimes;
+WsnLatencyTrailer latencyTrailer;
+bool trailerReceived = false;
+#endif
+
 // Inisialisasi SD Card
 bool initSDCard() {
     if (!SD.begin(SD_CS_PIN)) {
@@ -41,6 +82,7 @@ bool initSDCard() {
 
 // Simpan hasil dekripsi ke SD Card
 bool saveDecryptedDataToSD(uint8_t* plaintext, size_t dataLen) {
+    WSN_PROFILE_SCOPE(WSN_PROF_SD_WRITE);
     String filename = "/chacha_data_decrypted_" + String(fileIndex) + ".txt";
     File dataFile = SD.open(filename, FILE_WRITE);
 
@@ -63,61 +105,6 @@ bool saveDecryptedDataToSD(uint8_t* plaintext, size_t dataLen) {
     return true;
 }
 
-// Fungsi rotasi bit ke kiri
-#define ROTL(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
-
-// ChaCha20 quarter round
-void quarterRound(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
-    a += b; d ^= a; d = ROTL(d, 16);
-    c += d; b ^= c; b = ROTL(b, 12);
-    a += b; d ^= a; d = ROTL(d, 8);
-    c += d; b ^= c; b = ROTL(b, 7);
-}
-
-// ChaCha20 block generator
-void chacha20Block(uint32_t out[16], const uint32_t in[16]) {
-    memcpy(out, in, sizeof(uint32_t) * 16);
-    for (int i = 0; i < 10; i++) {
-        quarterRound(out[0], out[4], out[ 8], out[12]);
-        quarterRound(out[1], out[5], out[ 9], out[13]);
-        quarterRound(out[2], out[6], out[10], out[14]);
-        quarterRound(out[3], out[7], out[11], out[15]);
-
-        quarterRound(out[0], out[5], out[10], out[15]);
-        quarterRound(out[1], out[6], out[11], out[12]);
-        quarterRound(out[2], out[7], out[ 8], out[13]);
-        quarterRound(out[3], out[4], out[ 9], out[14]);
-    }
-    for (int i = 0; i < 16; i++) {
-        out[i] += in[i];
-    }
-}
-
-// Fungsi dekripsi/enkripsi ChaCha20
-void chacha20EncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len, const uint8_t key[32], const uint8_t nonce[12], uint32_t counter) {
-    uint32_t state[16] = {
-        0x61707865, 0x3320646E, 0x79622D32, 0x6B206574,
-        ((uint32_t *)key)[0], ((uint32_t *)key)[1], ((uint32_t *)key)[2], ((uint32_t *)key)[3],
-        ((uint32_t *)key)[4], ((uint32_t *)key)[5], ((uint32_t *)key)[6], ((uint32_t *)key)[7],
-        counter,
-        ((uint32_t *)nonce)[0], ((uint32_t *)nonce)[1], ((uint32_t *)nonce)[2]
-    };  
-
-    uint8_t block[64];
-    size_t i = 0;
-
-    while (i < len) {
-        uint32_t outputBlock[16];
-        chacha20Block(outputBlock, state);
-        state[12]++;
-
-        for (size_t j = 0; j < 64 && i < len; ++j, ++i) {
-            block[j] = ((uint8_t *)outputBlock)[j];
-            output[i] = input[i] ^ block[j];
-        }
-    }
-}
-
 // Cetak hasil dekripsi
 void printDecryptedMessage(uint8_t* plaintext, uint64_t decryptionTime) {
     Serial.print("Decrypted Data: ");
@@ -130,6 +117,25 @@ void printDecryptedMessage(uint8_t* plaintext, uint64_t decryptionTime) {
 
 // Callback penerimaan data
 void onDataReceived(uint8_t *mac_addr, uint8_t *data, uint8_t len) {
+    WSN_PROFILE_SCOPE(WSN_PROF_RECV_CALLBACK);
+#if LATENCY_TRACE
+    uint32_t now = micros();
+    if (wsnIsSyncFrame(data, len)) {
+        WsnSyncFrame response;
+        memcpy(&response, data, sizeof(response));
+        if (response.type == WSN_SYNC_RESPONSE) clockSync.onResponse(response, now);
+        return;
+    }
+    if (wsnIsLatencyTrailer(data, len)) {
+        memcpy(&latencyTrailer, data, sizeof(latencyTrailer));
+        trailerReceived = true;
+        return;
+    }
+    memcpy(senderMAC, mac_addr, sizeof(senderMAC));
+    senderKnown = true;
+    if (totalReceived == 0) receiveTimes.firstRx_us = now;
+    receiveTimes.lastRx_us = now;
+#endif
     if (totalReceived + len <= MAX_INPUT_SIZE) {
         memcpy(receivedData + totalReceived, data, len);
         totalReceived += len;
@@ -141,14 +147,14 @@ void onDataReceived(uint8_t *mac_addr, uint8_t *data, uint8_t len) {
 // Proses data diterima
 void processReceivedData() {
     if (totalReceived > 0) {
-        if (totalReceived <= 12) {
-            Serial.println("Invalid data! Not enough for nonce and ciphertext.");
+        if (totalReceived <= HEADER_SIZE) {
+            Serial.println("Invalid data! Not enough for header and ciphertext.");
             totalReceived = 0;
             isReceiving = false;
             return;
         }
 
-        uint8_t receivedNonce[12];
+        uint8_t receivedNonce[NONCE_SIZE];
         
         // Serial.print("Nonce: ");
         // for (size_t i = 0; i < sizeof(receivedNonce); ++i) {
@@ -157,8 +163,8 @@ void processReceivedData() {
         // Serial.println();
         
         memcpy(receivedNonce, receivedData, sizeof(receivedNonce));
-        size_t ciphertextLen = totalReceived - sizeof(receivedNonce);
-        uint8_t* ciphertext = receivedData + sizeof(receivedNonce);
+        size_t ciphertextLen = totalReceived - HEADER_SIZE;
+        uint8_t* ciphertext = receivedData + HEADER_SIZE;
 
         Serial.print("Total Received Data Size: ");
         Serial.print(ciphertextLen);
@@ -175,14 +181,78 @@ void processReceivedData() {
       
         auto start = high_resolution_clock::now();
         
-        chacha20EncryptDecrypt(ciphertext, plaintext, ciphertextLen, key, receivedNonce, counter);
+        bool authentic = true;
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_DECRYPT);
+#if XCHACHA_NONCE && AEAD_TAG
+            authentic = xchacha20Poly1305Open(xchacha, receivedNonce, nullptr, 0, ciphertext, plaintext,
+                                              ciphertextLen, receivedData + sizeof(receivedNonce));
+#elif XCHACHA_NONCE
+            xchacha20EncryptDecrypt(xchacha, ciphertext, plaintext, ciphertextLen, receivedNonce, counter);
+#elif AEAD_TAG
+            authentic = chacha20Poly1305Open(key, receivedNonce, nullptr, 0, ciphertext, plaintext, ciphertextLen,
+                                             receivedData + sizeof(receivedNonce));
+#else
+            chacha20EncryptDecrypt(ciphertext, plaintext, ciphertextLen, key, receivedNonce, counter);
+#endif
+        }
+        if (!authentic) {
+            rejectedMessages++;
+            Serial.print("Tag mismatch, message dropped (");
+            Serial.print(rejectedMessages);
+            Serial.println(" total)");
+            free(plaintext);
+            totalReceived = 0;
+            isReceiving = false;
+            return;
+        }
         plaintext[ciphertextLen] = '\0';
+#if LATENCY_TRACE
+        receiveTimes.decryptDone_us = micros();
+#endif
         
         auto end = high_resolution_clock::now();
         decryptionTime = duration_cast<microseconds>(end - start).count();
 
+        size_t plaintextLen = ciphertextLen;
+        // Pesan LZ (LZ_COMPRESS 1 di sender) dibuka dulu, baru sensor codec
+        size_t lzLen;
+        WsnLzStats lzStats;
+        uint8_t* unpacked = wsnLzDecompressAlloc(plaintext, plaintextLen, lzLen, &lzStats);
+        if (unpacked != nullptr) {
+            free(plaintext);
+            plaintext = unpacked;
+            plaintextLen = lzLen;
+            Serial.print("LZ: ");
+            Serial.print(lzStats.inputBytes);
+            Serial.print(" -> ");
+            Serial.print(lzStats.outputBytes);
+            Serial.print(" bytes, ");
+            Serial.print(lzStats.micros);
+            Serial.println(" us");
+        }
+
+        size_t textLen;
+        char* text = wsnSensorDecodeAlloc(plaintext, plaintextLen, textLen);
+        if (text != nullptr) {
+            free(plaintext);
+            plaintext = (uint8_t*)text;
+            plaintextLen = textLen;
+        }
+
         printDecryptedMessage(plaintext, decryptionTime);
-        saveDecryptedDataToSD(plaintext, ciphertextLen);
+        saveDecryptedDataToSD(plaintext, plaintextLen);
+
+#if LATENCY_TRACE
+        receiveTimes.sdDone_us = micros();
+        // Trailer dikirim tepat setelah fragmen terakhir, jadi sudah tiba saat timeout habis
+        if (trailerReceived && clockSync.valid()) {
+            uint32_t stage[WSN_LAT_STAGE_COUNT];
+            latencyStats.record(latencyTrailer, receiveTimes, clockSync, stage);
+            latencyStats.printRecord(Serial, latencyTrailer.sequence, stage, clockSync);
+        }
+        trailerReceived = false;
+#endif
 
         free(plaintext);
         totalReceived = 0;
@@ -192,6 +262,9 @@ void processReceivedData() {
 
 void setup() {
     Serial.begin(115200);
+#if XCHACHA_NONCE
+    xchacha20SetKey(xchacha, key);
+#endif
     WiFi.mode(WIFI_STA);
     WiFi.disconnect();
 
@@ -207,7 +280,11 @@ void setup() {
         Serial.println("SD Card initialization failed.");
     }
     
+#if LATENCY_TRACE
+    esp_now_set_self_role(ESP_NOW_ROLE_COMBO);  // Juga mengirim request sinkronisasi
+#else
     esp_now_set_self_role(ESP_NOW_ROLE_SLAVE);
+#endif
     esp_now_register_recv_cb(onDataReceived);
     Serial.println("Receiver Ready");
 }
@@ -216,5 +293,31 @@ void loop() {
     if (isReceiving && (millis() - lastReceiveTime > TIMEOUT_MS)) {
         processReceivedData();
     }
+
+#if LATENCY_TRACE
+    // Sinkronisasi clock hanya saat tidak sedang menerima pesan
+    if (senderKnown && !isReceiving && millis() - lastSyncTime >= SYNC_INTERVAL_MS) {
+        lastSyncTime = millis();
+        if (!esp_now_is_peer_exist(senderMAC)) {
+            esp_now_add_peer(senderMAC, ESP_NOW_ROLE_COMBO, 1, NULL, 0);
+        }
+        WsnSyncFrame request;
+        wsnSyncBuildRequest(request, micros());
+        esp_now_send(senderMAC, (uint8_t *)&request, sizeof(request));
+    }
+#endif
+
+    while (Serial.available()) {
+        char command = Serial.read();
+#if WSN_PROFILE
+        if (command == 'p') WSN_PROFILE_DUMP(Serial);
+        else if (command == 'r') WSN_PROFILE_RESET();
+#endif
+#if LATENCY_TRACE
+        if (command == 'l') latencyStats.printSummary(Serial);
+        else if (command == 'c') latencyStats.reset();
+#endif
+        (void)command;
+    }
     yield();
 }
@@ -4,6 +4,124 @@
 #include <stdint.h>
 #include <chrono>
 #include "PlaintextData.h"
+
+// 1 = catat siklus per scope (keystream, XOR, fragment, esp_now_send, callback);
+//     kirim 'p' lewat serial untuk dump tabel, 'r' untuk reset
+#define WSN_PROFILE 0
+#include <WsnProfile.h>
+
+// 1 = kirim trailer timestamp setelah fragmen terakhir dan jawab sinkronisasi clock
+//     dari receiver, untuk breakdown latensi end-to-end di chacha_receiver
+#define LATENCY_TRACE 0
+#include <WsnLatency.h>
+
+// Log per siklus dikirim sebagai record biner lewat ring buffer (WsnLog.h), bukan teks/hex
+// per byte. Baca dengan: python "visualisasi data/log_decode.py" COM3 --formats chacha_sender.ino
+#include <WsnLog.h>
+#define WSN_LOG_FORMATS(X)                                                \
+    X(LOG_ENCRYPT_TIME, "Encryption Time: %lu microseconds (us)")         \
+    X(LOG_PLAINTEXT, "Plaintext: %u bytes, awal \"%s\"")                  \
+    X(LOG_CIPHERTEXT, "Encrypted Data (HEX): %u bytes, header+awal %b")    \
+    X(LOG_SENSOR_CODEC, "Sensor codec: %u -> %u bytes (%u rekaman)")       \
+    X(LOG_LZ, "LZ: %u -> %u bytes, %u us, hemat ~%.0f uJ")                \
+    X(LOG_REPORT, "Report %s: T %d H %d, dihindari %u enkripsi, %u frame") \
+    X(LOG_BATCH, "Batch %s: %u pembacaan, %u bytes, %.1f uJ/pembacaan (tanpa batch %.1f)") \
+    X(LOG_TOTAL_CHUNKS, "Total Chunks: %u")                               \
+    X(LOG_ALL_SENT, "All chunks sent successfully")                       \
+    X(LOG_CHUNK_FAILED, "Chunk Send Failed (chunk %u)")                   \
+    X(LOG_CYCLE_END, "------------------------------------------------")
+WSN_LOG_DECLARE(WSN_LOG_FORMATS)
+
+const size_t LOG_PREVIEW_BYTES = 16;  // cuplikan plaintext/ciphertext per pesan
+
+// Sumber plaintext: 0 = dataset tetap di flash (PlaintextData.h, indeks DATASET_INDEX),
+//                   1 = data DHT22 sintetis SYNTHETIC_SIZE byte; ubah saat jalan dengan "n<byte>"
+#include <WsnPayload.h>
+#define PAYLOAD_SOURCE 0
+#define DATASET_INDEX 2
+#define SYNTHETIC_SIZE 5011
+
+// 1 = rekaman "TT.TT,HH.HH" dikirim sebagai biner delta/varint (WsnSensorCodec.h, ~1 byte per
+//     rekaman, bukan 11); chacha_receiver mengembalikannya ke teks sebelum disimpan
+#include <WsnSensorCodec.h>
+#define SENSOR_CODEC 0
+uint32_t sensorIndex = 0;  // indeks rekaman pertama pesan berikutnya
+
+// 1 = pesan dikompres LZ (WsnLz.h) sebelum enkripsi
+#include <WsnLz.h>
+#define LZ_COMPRESS 0
+const float LZ_ENERGY_PER_BYTE_UJ = 0.554f;  // ChaCha20: (0.006578 - 0.003807) J / 5000 byte
+WsnLzCompressor lzCompressor;
+
+// 1 = enkripsi + kirim hanya saat DHT22 berubah, alarm, atau heartbeat (WsnReportPolicy.h)
+#include <WsnReportPolicy.h>
+#define REPORT_POLICY 0
+#define REPORT_HEARTBEAT_MS 60000
+WsnReportPolicy reportPolicy(wsnReportSenderConfig(REPORT_HEARTBEAT_MS));
+
+// 1 = sisa periode SLEEP_PERIOD_MS dipakai tidur, deep sleep jika SLEEP_DEEP 1 (WsnSleep.h)
+#include <WsnSleep.h>
+#define SLEEP_SCHEDULER 0
+#define SLEEP_PERIOD_MS 2000
+#define SLEEP_DEEP 0
+
+// ChaCha20 dari library (WsnChaCha20.h), sama dengan implementasi lama di sketch ini.
+// 1 = ChaCha20-Poly1305 (RFC 8439, WsnChaChaPoly.h): tag 16 byte dihitung dalam pass yang sama
+//     dengan enkripsi dan dikirim di header frame pertama: [nonce][tag 16][ciphertext].
+//     Ciphertext identik dengan mode tanpa tag (counter blok mulai 1); chacha_receiver harus
+//     AEAD_TAG 1 juga
+#include <WsnXChaCha20.h>
+#define AEAD_TAG 0
+
+// 1 = XChaCha20 (WsnXChaCha20.h): nonce 24 byte = prefix acak per boot + counter pesan di RAM
+//     (WsnSessionNonce), tanpa counter nonce di RTC/flash. HChaCha20 dihitung sekali per sesi,
+//     bukan per pesan; chacha_receiver harus XCHACHA_NONCE 1 juga
+#define XCHACHA_NONCE 0
+const size_t NONCE_SIZE = XCHACHA_NONCE ? WSN_XCHACHA_NONCE_SIZE : 12;
+const size_t HEADER_SIZE = NONCE_SIZE + (AEAD_TAG ? WSN_POLY1305_TAG_SIZE : 0);
+
+// 1 = pembacaan DHT22 dikumpulkan dan dikirim per batch (WsnBatch.h)
+#include <WsnBatch.h>
+#define BATCH_MODE 0
+#define BATCH_FRAMES 1
+#define BATCH_MAX_AGE_MS 60000
+
+WsnBatchConfig batchConfig() {
+    WsnBatchConfig config;
+    config.maxFrames = BATCH_FRAMES;
+    config.frameBytes = 250;
+    config.reserveBytes = HEADER_SIZE;  // nonce + tag
+    config.maxAgeMs = BATCH_MAX_AGE_MS;
+    config.binary = SENSOR_CODEC;
+    config.messageEnergyUj = 1031.0f;  // 0.003807 J - 5011 byte x marginal ChaCha20
+    config.byteEnergyUj = LZ_ENERGY_PER_BYTE_UJ;
+    return config;
+}
+
+WsnBatch<WSN_BATCH_CAPACITY(SLEEP_SCHEDULER && SLEEP_DEEP)> batch(batchConfig());
+
+// 1 = pesan dienkripsi per fragmen ESP-NOW (WsnStream.h) tepat sebelum dikirim: plaintext dibaca
+//     dari PAYLOAD_SOURCE langsung ke frame 250 byte di stack, tanpa buffer plaintext/ciphertext
+//     seukuran pesan (heap tidak lagi naik dengan ukuran pesan). Format pesan sama, chacha_receiver
+//     tidak berubah. Tag AEAD ada di frame pertama, sedangkan sensor codec, LZ dan batch butuh
+//     pesan utuh di RAM, jadi keempatnya harus 0
+#include <WsnStream.h>
+#define STREAM_ENCRYPT 0
+#if STREAM_ENCRYPT && (AEAD_TAG || SENSOR_CODEC || LZ_COMPRESS || BATCH_MODE)
+#error "STREAM_ENCRYPT butuh AEAD_TAG, SENSOR_CODEC, LZ_COMPRESS dan BATCH_MODE 0"
+#endif
+
+bool initESPNow();
+WsnSleepScheduler sleepScheduler(wsnSleepSenderConfig(SLEEP_PERIOD_MS, SLEEP_DEEP, initESPNow));
+
+// Waktu untuk timestamp laporan/batch; dengan scheduler tetap naik melewati deep sleep
+uint32_t nodeMillis() {
+#if SLEEP_SCHEDULER
+    return sleepScheduler.nowMs();
+#else
+    return wsnMillis();
+#endif
+}
 using namespace std::chrono;
 
 uint8_t receiverMAC[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7};
@@ -20,8 +138,23 @@ uint8_t key[32] = {
     0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
 };
 
-//nonce
-uint8_t nonce[12];
+// Nonce = ID node + counter pesan (WsnNonce.h): counter di RTC memory tiap pesan dan di flash
+// per 1024 pesan, jadi tidak terulang setelah reboot/deep sleep. Format pesan tetap
+// (nonce 12 byte di depan ciphertext), chacha_receiver tidak berubah.
+// XCHACHA_NONCE 1: WsnSessionNonce menggantikan WsnNonceManager
+#include <WsnNonce.h>
+uint8_t nonce[NONCE_SIZE];
+WsnNonceManager nonces;
+WsnSessionNonce sessionNonce;
+XChaCha20Context xchacha;
+
+WsnFlashPayload datasetPayload(plaintextSets[DATASET_INDEX], plaintextSetSizes[DATASET_INDEX]);
+WsnDht22Payload syntheticPayload(SYNTHETIC_SIZE);
+#if PAYLOAD_SOURCE
+WsnPayloadSource &payload = syntheticPayload;
+#else
+WsnPayloadSource &payload = datasetPayload;
+#endif
 
 // Transmission State Variables
 size_t totalChunks = 0;
@@ -30,64 +163,12 @@ bool allChunksSent = false;
 bool status = false;
 uint32_t counter = 1;
 
-// Rotasi/menggeser bit ke kiri dan ke kanan
-#define ROTL(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
-
-// Fungsi ChaCha quarter round (penjumlahan dan xor)
-void quarterRound(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
-    a += b; d ^= a; d = ROTL(d, 16);
-    c += d; b ^= c; b = ROTL(b, 12);
-    a += b; d ^= a; d = ROTL(d, 8);
-    c += d; b ^= c; b = ROTL(b, 7);
-}
-
-// Fungsi untuk menghasilkan keystream 64-byte
-void chacha20Block(uint32_t out[16], const uint32_t in[16]) {
-    memcpy(out, in, sizeof(uint32_t) * 16); //copy state awal ke output
-    for (int i = 0; i < 10; i++) {
-        //column round      
-        quarterRound(out[0], out[4], out[ 8], out[12]);
-        quarterRound(out[1], out[5], out[ 9], out[13]);
-        quarterRound(out[2], out[6], out[10], out[14]);
-        quarterRound(out[3], out[7], out[11], out[15]);
-        //diagonal round        
-        quarterRound(out[0], out[5], out[10], out[15]);
-        quarterRound(out[1], out[6], out[11], out[12]);
-        quarterRound(out[2], out[7], out[ 8], out[13]);
-        quarterRound(out[3], out[4], out[ 9], out[14]);
-    }
-    for (int i = 0; i < 16; i++) {
-        out[i] += in[i];
-    }
-}
-
-// Fungsi enkripsi XOR, bisa digunakan untuk enkripsi dan dekripsi
-void chacha20EncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len, const uint8_t key[32], const uint8_t nonce[12], uint32_t counter) {
-    uint32_t state[16] = {
-        0x61707865, 0x3320646E, 0x79622D32, 0x6B206574, // Constant
-        ((uint32_t *)key)[0], ((uint32_t *)key)[1], ((uint32_t *)key)[2], ((uint32_t *)key)[3], 
-        ((uint32_t *)key)[4], ((uint32_t *)key)[5], ((uint32_t *)key)[6], ((uint32_t *)key)[7], 
-        counter, ((uint32_t *)nonce)[0], ((uint32_t *)nonce)[1], ((uint32_t *)nonce)[2]
-    };
-
-    uint8_t block[64]; 
-    size_t i = 0;
-
-    while (i < len) { 
-        uint32_t outputBlock[16]; //buffer keystream
-        chacha20Block(outputBlock, state); //generate keystream
-        state[12]++;  // Increment counter
-
-        for (size_t j = 0; j < 64 && i < len; ++j, ++i) {
-            block[j] = ((uint8_t *)outputBlock)[j];
-            output[i] = input[i] ^ block[j];  // XOR dengan keystream
-        }
-    }
-}
+#if LATENCY_TRACE
+WsnLatencyTrailer latency = {WSN_LATENCY_MAGIC};
+#endif
 
 // Encryption Function
-uint8_t* encryptMessage(const char* plaintext, size_t& encryptedLen, uint64_t& encryptionTime) {
-    size_t len = strlen(plaintext);
+uint8_t* encryptMessage(const uint8_t* plaintext, size_t len, size_t& encryptedLen, uint64_t& encryptionTime) {
 
     // Validasi ukuran input
     if (len > MAX_INPUT_SIZE) {
@@ -95,54 +176,62 @@ uint8_t* encryptMessage(const char* plaintext, size_t& encryptedLen, uint64_t& e
         return nullptr;
     }
 
-    // Alokasikan memori untuk ciphertext (plaintext + nonce)
-    size_t totalSize = len + sizeof(nonce);
+    // Alokasikan memori untuk ciphertext (plaintext + nonce + tag)
+    size_t totalSize = len + HEADER_SIZE;
     uint8_t* ciphertext = (uint8_t*)malloc(totalSize);
     if (ciphertext == nullptr) {
         Serial.println("Memory allocation failed!");
         return nullptr;
     }
 
-    // Generate nonce dinamis
-    for (size_t i = 0; i < sizeof(nonce); i++) {
-        nonce[i] = random(0, 256);
+#if XCHACHA_NONCE
+    sessionNonce.next(nonce);
+#else
+    if (!nonces.next(nonce, sizeof(nonce))) {
+        Serial.println("Nonce checkpoint failed!");
+        free(ciphertext);
+        return nullptr;
     }
+#endif
 
     auto start = high_resolution_clock::now();
     
     // Encrypt plaintext
-    chacha20EncryptDecrypt((const uint8_t*)plaintext, ciphertext + sizeof(nonce), len, key, nonce, counter);
+    {
+        WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+#if XCHACHA_NONCE && AEAD_TAG
+        xchacha20Poly1305Seal(xchacha, nonce, nullptr, 0, plaintext, ciphertext + HEADER_SIZE, len,
+                              ciphertext + sizeof(nonce));
+#elif XCHACHA_NONCE
+        xchacha20EncryptDecrypt(xchacha, plaintext, ciphertext + HEADER_SIZE, len, nonce, counter);
+#elif AEAD_TAG
+        chacha20Poly1305Seal(key, nonce, nullptr, 0, plaintext, ciphertext + HEADER_SIZE, len,
+                             ciphertext + sizeof(nonce));
+#else
+        chacha20EncryptDecrypt(plaintext, ciphertext + HEADER_SIZE, len, key, nonce, counter);
+#endif
+    }
 
     auto end = high_resolution_clock::now();
+#if LATENCY_TRACE
+    latency.encryptDone_us = micros();
+#endif
     encryptionTime = duration_cast<microseconds>(end - start).count(); 
 
     // Salin nonce ke awal ciphertext
     memcpy(ciphertext, nonce, sizeof(nonce));
 
-    Serial.print("Encryption Time: ");
-    Serial.print(encryptionTime);
-    Serial.println(" microseconds (μs)");
-    Serial.print("Plaintext: ");
-    Serial.println(plaintext);
-    Serial.print("Encrypted Data (HEX): ");
-    for (size_t i = 0; i < totalSize; ++i) {
-        Serial.print(ciphertext[i], HEX);
-    }
-
-    // Serial.print("Nonce: ");
-    // for (size_t i = 0; i < sizeof(nonce); ++i) {
-    //     Serial.print(nonce[i], HEX);
-    // }
-    
-    Serial.println();
+    // Beberapa mikrodetik; dulu dump teks+hex penuh memakan detik di 115200 baud
+    wsnLog(LOG_ENCRYPT_TIME, (uint32_t)encryptionTime);
+    wsnLog(LOG_CIPHERTEXT, totalSize, wsnLogBlob(ciphertext, min(totalSize, HEADER_SIZE + LOG_PREVIEW_BYTES)));
 
     encryptedLen = totalSize;
     return ciphertext;
-    delay(2000);
 }
 
 // Transmission Callback
 void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
+    WSN_PROFILE_SCOPE(WSN_PROF_SEND_CALLBACK);
     if (deliveryStatus == 0) {  // Jika terkirim sukses
         status = true;
         chunksAcked++;  // Tambah counter ACK
@@ -153,92 +242,312 @@ void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
     // Cek jika semua chunk sudah mendapat ACK
     if (chunksAcked == totalChunks && deliveryStatus == 0) {
         allChunksSent = true;
-        Serial.println("All chunks sent successfully");
+        wsnLog(LOG_ALL_SENT);
     }  
 }
 
+#if LATENCY_TRACE
+// Jawab permintaan sinkronisasi clock dari receiver secepatnya (t2/t3 dicatat di sini)
+void onReceive(uint8_t *mac_addr, uint8_t *data, uint8_t len) {
+    uint32_t t2 = micros();
+    if (!wsnIsSyncFrame(data, len)) return;
+
+    WsnSyncFrame request, response;
+    memcpy(&request, data, sizeof(request));
+    if (request.type != WSN_SYNC_REQUEST) return;
+    wsnSyncBuildResponse(response, request, t2, micros());
+    esp_now_send(mac_addr, (uint8_t *)&response, sizeof(response));
+}
+#endif
+
 // ESP-NOW Initialization
 bool initESPNow() {
     if (esp_now_init() != 0) {  // ESP8266 menggunakan 0 sebagai indikator sukses
         Serial.println("Error initializing ESP-NOW");
         return false;
     }
+#if LATENCY_TRACE
+    esp_now_set_self_role(ESP_NOW_ROLE_COMBO);  // Juga menerima request sinkronisasi
+    esp_now_register_recv_cb(onReceive);
+#else
     esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);  // Set peran sender
+#endif
     esp_now_register_send_cb(onSend);
     return true;
 }
 
-// Pairing with Receiver
-bool pairWithPeer() {
-    if (esp_now_is_peer_exist(receiverMAC)) {
-        return true;  // Peer sudah ada
-    }
+// Mulai satu pesan: reset counter ACK untuk len byte (header + ciphertext)
+void beginChunks(size_t len) {
+    totalChunks = (len + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE;
+    wsnLog(LOG_TOTAL_CHUNKS, totalChunks);
 
-    if (esp_now_add_peer(receiverMAC, ESP_NOW_ROLE_SLAVE, 1, NULL, 0) != 0) {
-        Serial.println("Failed to add peer");
+    chunksAcked = 0;  // Reset counter ACK
+    allChunksSent = false;
+}
+
+// Kirim satu fragmen; false jika fragmen sebelumnya gagal
+bool sendChunk(size_t chunkIndex, uint8_t* data, size_t chunkSize) {
+#if LATENCY_TRACE
+    latency.lastSent_us = micros();
+    if (chunkIndex == 0) latency.firstSent_us = latency.lastSent_us;
+#endif
+
+    uint8_t sendStatus;
+    {
+        WSN_PROFILE_SCOPE(WSN_PROF_ESPNOW_SEND);
+        sendStatus = esp_now_send(receiverMAC, data, chunkSize);
+    }
+    if (status == false) {
+        wsnLog(LOG_CHUNK_FAILED, chunkIndex);
         return false;
     }
-    Serial.println("Pairing successful");
+
+    wsnLogDrainFor(Serial, 10);  // Jeda agar tidak overload, sambil mengirim log
     return true;
 }
 
+void endChunks() {
+#if LATENCY_TRACE
+    esp_now_send(receiverMAC, (uint8_t *)&latency, sizeof(latency));
+    latency.sequence++;
+#endif
+}
+
 // Send Encrypted Message in Chunks
 bool sendEncryptedData(uint8_t* ciphertext, size_t len) {
-    totalChunks = (len + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE;
-    Serial.print("Total Chunks: ");
-    Serial.println(totalChunks);
-
-    chunksAcked = 0;  // Reset counter ACK
-    allChunksSent = false;
+    beginChunks(len);
 
     for (size_t chunkIndex = 0; chunkIndex < totalChunks; ++chunkIndex) {
-        size_t offset = chunkIndex * MAX_CHUNK_SIZE;
-        size_t chunkSize = min((size_t)MAX_CHUNK_SIZE, len - offset);
+        size_t offset;
+        size_t chunkSize;
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_FRAGMENT);
+            offset = chunkIndex * MAX_CHUNK_SIZE;
+            chunkSize = min((size_t)MAX_CHUNK_SIZE, len - offset);
+        }
 
-        uint8_t sendStatus = esp_now_send(receiverMAC, ciphertext + offset, chunkSize);
-        if (status == false) {
-            Serial.println("Chunk Send Failed");
+        if (!sendChunk(chunkIndex, ciphertext + offset, chunkSize)) {
             return false;
         }
-
-        delay(10);  // Jeda agar tidak overload
     }
 
+    endChunks();
     return true;
 }
 
-void setup() {
-    Serial.begin(115200);
-    WiFi.mode(WIFI_STA);
+#if STREAM_ENCRYPT
+// Enkripsi per fragmen: plaintext dibaca dari source langsung ke frame, dienkripsi di tempat
+// dengan WsnChaCha20Stream lalu dikirim. Frame pertama [nonce][ciphertext awal], berikutnya
+// ciphertext saja; byte yang dikirim sama dengan encryptMessage + sendEncryptedData
+bool sendStreamedPayload(WsnPayloadSource &source, uint64_t& encryptionTime) {
+    size_t len = source.size();
+    if (len > MAX_INPUT_SIZE) {
+        Serial.println("Input size exceeds maximum buffer size!");
+        return false;
+    }
 
-    if (!initESPNow()) {
-        Serial.println("ESP-NOW initialization failed");
-        ESP.restart();
+    WsnChaCha20Stream stream;
+#if XCHACHA_NONCE
+    sessionNonce.next(nonce);
+    uint8_t innerNonce[12];
+    xchacha20InnerNonce(innerNonce, nonce);
+    stream.init(xchacha20Subkey(xchacha, nonce), innerNonce, counter);
+#else
+    if (!nonces.next(nonce, sizeof(nonce))) {
+        Serial.println("Nonce checkpoint failed!");
+        return false;
     }
+    stream.init(key, nonce, counter);
+#endif
+
+    beginChunks(len + HEADER_SIZE);
+    source.rewind();
+
+    uint8_t frame[MAX_CHUNK_SIZE];
+    memcpy(frame, nonce, sizeof(nonce));
+    size_t headerBytes = HEADER_SIZE;
+    size_t remaining = len;
+    encryptionTime = 0;
+
+    for (size_t chunkIndex = 0; chunkIndex < totalChunks; ++chunkIndex) {
+        size_t dataBytes = wsnPayloadReadAll(source, frame + headerBytes,
+                                             min(MAX_CHUNK_SIZE - headerBytes, remaining));
+
+        auto start = high_resolution_clock::now();
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+            stream.update(frame + headerBytes, frame + headerBytes, dataBytes);
+        }
+        auto end = high_resolution_clock::now();
+        encryptionTime += duration_cast<microseconds>(end - start).count();
+
+        if (chunkIndex == 0) {
+#if LATENCY_TRACE
+            latency.encryptDone_us = micros();  // fragmen pertama siap; sisanya tumpang tindih dengan radio
+#endif
+            wsnLog(LOG_CIPHERTEXT, len + HEADER_SIZE,
+                   wsnLogBlob(frame, min(headerBytes + dataBytes, HEADER_SIZE + LOG_PREVIEW_BYTES)));
+        }
 
-    if (!pairWithPeer()) {
-        Serial.println("Peer pairing failed");
-        ESP.restart();
+        if (!sendChunk(chunkIndex, frame, headerBytes + dataBytes)) {
+            return false;
+        }
+        remaining -= dataBytes;
+        headerBytes = 0;
     }
+
+    wsnLog(LOG_ENCRYPT_TIME, (uint32_t)encryptionTime);
+    endChunks();
+    return true;
+}
+#endif
+
+// Akhir siklus: kirim sisa log lalu tidur sampai periode berikutnya, atau tunggu 2 detik
+void waitNextCycle() {
+#if SLEEP_SCHEDULER
+    wsnLogFlush(Serial);
+    Serial.flush();
+    sleepScheduler.sleep();
+#else
+    wsnLogDrainFor(Serial, 2000);
+#endif
+}
+
+void setup() {
+    Serial.begin(115200);
+#if !XCHACHA_NONCE
+    nonces.begin();
+#endif
+#if SLEEP_SCHEDULER
+    // Batch dan kebijakan laporan dipulihkan dari RTC memory saat bangun dari deep sleep
+    sleepScheduler.keep(wsnSleepPart(batch, WSN_RTC_BATCH_OFFSET));
+    sleepScheduler.keep(wsnSleepPart(reportPolicy, WSN_RTC_POLICY_OFFSET));
+    sleepScheduler.begin();
+#endif
+    sleepScheduler.startRadio(receiverMAC, 1);
+#if XCHACHA_NONCE
+    // Sesi baru per boot/bangun dari deep sleep; RNG hardware butuh radio menyala
+    sessionNonce.begin();
+    xchacha20SetKey(xchacha, key);
+#endif
 }
 
 void loop() {
     size_t encryptedLen = 0;
     uint64_t encryptionTime = 0;
+#if REPORT_POLICY || BATCH_MODE
+    WsnReportCycle report = wsnReportCycle(REPORT_POLICY ? &reportPolicy : nullptr, nodeMillis(), LOG_REPORT);
+    if (!report.send) {
+        waitNextCycle();
+        return;
+    }
+#endif
+#if BATCH_MODE
+    WsnBatchFlush flush = batch.add(report.temperature, report.humidity, nodeMillis());
+    if (flush == WSN_BATCH_KEEP) {
+        waitNextCycle();
+        return;
+    }
+#endif
+#if LATENCY_TRACE
+    latency.sample_us = micros();  // plaintext "diambil"
+#endif
+
+#if STREAM_ENCRYPT
+    char preview[LOG_PREVIEW_BYTES + 1];
+    payload.rewind();
+    preview[wsnPayloadReadAll(payload, (uint8_t*)preview, LOG_PREVIEW_BYTES)] = '\0';
+    wsnLog(LOG_PLAINTEXT, payload.size(), preview);
+
+    sendStreamedPayload(payload, encryptionTime);
+#if REPORT_POLICY
+    reportPolicy.setFramesPerReport(totalChunks);
+#endif
+#else
+    // Plaintext hanya ada di heap selama satu siklus
+#if BATCH_MODE
+    size_t batchLen;
+    char* plaintext = batch.takeTextAlloc(flush, batchLen);
+#else
+    char* plaintext = wsnPayloadLoadText(payload);
+#endif
+    if (plaintext == nullptr) {
+        Serial.println("Memory allocation failed!");
+        waitNextCycle();
+        return;
+    }
+    size_t plaintextLen = strlen(plaintext);
+    char preview[LOG_PREVIEW_BYTES + 1];
+    strncpy(preview, plaintext, LOG_PREVIEW_BYTES);
+    preview[LOG_PREVIEW_BYTES] = '\0';
+    wsnLog(LOG_PLAINTEXT, plaintextLen, preview);
+
+    const uint8_t* message = (const uint8_t*)plaintext;
+    size_t messageLen = plaintextLen;
+#if SENSOR_CODEC
+    // Teks tanpa rekaman sensor (plaintextTesting) tetap dikirim apa adanya
+    uint32_t firstIndex = sensorIndex;
+    uint8_t* encoded = wsnSensorEncodeAlloc(plaintext, plaintextLen, messageLen, sensorIndex);
+    if (encoded != nullptr) {
+        message = encoded;
+        wsnLog(LOG_SENSOR_CODEC, plaintextLen, messageLen, sensorIndex - firstIndex);
+    } else {
+        messageLen = plaintextLen;
+    }
+#endif
+#if LZ_COMPRESS
+    WsnLzStats lzStats;
+    size_t compressedLen;
+    uint8_t* compressed = wsnLzCompressAlloc(lzCompressor, message, messageLen, compressedLen, &lzStats);
+    if (compressed != nullptr) {
+        message = compressed;
+        messageLen = compressedLen;
+        wsnLog(LOG_LZ, lzStats.inputBytes, lzStats.outputBytes, lzStats.micros,
+               wsnLzEnergySavedUj(lzStats, LZ_ENERGY_PER_BYTE_UJ));
+    }
+#endif
     
     // Encrypt the message
-    uint8_t* ciphertext = encryptMessage(plaintextSets[2], encryptedLen, encryptionTime);
+    uint8_t* ciphertext = encryptMessage(message, messageLen, encryptedLen, encryptionTime);
+#if SENSOR_CODEC
+    free(encoded);
+#endif
+#if LZ_COMPRESS
+    free(compressed);
+#endif
+    free(plaintext);
     
     if (ciphertext != nullptr) {
         // Send encrypted data
         if (sendEncryptedData(ciphertext, encryptedLen)) {
             // Serial.println("Message sent successfully");
         }
+#if REPORT_POLICY
+        reportPolicy.setFramesPerReport(totalChunks);
+#endif
+#if BATCH_MODE
+        const WsnBatchStats &batchStats = batch.stats();
+        wsnLog(LOG_BATCH, flush == WSN_BATCH_AGE ? "age" : "size", batchStats.lastCount, batchStats.lastBytes,
+               batchStats.lastEnergyPerReadingUj, batchStats.unbatchedEnergyPerReadingUj);
+#endif
         
         // Free dynamically allocated memory
         free(ciphertext);
     }
+#endif
     
-    Serial.println("------------------------------------------------");
-    delay(2000);     
+    wsnLog(LOG_CYCLE_END);
+
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') syntheticPayload.resize(Serial.parseInt());  // mis. "n4096"
+#if SLEEP_SCHEDULER
+        else if (command == 's') sleepScheduler.printResidency(Serial);
+#endif
+#if WSN_PROFILE
+        else if (command == 'p') WSN_PROFILE_DUMP(Serial);
+        else if (command == 'r') WSN_PROFILE_RESET();
+#endif
+    }
+    waitNextCycle();
 }
\ No newline at end of file
@@ -5,6 +5,76 @@
 #include <stdint.h>
 #include <chrono>
 #include "InputData.h"
+
+// Sumber plaintext: 0 = dataset tetap di flash (InputData.h, indeks DATASET_INDEX),
+//                   1 = data DHT22 sintetis SYNTHETIC_SIZE byte; ubah saat jalan dengan "n<byte>"
+#include <WsnPayload.h>
+#define PAYLOAD_SOURCE 0
+#define DATASET_INDEX 2
+#define SYNTHETIC_SIZE 10011
+
+// 1 = rekaman "TT.TT,HH.HH" dikirim sebagai biner delta/varint (WsnSensorCodec.h, ~1 byte per
+//     rekaman, bukan 11); clefia_receiver mengembalikannya ke teks sebelum disimpan
+#include <WsnSensorCodec.h>
+#define SENSOR_CODEC 0
+uint32_t sensorIndex = 0;  // indeks rekaman pertama pesan berikutnya
+
+// 1 = pesan dikompres LZ (WsnLz.h) sebelum enkripsi
+#include <WsnLz.h>
+#define LZ_COMPRESS 0
+const float LZ_ENERGY_PER_BYTE_UJ = 4.436f;  // Clefia: (0.046383 - 0.024201) J / 5000 byte
+WsnLzCompressor lzCompressor;
+
+// 1 = mode CBC dengan IV per pesan = CLEFIA(kunci, ID node + counter pesan) (WsnNonce.h), IV
+//     dikirim sebagai blok pertama; clefia_receiver harus MESSAGE_IV 1 juga. 0 = blok independen
+//     (format lama)
+#include <WsnNonce.h>
+#define MESSAGE_IV 1
+WsnNonceManager nonces;
+
+// 1 = enkripsi + kirim hanya saat DHT22 berubah, alarm, atau heartbeat (WsnReportPolicy.h)
+#include <WsnReportPolicy.h>
+#define REPORT_POLICY 0
+#define REPORT_HEARTBEAT_MS 60000
+WsnReportPolicy reportPolicy(wsnReportSenderConfig(REPORT_HEARTBEAT_MS));
+
+// 1 = sisa periode SLEEP_PERIOD_MS dipakai tidur, deep sleep jika SLEEP_DEEP 1 (WsnSleep.h)
+#include <WsnSleep.h>
+#define SLEEP_SCHEDULER 0
+#define SLEEP_PERIOD_MS 2000
+#define SLEEP_DEEP 0
+
+// 1 = pembacaan DHT22 dikumpulkan dan dikirim per batch (WsnBatch.h)
+#include <WsnBatch.h>
+#define BATCH_MODE 0
+#define BATCH_FRAMES 1
+#define BATCH_MAX_AGE_MS 60000
+
+WsnBatchConfig batchConfig() {
+    WsnBatchConfig config;
+    config.maxFrames = BATCH_FRAMES;
+    config.frameBytes = 244;
+    config.reserveBytes = MESSAGE_IV ? 32 : 16;  // padding blok (+ IV); frame 250 - header 6 byte
+    config.maxAgeMs = BATCH_MAX_AGE_MS;
+    config.binary = SENSOR_CODEC;
+    config.messageEnergyUj = 1972.0f;  // 0.024201 J - 5011 byte x marginal Clefia
+    config.byteEnergyUj = LZ_ENERGY_PER_BYTE_UJ;
+    return config;
+}
+
+WsnBatch<WSN_BATCH_CAPACITY(SLEEP_SCHEDULER && SLEEP_DEEP)> batch(batchConfig());
+
+bool initESPNow();
+WsnSleepScheduler sleepScheduler(wsnSleepSenderConfig(SLEEP_PERIOD_MS, SLEEP_DEEP, initESPNow));
+
+// Waktu untuk timestamp laporan/batch; dengan scheduler tetap naik melewati deep sleep
+uint32_t nodeMillis() {
+#if SLEEP_SCHEDULER
+    return sleepScheduler.nowMs();
+#else
+    return wsnMillis();
+#endif
+}
 using namespace std::chrono;
 
 // Configuration
@@ -20,6 +90,14 @@ void clefiaEncrypt(uint32_t *ciphertext, const uint32_t *plaintext, const uint32
 void clefiaKeySchedule(uint32_t *rk, const uint8_t *key);
 void clefiaF(uint32_t *dst, const uint32_t *src, int offset);
 
+WsnFlashPayload datasetPayload(plaintextSets[DATASET_INDEX], plaintextSetSizes[DATASET_INDEX]);
+WsnDht22Payload syntheticPayload(SYNTHETIC_SIZE);
+#if PAYLOAD_SOURCE
+WsnPayloadSource &payload = syntheticPayload;
+#else
+WsnPayloadSource &payload = datasetPayload;
+#endif
+
 // Transmission control
 struct PacketHeader {
   uint16_t sequenceNumber;
@@ -169,7 +247,7 @@ bool allocateBuffers(size_t size) {
     size_t alignedSize = ((size + CLEFIA_BLOCK_SIZE - 1) / CLEFIA_BLOCK_SIZE) * CLEFIA_BLOCK_SIZE;
     
     dataBuffer = (uint8_t*)malloc(alignedSize);
-    encryptionBuffer = (uint8_t*)malloc(alignedSize);
+    encryptionBuffer = (uint8_t*)malloc(alignedSize + (MESSAGE_IV ? CLEFIA_BLOCK_SIZE : 0));
     roundKeys = (uint32_t*)malloc((CLEFIA_ROUNDS + 4) * sizeof(uint32_t));
     
     if (!dataBuffer || !encryptionBuffer || !roundKeys) {
@@ -229,6 +307,14 @@ bool processAndSendData(const uint8_t* data, size_t length) {
   if (length > MAX_DATA_SIZE || transmissionInProgress) {
     return false;
   }
+
+#if MESSAGE_IV
+  uint8_t nonceBlock[CLEFIA_BLOCK_SIZE];
+  if (!nonces.next(nonceBlock, sizeof(nonceBlock))) {
+    Serial.println(F("Nonce checkpoint failed"));
+    return false;
+  }
+#endif
   
   if (!allocateBuffers(length)) {
     Serial.println(F("Failed to allocate memory"));
@@ -253,11 +339,25 @@ bool processAndSendData(const uint8_t* data, size_t length) {
 
   auto encryptionStart = std::chrono::high_resolution_clock::now();
   clefiaKeySchedule(roundKeys, key);  
+#if MESSAGE_IV
+  // CBC: IV counter dienkripsi dulu agar tidak bisa ditebak, lalu dikirim sebagai blok pertama
+  encryptBlock(encryptionBuffer, nonceBlock, roundKeys);
+  for (size_t i = 0; i < paddedSize; i += CLEFIA_BLOCK_SIZE) {
+    const uint8_t* chain = encryptionBuffer + i;  // blok ciphertext sebelumnya / IV
+    for (int j = 0; j < CLEFIA_BLOCK_SIZE; j++) {
+      dataBuffer[i + j] ^= chain[j];
+    }
+    encryptBlock(encryptionBuffer + CLEFIA_BLOCK_SIZE + i, dataBuffer + i, roundKeys);
+    yield();
+  }
+  paddedSize += CLEFIA_BLOCK_SIZE;
+#else
   // Encrypt data in blocks
   for (size_t i = 0; i < paddedSize; i += CLEFIA_BLOCK_SIZE) {
     encryptBlock(encryptionBuffer + i, dataBuffer + i, roundKeys);
     yield();
   }
+#endif
 
   auto encryptionEnd = std::chrono::high_resolution_clock::now();
   auto encryptionDuration = std::chrono::duration_cast<std::chrono::microseconds>(encryptionEnd - encryptionStart).count();
@@ -266,7 +366,9 @@ bool processAndSendData(const uint8_t* data, size_t length) {
   Serial.print(F("Encryption time (microseconds): "));
   Serial.println(encryptionDuration);
 
-  delay(2000);
+#if !SLEEP_SCHEDULER
+  delay(2000);  // dengan scheduler node tidur setelah kirim, bukan menunggu di sini
+#endif
   Serial.print(F("Encrypted Data: "));
   for (size_t i = 0; i < paddedSize; i++) {
     Serial.printf("%02X", encryptionBuffer[i]); 
@@ -332,39 +434,138 @@ void ICACHE_RAM_ATTR OnDataSent(uint8_t *mac_addr, uint8_t sendStatus) {
     }
 }
 
-void setup() {
-    Serial.begin(115200);
-    while (!Serial) { yield(); }
-    
-    WiFi.mode(WIFI_STA);
-    WiFi.disconnect();
-    
+bool initESPNow() {
     if (esp_now_init() != 0) {
         Serial.println(F("ESP-NOW init failed"));
-        return;
+        return false;
     }
     
     esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);
     esp_now_register_send_cb(OnDataSent);
-    esp_now_add_peer(receiverMAC, ESP_NOW_ROLE_SLAVE, 1, NULL, 0);
+    return true;
+}
+
+// Akhir siklus: tidur sampai periode berikutnya, atau tunggu 2 detik
+void waitNextCycle() {
+#if SLEEP_SCHEDULER
+    Serial.flush();
+    sleepScheduler.sleep();
+#else
+    delay(2000);
+#endif
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) { yield(); }
+#if MESSAGE_IV
+    nonces.begin();
+#endif
+    
+#if SLEEP_SCHEDULER
+    // Batch dan kebijakan laporan dipulihkan dari RTC memory saat bangun dari deep sleep
+    sleepScheduler.keep(wsnSleepPart(batch, WSN_RTC_BATCH_OFFSET));
+    sleepScheduler.keep(wsnSleepPart(reportPolicy, WSN_RTC_POLICY_OFFSET));
+    sleepScheduler.begin();
+#endif
+    sleepScheduler.startRadio(receiverMAC, 1);
     
     Serial.println(F("Setup complete"));
 }
 
 void loop() {
-   
-    size_t plainTextSize = strlen(plaintextSets[2]);
+#if REPORT_POLICY || BATCH_MODE
+    WsnReportCycle report = wsnReportCycle(REPORT_POLICY ? &reportPolicy : nullptr, nodeMillis(), Serial);
+    if (!report.send) {
+        waitNextCycle();
+        return;
+    }
+#endif
+#if BATCH_MODE
+    WsnBatchFlush flush = batch.add(report.temperature, report.humidity, nodeMillis());
+    if (flush == WSN_BATCH_KEEP) {
+        waitNextCycle();
+        return;
+    }
+#endif
+
+    // Plaintext hanya ada di heap selama satu siklus
+#if BATCH_MODE
+    size_t batchLen;
+    char *plaintext = batch.takeTextAlloc(flush, batchLen);
+#else
+    char *plaintext = wsnPayloadLoadText(payload);
+#endif
+    if (plaintext == nullptr) {
+        Serial.println(F("Memory allocation failed"));
+        waitNextCycle();
+        return;
+    }
+    size_t plainTextSize = strlen(plaintext);
     
     // Print plain text and its size
     Serial.print("Size of Data: ");
     Serial.print(plainTextSize);
     Serial.println(" bytes");    
     Serial.print("Plaintext: ");
-    Serial.println(plaintextSets[2]);    
+    Serial.println(plaintext);
+    
+    const uint8_t *message = (const uint8_t *)plaintext;
+    size_t messageLen = plainTextSize;
+#if SENSOR_CODEC
+    // Teks tanpa rekaman sensor (plaintextTesting) tetap dikirim apa adanya
+    uint8_t *encoded = wsnSensorEncodeAlloc(plaintext, plainTextSize, messageLen, sensorIndex);
+    if (encoded != nullptr) {
+        message = encoded;
+        Serial.print("Sensor codec: ");
+        Serial.print(plainTextSize);
+        Serial.print(" -> ");
+        Serial.print(messageLen);
+        Serial.println(" bytes");
+    } else {
+        messageLen = plainTextSize;
+    }
+#endif
+#if LZ_COMPRESS
+    WsnLzStats lzStats;
+    size_t compressedLen;
+    uint8_t *compressed = wsnLzCompressAlloc(lzCompressor, message, messageLen, compressedLen, &lzStats);
+    if (compressed != nullptr) {
+        message = compressed;
+        messageLen = compressedLen;
+        Serial.print("LZ: ");
+        Serial.print(lzStats.inputBytes);
+        Serial.print(" -> ");
+        Serial.print(lzStats.outputBytes);
+        Serial.print(" bytes, ");
+        Serial.print(lzStats.micros);
+        Serial.print(" us, hemat ~");
+        Serial.print(wsnLzEnergySavedUj(lzStats, LZ_ENERGY_PER_BYTE_UJ), 0);
+        Serial.println(" uJ");
+    }
+#endif
     
     // Check if there’s no ongoing transmission before sending
     if (!transmissionInProgress) {
-        bool success = processAndSendData((uint8_t*)plaintextSets[2], plainTextSize);
+        bool success = processAndSendData(message, messageLen);
+#if REPORT_POLICY
+        size_t paddedSize = (messageLen + CLEFIA_BLOCK_SIZE - 1) / CLEFIA_BLOCK_SIZE * CLEFIA_BLOCK_SIZE;
+        size_t dataPerPacket = ESP_NOW_MAX_PAYLOAD - sizeof(PacketHeader);
+        reportPolicy.setFramesPerReport((paddedSize + dataPerPacket - 1) / dataPerPacket);
+#endif
+#if BATCH_MODE
+        const WsnBatchStats &batchStats = batch.stats();
+        Serial.print(F("Batch "));
+        Serial.print(flush == WSN_BATCH_AGE ? F("age: ") : F("size: "));
+        Serial.print(batchStats.lastCount);
+        Serial.print(F(" pembacaan, "));
+        Serial.print(batchStats.lastBytes);
+        Serial.print(F(" bytes, "));
+        Serial.print(batchStats.lastEnergyPerReadingUj, 1);
+        Serial.print(F(" uJ/pembacaan (tanpa batch "));
+        Serial.print(batchStats.unbatchedEnergyPerReadingUj, 1);
+        Serial.println(F(")"));
+#endif
         // Print transmission status
         if (status) {
             Serial.println(F("Send successful"));
@@ -372,7 +573,22 @@ void loop() {
             Serial.println(F("Send failed"));
         }
     }
+#if SENSOR_CODEC
+    free(encoded);
+#endif
+#if LZ_COMPRESS
+    free(compressed);
+#endif
+    free(plaintext);
+
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') syntheticPayload.resize(Serial.parseInt());  // mis. "n4096"
+#if SLEEP_SCHEDULER
+        else if (command == 's') sleepScheduler.printResidency(Serial);
+#endif
+    }
     Serial.println("------------------------------------------------");
-    delay(2000); 
+    waitNextCycle();
     yield();
 }
\ No newline at end of file
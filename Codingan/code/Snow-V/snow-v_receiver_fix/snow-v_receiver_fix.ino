@@ -3,8 +3,12 @@
 #include <cstring>
 #include <stdint.h>
 #include <SD.h>
-#include <chrono>
-using namespace std::chrono;
+
+// Dekripsi, LZ, sensor codec dan simpan ke SD lewat WsnSecureLink (cipher sama dengan snowv_sender_fix)
+#include <WsnSecureLink.h>
+
+// 1 = 16 byte pertama pesan adalah IV (MESSAGE_IV 1 di snowv_sender_fix)
+#define MESSAGE_IV 1
 
 // Configuration constants
 const uint8_t key[32] = {
@@ -14,55 +18,24 @@ const uint8_t key[32] = {
     0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
 };
 
+// IV tetap untuk MESSAGE_IV 0
 const uint8_t iv[16] = {
     0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4A,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+#if MESSAGE_IV
+typedef WsnMessageIvFraming<> SnowVFraming;
+#else
+typedef WsnFixedIvFraming<> SnowVFraming;
+#endif
+WsnSecureLink<WsnSnowVCore, WsnKeystreamMode, SnowVFraming, WsnDecodedStorage<WsnFileStorage<SDClass, uint8_t>>>
+    secureLink(SD, "/snowv_data_decrypted_", FILE_WRITE);
+
 // Globals for received data
 uint8_t *receivedData = nullptr;
 size_t totalDataLen = 0;
 bool allFragmentsReceived = false;
-int fileIndex = 0; // File index for saving decrypted data
-
-// Functions for encryption and decryption
-void initializeSnowV(uint32_t *LFSR, uint32_t *FSM) {
-    memcpy(LFSR, key, 32);
-    memcpy(LFSR + 8, iv, 16);
-    memset(FSM, 0, 3 * sizeof(uint32_t));
-}
-
-void generateSnowVKeystream(uint32_t *LFSR, uint32_t *FSM, uint8_t *keystream, size_t len) {
-    for (size_t i = 0; i < len; i += 4) {
-        uint32_t f = (FSM[0] + LFSR[0]) ^ FSM[2];
-        FSM[2] = FSM[1];
-        FSM[1] = FSM[0];
-        FSM[0] = f;
-
-        uint32_t s = LFSR[11];
-        for (int j = 11; j > 0; j--) {
-            LFSR[j] = LFSR[j - 1];
-        }
-        LFSR[0] = s ^ f;
-
-        ((uint32_t *)keystream)[i / 4] = f;
-    }
-}
-
-void snowVEncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len) {
-    uint32_t LFSR[12], FSM[3];
-    initializeSnowV(LFSR, FSM);
-
-    uint8_t keystream[64];
-    size_t i = 0;
-
-    while (i < len) {
-        generateSnowVKeystream(LFSR, FSM, keystream, 64);
-        for (size_t j = 0; j < 64 && i < len; ++j, ++i) {
-            output[i] = input[i] ^ keystream[j];
-        }
-    }
-}
 
 // ESP-NOW data reception
 void onDataRecv(uint8_t *mac_addr, uint8_t *incomingData, uint8_t len) {
@@ -87,74 +60,35 @@ void onDataRecv(uint8_t *mac_addr, uint8_t *incomingData, uint8_t len) {
     }
 }
 
-// Decrypt received data
-uint8_t *decryptReceivedData(size_t &outLen) {
+// Process received messages
+void processReceivedMessage() {
     if (!allFragmentsReceived || receivedData == nullptr) {
-        return nullptr;
+        return;
     }
 
-    uint8_t *decryptedData = (uint8_t *)malloc(totalDataLen + 1);
-    if (decryptedData != nullptr) {
-        auto start = high_resolution_clock::now();
-        snowVEncryptDecrypt(receivedData, decryptedData, totalDataLen);
-        auto end = high_resolution_clock::now();
-        auto encryptDuration = duration_cast<microseconds>(end - start).count();
-        Serial.printf("Encryption Time: %ld microseconds\n", encryptDuration);
-        decryptedData[totalDataLen] = '\0';
-        outLen = totalDataLen;
+    if (!secureLink.receive(receivedData, totalDataLen)) {
+        Serial.println("Invalid message or failed to save data to SD card");
     } else {
-        Serial.println("Decryption buffer allocation failed!");
+        Serial.printf("Decryption Time: %lu microseconds\n", (unsigned long)secureLink.lastDecryptMicros);
+        if (secureLink.storage.lastLz) {
+            Serial.print("LZ: ");
+            Serial.print(secureLink.storage.lzStats.inputBytes);
+            Serial.print(" -> ");
+            Serial.print(secureLink.storage.lzStats.outputBytes);
+            Serial.print(" bytes, ");
+            Serial.print(secureLink.storage.lzStats.micros);
+            Serial.println(" us");
+        }
+        Serial.print("Data saved to /snowv_data_decrypted_");
+        Serial.print(secureLink.storage.inner.index() - 1);
+        Serial.println(".txt");
     }
+    Serial.println("------------------------------------------------");
 
     free(receivedData);
     receivedData = nullptr;
     totalDataLen = 0;
     allFragmentsReceived = false;
-
-    return decryptedData;
-}
-
-// Save decrypted data to SD card
-bool saveDecryptedDataToSD(const uint8_t *plaintext, size_t dataLen) {
-    String filename = "/snowv_data_decrypted_" + String(fileIndex) + ".txt";
-    File dataFile = SD.open(filename, FILE_WRITE);
-
-    if (!dataFile) {
-        Serial.println("Error opening file for writing");
-        return false;
-    }
-
-    size_t bytesWritten = dataFile.write(plaintext, dataLen);
-    dataFile.close();
-
-    if (bytesWritten != dataLen) {
-        Serial.println("Error writing to file");
-        return false;
-    }
-
-    Serial.print("Data saved to ");
-    Serial.println(filename);
-
-    fileIndex++;
-    return true;
-}
-
-// Process received messages
-void processReceivedMessage() {
-    size_t decryptedLen;
-    uint8_t *decryptedData = decryptReceivedData(decryptedLen);
-
-    if (decryptedData != nullptr) {
-        Serial.print("Decrypted Message: ");
-        Serial.println((char *)decryptedData);
-
-        if (!saveDecryptedDataToSD(decryptedData, decryptedLen)) {
-            Serial.println("Failed to save data to SD card");
-        }
-
-        free(decryptedData);
-        Serial.println("------------------------------------------------");
-    }
 }
 
 // ESP-NOW initialization
@@ -178,6 +112,9 @@ void setup() {
         return;
     }
 
+    // Receiver tidak membuat nonce; IV dibaca dari pesan (MESSAGE_IV 1) atau iv di atas
+    secureLink.begin(key, nullptr, iv);
+
     if (!initESPNow()) {
         Serial.println("ESP-NOW initialization failed");
     }
@@ -6,6 +6,104 @@
 #include "PlaintextData.h"
 using namespace std::chrono;
 
+// Log per siklus dikirim sebagai record biner lewat ring buffer (WsnLog.h), bukan hex per byte.
+// Baca dengan: python "visualisasi data/log_decode.py" COM3 --formats snowv_sender_fix.ino
+#include <WsnLog.h>
+#define WSN_LOG_FORMATS(X)                                                \
+    X(LOG_ENCRYPT_TIME, "Encryption Time: %ld microseconds")              \
+    X(LOG_PLAINTEXT_SIZE, "Plaintext Size: %d bytes")                     \
+    X(LOG_PLAINTEXT, "Plaintext: \"%s\"...")                              \
+    X(LOG_CIPHERTEXT, "Encrypted Data: %b...")                            \
+    X(LOG_SENSOR_CODEC, "Sensor codec: %u -> %u bytes (%u rekaman)")       \
+    X(LOG_LZ, "LZ: %u -> %u bytes, %u us, hemat ~%.0f uJ")                \
+    X(LOG_REPORT, "Report %s: T %d H %d, dihindari %u enkripsi, %u frame") \
+    X(LOG_BATCH, "Batch %s: %u pembacaan, %u bytes, %.1f uJ/pembacaan (tanpa batch %.1f)") \
+    X(LOG_SENT, "Sent successfully")                                      \
+    X(LOG_TOTAL_CHUNKS, "Total chunks sent: %d")                          \
+    X(LOG_SEND_FAILED, "Send Failed")                                     \
+    X(LOG_CYCLE_END, "------------------------------------------------")
+WSN_LOG_DECLARE(WSN_LOG_FORMATS)
+
+const size_t LOG_PREVIEW_BYTES = 16;  // cuplikan plaintext/ciphertext per pesan
+
+// Sumber plaintext: 0 = dataset tetap di flash (PlaintextData.h, indeks DATASET_INDEX),
+//                   1 = data DHT22 sintetis SYNTHETIC_SIZE byte; ubah saat jalan dengan "n<byte>"
+#include <WsnPayload.h>
+#define PAYLOAD_SOURCE 0
+#define DATASET_INDEX 1
+#define SYNTHETIC_SIZE 10011
+
+// 1 = rekaman "TT.TT,HH.HH" dikirim sebagai biner delta/varint (WsnSensorCodec.h, ~1 byte per
+//     rekaman, bukan 11); snow-v_receiver_fix mengembalikannya ke teks sebelum disimpan
+#include <WsnSensorCodec.h>
+#define SENSOR_CODEC 0
+uint32_t sensorIndex = 0;  // indeks rekaman pertama pesan berikutnya
+
+// 1 = pesan dikompres LZ (WsnLz.h) sebelum enkripsi
+#include <WsnLz.h>
+#define LZ_COMPRESS 0
+const float LZ_ENERGY_PER_BYTE_UJ = 0.574f;  // Snow-V: (0.006689 - 0.003819) J / 5000 byte
+WsnLzCompressor lzCompressor;
+
+// 1 = IV 16 byte per pesan = ID node + counter pesan (WsnNonce.h), dikirim di depan ciphertext;
+//     snow-v_receiver_fix harus MESSAGE_IV 1 juga. 0 = IV tetap format lama (keystream berulang
+//     antar pesan)
+#include <WsnNonce.h>
+#define MESSAGE_IV 1
+WsnNonceManager nonces;
+
+// 1 = enkripsi + kirim hanya saat DHT22 berubah, alarm, atau heartbeat (WsnReportPolicy.h)
+#include <WsnReportPolicy.h>
+#define REPORT_POLICY 0
+#define REPORT_HEARTBEAT_MS 60000
+WsnReportPolicy reportPolicy(wsnReportSenderConfig(REPORT_HEARTBEAT_MS));
+
+// 1 = sisa periode SLEEP_PERIOD_MS dipakai tidur, deep sleep jika SLEEP_DEEP 1 (WsnSleep.h)
+#include <WsnSleep.h>
+#define SLEEP_SCHEDULER 0
+#define SLEEP_PERIOD_MS 2000
+#define SLEEP_DEEP 0
+
+// 1 = pembacaan DHT22 dikumpulkan dan dikirim per batch (WsnBatch.h)
+#include <WsnBatch.h>
+#define BATCH_MODE 0
+#define BATCH_FRAMES 1
+#define BATCH_MAX_AGE_MS 60000
+
+WsnBatchConfig batchConfig() {
+    WsnBatchConfig config;
+    config.maxFrames = BATCH_FRAMES;
+    config.frameBytes = 240;
+    config.reserveBytes = MESSAGE_IV ? 16 : 0;  // IV, tanpa padding; fragmen 240 byte
+    config.maxAgeMs = BATCH_MAX_AGE_MS;
+    config.binary = SENSOR_CODEC;
+    config.messageEnergyUj = 943.0f;  // 0.003819 J - 5011 byte x marginal Snow-V
+    config.byteEnergyUj = LZ_ENERGY_PER_BYTE_UJ;
+    return config;
+}
+
+WsnBatch<WSN_BATCH_CAPACITY(SLEEP_SCHEDULER && SLEEP_DEEP)> batch(batchConfig());
+
+bool initESPNow();
+WsnSleepScheduler sleepScheduler(wsnSleepSenderConfig(SLEEP_PERIOD_MS, SLEEP_DEEP, initESPNow));
+
+// Waktu untuk timestamp laporan/batch; dengan scheduler tetap naik melewati deep sleep
+uint32_t nodeMillis() {
+#if SLEEP_SCHEDULER
+    return sleepScheduler.nowMs();
+#else
+    return wsnMillis();
+#endif
+}
+
+WsnFlashPayload datasetPayload(plaintextSets[DATASET_INDEX], plaintextSetSizes[DATASET_INDEX]);
+WsnDht22Payload syntheticPayload(SYNTHETIC_SIZE);
+#if PAYLOAD_SOURCE
+WsnPayloadSource &payload = syntheticPayload;
+#else
+WsnPayloadSource &payload = datasetPayload;
+#endif
+
 const uint8_t receiverMAC[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7}; // MAC address
 bool status;
 
@@ -17,8 +115,8 @@ const uint8_t key[32] = {
     0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
 };
 
-// 128-bit (16-byte) iv
-const uint8_t iv[16] = {
+// 128-bit (16-byte) iv; dengan MESSAGE_IV 1 diisi ulang tiap pesan
+uint8_t iv[16] = {
     0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4A,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
@@ -66,30 +164,34 @@ void snowVEncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len) {
     }
 }
 
-uint8_t* encryptMessage(const char *plaintext, size_t &len) {
-    len = strlen(plaintext);
+// len menjadi panjang pesan terkirim (termasuk IV jika MESSAGE_IV 1); nullptr jika IV gagal dibuat
+uint8_t* encryptMessage(const uint8_t *plaintext, size_t &len) {
+#if MESSAGE_IV
+    if (!nonces.next(iv, sizeof(iv))) {
+        Serial.println("Nonce checkpoint failed!");
+        return nullptr;
+    }
+    uint8_t *ciphertext = new uint8_t[sizeof(iv) + len];
+    memcpy(ciphertext, iv, sizeof(iv));
+    uint8_t *body = ciphertext + sizeof(iv);
+#else
     uint8_t *ciphertext = new uint8_t[len];
+    uint8_t *body = ciphertext;
+#endif
     
     // Measure encryption time
     auto start = high_resolution_clock::now();
-    snowVEncryptDecrypt((const uint8_t *)plaintext, ciphertext, len);
+    snowVEncryptDecrypt(plaintext, body, len);
     auto end = high_resolution_clock::now();
-    delay(2000);
+    len += body - ciphertext;
+#if !SLEEP_SCHEDULER
+    wsnLogDrainFor(Serial, 2000);  // dengan scheduler node tidur setelah kirim, bukan menunggu di sini
+#endif
 
-    // Calculate and print encryption time
+    // Catat waktu enkripsi dan cuplikan ciphertext (record biner, bukan hex per byte)
     auto encryptDuration = duration_cast<microseconds>(end - start).count();
-    Serial.printf("Encryption Time: %ld microseconds\n", encryptDuration);
-    Serial.printf("Plaintext Size: %d bytes\n", len);
-
-    Serial.print("Plaintext: ");
-    Serial.println(plaintext);
-
-    // Print the ciphertext in hexadecimal format
-    Serial.print("Encrypted Data: ");
-    for (size_t i = 0; i < len; i++) {
-        Serial.printf("%02X", ciphertext[i]); // Print each byte in hexadecimal
-    }
-    Serial.println(); // End the line after printing all bytes
+    wsnLog(LOG_ENCRYPT_TIME, (int32_t)encryptDuration);
+    wsnLog(LOG_CIPHERTEXT, wsnLogBlob(ciphertext, min(len, LOG_PREVIEW_BYTES)));
 
     return ciphertext;
 }
@@ -107,14 +209,14 @@ void sendEncryptedFragments(const uint8_t *ciphertext, size_t len) {
         sendFragment(ciphertext + offset, chunkSize, fragmentNum++, isLast);
         offset += chunkSize;
         totalChunks++;
-        delay(1);
+        wsnLogDrainFor(Serial, 1);
     }
 
     if (status) {
-        Serial.println("Sent successfully");
-        Serial.printf("Total chunks sent: %d\n", totalChunks);
+        wsnLog(LOG_SENT);
+        wsnLog(LOG_TOTAL_CHUNKS, totalChunks);
     } else {
-        Serial.println("Send Failed");
+        wsnLog(LOG_SEND_FAILED);
     }
 }
 
@@ -148,22 +250,121 @@ void onSend(uint8_t *mac_addr, uint8_t sendStatus) {
     }
 }
 
+// Akhir siklus: kirim sisa log lalu tidur sampai periode berikutnya, atau tunggu 2 detik
+void waitNextCycle() {
+#if SLEEP_SCHEDULER
+    wsnLogFlush(Serial);
+    Serial.flush();
+    sleepScheduler.sleep();
+#else
+    wsnLogDrainFor(Serial, 2000);
+#endif
+}
+
 void setup() {
     Serial.begin(115200);
-    WiFi.mode(WIFI_STA);
-
-    if (!initESPNow()) {
-        Serial.println("ESP-NOW initialization failed");
-        ESP.restart();
-    }
+#if MESSAGE_IV
+    nonces.begin();
+#endif
+#if SLEEP_SCHEDULER
+    // Batch dan kebijakan laporan dipulihkan dari RTC memory saat bangun dari deep sleep
+    sleepScheduler.keep(wsnSleepPart(batch, WSN_RTC_BATCH_OFFSET));
+    sleepScheduler.keep(wsnSleepPart(reportPolicy, WSN_RTC_POLICY_OFFSET));
+    sleepScheduler.begin();
+#endif
+    sleepScheduler.startRadio(receiverMAC, 1);
 }
 
 void loop() {
     size_t len;
-    uint8_t *ciphertext = encryptMessage(plaintextSets[1], len);
+#if REPORT_POLICY || BATCH_MODE
+    WsnReportCycle report = wsnReportCycle(REPORT_POLICY ? &reportPolicy : nullptr, nodeMillis(), LOG_REPORT);
+    if (!report.send) {
+        waitNextCycle();
+        return;
+    }
+#endif
+#if BATCH_MODE
+    WsnBatchFlush flush = batch.add(report.temperature, report.humidity, nodeMillis());
+    if (flush == WSN_BATCH_KEEP) {
+        waitNextCycle();
+        return;
+    }
+#endif
+    // Plaintext hanya ada di heap selama satu siklus
+#if BATCH_MODE
+    size_t batchLen;
+    char *plaintext = batch.takeTextAlloc(flush, batchLen);
+#else
+    char *plaintext = wsnPayloadLoadText(payload);
+#endif
+    if (plaintext == nullptr) {
+        Serial.println("Memory allocation failed!");
+        waitNextCycle();
+        return;
+    }
+    size_t plaintextLen = strlen(plaintext);
+    char preview[LOG_PREVIEW_BYTES + 1];
+    strncpy(preview, plaintext, LOG_PREVIEW_BYTES);
+    preview[LOG_PREVIEW_BYTES] = '\0';
+    wsnLog(LOG_PLAINTEXT_SIZE, plaintextLen);
+    wsnLog(LOG_PLAINTEXT, preview);
+
+    const uint8_t *message = (const uint8_t *)plaintext;
+    len = plaintextLen;
+#if SENSOR_CODEC
+    // Teks tanpa rekaman sensor (plaintextTesting) tetap dikirim apa adanya
+    uint32_t firstIndex = sensorIndex;
+    uint8_t *encoded = wsnSensorEncodeAlloc(plaintext, plaintextLen, len, sensorIndex);
+    if (encoded != nullptr) {
+        message = encoded;
+        wsnLog(LOG_SENSOR_CODEC, plaintextLen, len, sensorIndex - firstIndex);
+    } else {
+        len = plaintextLen;
+    }
+#endif
+#if LZ_COMPRESS
+    WsnLzStats lzStats;
+    size_t compressedLen;
+    uint8_t *compressed = wsnLzCompressAlloc(lzCompressor, message, len, compressedLen, &lzStats);
+    if (compressed != nullptr) {
+        message = compressed;
+        len = compressedLen;
+        wsnLog(LOG_LZ, lzStats.inputBytes, lzStats.outputBytes, lzStats.micros,
+               wsnLzEnergySavedUj(lzStats, LZ_ENERGY_PER_BYTE_UJ));
+    }
+#endif
+    uint8_t *ciphertext = encryptMessage(message, len);
+#if SENSOR_CODEC
+    free(encoded);
+#endif
+#if LZ_COMPRESS
+    free(compressed);
+#endif
+    free(plaintext);
+    if (ciphertext == nullptr) {
+        waitNextCycle();
+        return;
+    }
     sendEncryptedFragments(ciphertext, len);
+#if REPORT_POLICY
+    reportPolicy.setFramesPerReport((len + 239) / 240);
+#endif
+#if BATCH_MODE
+    const WsnBatchStats &batchStats = batch.stats();
+    wsnLog(LOG_BATCH, flush == WSN_BATCH_AGE ? "age" : "size", batchStats.lastCount, batchStats.lastBytes,
+           batchStats.lastEnergyPerReadingUj, batchStats.unbatchedEnergyPerReadingUj);
+#endif
     delete[] ciphertext;
 
-    Serial.println("------------------------------------------------");
-    delay(2000);
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') syntheticPayload.resize(Serial.parseInt());  // mis. "n4096"
+#if SLEEP_SCHEDULER
+        else if (command == 's') sleepScheduler.printResidency(Serial);
+#endif
+    }
+
+    wsnLog(LOG_CYCLE_END);
+    waitNextCycle();
 }
@@ -0,0 +1,160 @@
+#include <ESP8266WiFi.h>
+#include <espnow.h>
+#include <SPI.h>
+#include <SD.h>
+#include <cstring>
+#include <stdint.h>
+
+// Pasangan cipher_ab_sender: byte pertama pesan = ID cipher (WsnCipherRegistry.h), engine dipilih
+// per pesan. Pesan AEAD dengan tag salah dibuang; hasil disimpan per cipher ke
+// /<cipher>_<indeks>.txt supaya sweep beberapa cipher bisa dipisahkan setelah kampanye.
+
+#include <WsnCipherRegistry.h>
+
+#define MAX_INPUT_SIZE 16384
+#define TIMEOUT_MS 100 // Timeout 100ms untuk mendeteksi akhir transmisi
+#define SD_CS_PIN D8 // Ubah ini sesuai dengan Chip Select pin SD module
+
+// Key, sama dengan cipher_ab_sender
+uint8_t key[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+uint32_t fileIndex[WSN_CIPHER_COUNT];  // penamaan file per cipher
+uint32_t rejectedMessages = 0;
+
+// Variabel untuk menyimpan data penerimaan
+uint8_t receivedData[MAX_INPUT_SIZE];
+size_t totalReceived = 0;
+unsigned long lastReceiveTime = 0;
+bool isReceiving = false;
+
+// Inisialisasi SD Card
+bool initSDCard() {
+    if (!SD.begin(SD_CS_PIN)) {
+        Serial.println("SD Card initialization failed!");
+        return false;
+    }
+    Serial.println("SD Card initialized successfully");
+    return true;
+}
+
+// Simpan hasil dekripsi ke SD Card
+bool saveDecryptedDataToSD(uint8_t id, uint8_t* plaintext, size_t dataLen) {
+    String filename = "/" + String(wsnCipherEngines[id].name) + "_" + String(fileIndex[id]) + ".txt";
+    File dataFile = SD.open(filename, FILE_WRITE);
+
+    if (!dataFile) {
+        Serial.println("Error opening file for writing");
+        return false;
+    }
+
+    size_t bytesWritten = dataFile.write(plaintext, dataLen);
+    dataFile.close();
+
+    if (bytesWritten != dataLen) {
+        Serial.println("Error writing to file");
+        return false;
+    }
+
+    Serial.print("Data saved to ");
+    Serial.println(filename);
+    fileIndex[id]++;
+    return true;
+}
+
+// Callback penerimaan data
+void onDataReceived(uint8_t *mac_addr, uint8_t *data, uint8_t len) {
+    if (totalReceived + len <= MAX_INPUT_SIZE) {
+        memcpy(receivedData + totalReceived, data, len);
+        totalReceived += len;
+        lastReceiveTime = millis();
+        isReceiving = true;
+    }
+}
+
+// Dekripsi dan simpan satu pesan utuh di receivedData
+void handleMessage(size_t messageLen) {
+    uint8_t id = receivedData[0];
+    const WsnCipherEngine *engine = wsnCipherEngine(id);
+    if (engine == nullptr) {
+        Serial.print("Unknown cipher id ");
+        Serial.println(id);
+        return;
+    }
+
+    Serial.print("Cipher: ");
+    Serial.print(engine->name);
+    Serial.print(", Total Received Data Size: ");
+    Serial.print(messageLen);
+    Serial.println(" bytes");
+
+    size_t plaintextLen = 0;
+    uint32_t decryptionTime = 0;
+    if (!engine->open(receivedData, messageLen, plaintextLen, decryptionTime)) {
+        if (engine->authenticated) {
+            rejectedMessages++;
+            Serial.print("Tag mismatch, message dropped (");
+            Serial.print(rejectedMessages);
+            Serial.println(" total)");
+        } else {
+            Serial.println("Invalid data! Not enough for header and ciphertext.");
+        }
+        return;
+    }
+
+    Serial.print("Decryption Time: ");
+    Serial.print(decryptionTime);
+    Serial.println(" microseconds");
+    Serial.println("------------------------------------------------");
+
+    // Padding nol (clefia256) dibuang sebelum disimpan, seperti clefia_receiver
+    if (engine->zeroPadded) {
+        while (plaintextLen > 0 && receivedData[plaintextLen - 1] == 0x00) plaintextLen--;
+    }
+    saveDecryptedDataToSD(id, receivedData, plaintextLen);
+}
+
+// Proses data diterima
+void processReceivedData() {
+    if (totalReceived > 0) {
+        handleMessage(totalReceived);
+        totalReceived = 0;
+        isReceiving = false;
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+
+    Serial.print("MAC Address: ");
+    Serial.println(WiFi.macAddress());
+
+    if (esp_now_init() != 0) {
+        Serial.println("Error initializing ESP-NOW");
+        ESP.restart();
+    }
+
+    if (!initSDCard()) {
+        Serial.println("SD Card initialization failed.");
+    }
+
+    // Receiver tidak membuat nonce; IV/nonce dibaca dari pesan
+    wsnCipherRegistryBegin(key, nullptr);
+
+    esp_now_set_self_role(ESP_NOW_ROLE_SLAVE);
+    esp_now_register_recv_cb(onDataReceived);
+    Serial.println("Receiver Ready");
+}
+
+void loop() {
+    if (isReceiving && (millis() - lastReceiveTime > TIMEOUT_MS)) {
+        processReceivedData();
+    }
+    yield();
+}
@@ -0,0 +1,233 @@
+#include <ESP8266WiFi.h>
+#include <espnow.h>
+#include <cstring>
+#include <stdint.h>
+
+// Satu firmware sender untuk semua cipher (WsnCipherRegistry.h): cipher dipilih per pesan dan
+// dikirim sebagai byte pertama pesan, cipher_ab_receiver memilih engine dari byte itu. Tidak perlu
+// flash ulang chacha_sender / snowv_sender_fix / AES256_Sender_Fix / clefia_sender per algoritma.
+//
+// Perintah serial:
+//   l          daftar engine dan ID
+//   c<id>      pilih cipher, mis. "c5" = aes256gcm
+//   n<byte>    ukuran plaintext, mis. "n4096"
+//   s          mulai sweep: setiap cipher x SWEEP_SIZES, SWEEP_MESSAGES pesan per kombinasi
+//   x          hentikan sweep
+// Selama satu kombinasi sweep MARKER_PIN HIGH, untuk jendela energi di ina_power_2ms.
+
+// Log per pesan sebagai record biner lewat ring buffer (WsnLog.h).
+// Baca dengan: python "visualisasi data/log_decode.py" COM3 --formats cipher_ab_sender.ino
+#include <WsnLog.h>
+#define WSN_LOG_FORMATS(X)                                                          \
+    X(LOG_MESSAGE, "%s: %u bytes -> %u bytes, %u frame, enkripsi %lu us")           \
+    X(LOG_SEND_FAILED, "%s: gagal kirim (frame %u)")                                \
+    X(LOG_SWEEP, "Sweep %s %u bytes mulai (%u pesan)")                              \
+    X(LOG_SWEEP_DONE, "Sweep selesai")                                              \
+    X(LOG_CYCLE_END, "------------------------------------------------")
+WSN_LOG_DECLARE(WSN_LOG_FORMATS)
+
+#include <WsnCipherRegistry.h>
+#include <WsnPayload.h>
+
+#define CIPHER_DEFAULT WSN_CIPHER_CHACHA20
+#define MESSAGE_SIZE 5011        // plaintext DHT22 sintetis (WsnDht22Payload)
+#define MESSAGE_PERIOD_MS 2000
+
+// 5011/10011 = ukuran plaintext5kb/plaintext10kb di sketch per cipher
+const size_t SWEEP_SIZES[] = {256, 1024, 5011, 10011};
+const size_t SWEEP_SIZE_COUNT = sizeof(SWEEP_SIZES) / sizeof(SWEEP_SIZES[0]);
+#define SWEEP_MESSAGES 10
+#define SWEEP_ON_BOOT 0
+
+// HIGH selama satu kombinasi sweep (-1 = nonaktif)
+#define MARKER_PIN -1
+
+uint8_t receiverMAC[] = {0x84, 0xF3, 0xEB, 0x05, 0x50, 0xB7};
+
+// 256 bit key, sama dengan cipher_ab_receiver (ASCON memakai 16 byte pertama)
+uint8_t key[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+// Satu counter nonce untuk semua engine (WsnNonce.h)
+#include <WsnNonce.h>
+WsnNonceManager nonces;
+
+WsnDht22Payload payload(MESSAGE_SIZE);
+uint8_t cipherId = CIPHER_DEFAULT;
+
+// Transmission State Variables
+size_t totalChunks = 0;
+size_t chunkIndex = 0;
+size_t chunksAcked = 0;
+bool status = true;  // hasil frame sebelumnya
+
+struct SweepState {
+    bool active;
+    uint8_t cipher;
+    size_t sizeIndex;
+    uint16_t sent;
+};
+SweepState sweep = {false, 0, 0, 0};
+
+// Transmission Callback
+void onSend(uint8_t *mac_addr, uint8_t deliveryStatus) {
+    if (deliveryStatus == 0) {  // Jika terkirim sukses
+        status = true;
+        chunksAcked++;
+    } else {
+        status = false;
+    }
+}
+
+// ESP-NOW Initialization
+bool initESPNow() {
+    if (esp_now_init() != 0) {  // ESP8266 menggunakan 0 sebagai indikator sukses
+        Serial.println("Error initializing ESP-NOW");
+        return false;
+    }
+    esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);
+    esp_now_register_send_cb(onSend);
+    return true;
+}
+
+// Pairing with Receiver
+bool pairWithPeer() {
+    if (esp_now_is_peer_exist(receiverMAC)) {
+        return true;  // Peer sudah ada
+    }
+
+    if (esp_now_add_peer(receiverMAC, ESP_NOW_ROLE_SLAVE, 1, NULL, 0) != 0) {
+        Serial.println("Failed to add peer");
+        return false;
+    }
+    Serial.println("Pairing successful");
+    return true;
+}
+
+// WsnFrameSink: satu frame ESP-NOW; false jika frame sebelumnya gagal
+bool sendFrame(uint8_t *frame, size_t len, void *) {
+    esp_now_send(receiverMAC, frame, len);
+    if (status == false) {
+        return false;
+    }
+    chunkIndex++;
+    wsnLogDrainFor(Serial, 10);  // Jeda agar tidak overload, sambil mengirim log
+    return true;
+}
+
+// Enkripsi + kirim satu pesan dengan cipher id
+bool sendMessage(uint8_t id) {
+    const WsnCipherEngine *engine = wsnCipherEngine(id);
+    size_t wireLen = engine->wireLength(payload.size());
+    totalChunks = (wireLen + WSN_REGISTRY_FRAME_BYTES - 1) / WSN_REGISTRY_FRAME_BYTES;
+    chunkIndex = 0;
+    chunksAcked = 0;
+
+    uint32_t encryptionTime = 0;
+    if (!wsnCipherSeal(id, payload, sendFrame, nullptr, encryptionTime)) {
+        wsnLog(LOG_SEND_FAILED, engine->name, chunkIndex);
+        return false;
+    }
+    wsnLog(LOG_MESSAGE, engine->name, payload.size(), wireLen, totalChunks, encryptionTime);
+    return true;
+}
+
+void printEngines() {
+    for (uint8_t i = 0; i < WSN_CIPHER_COUNT; i++) {
+        Serial.print(i);
+        Serial.print(" = ");
+        Serial.print(wsnCipherEngines[i].name);
+        Serial.println(wsnCipherEngines[i].authenticated ? " (AEAD)" : "");
+    }
+}
+
+void startSweep() {
+    sweep.active = true;
+    sweep.cipher = 0;
+    sweep.sizeIndex = 0;
+    sweep.sent = 0;
+}
+
+// Pesan berikutnya dalam sweep: ukuran naik dulu, lalu cipher berikutnya
+void sweepStep() {
+    if (sweep.sent == 0) {
+        payload.resize(SWEEP_SIZES[sweep.sizeIndex]);
+        wsnLog(LOG_SWEEP, wsnCipherEngines[sweep.cipher].name, SWEEP_SIZES[sweep.sizeIndex], SWEEP_MESSAGES);
+#if MARKER_PIN >= 0
+        digitalWrite(MARKER_PIN, HIGH);
+#endif
+    }
+
+    sendMessage(sweep.cipher);
+
+    if (++sweep.sent < SWEEP_MESSAGES) return;
+#if MARKER_PIN >= 0
+    digitalWrite(MARKER_PIN, LOW);
+#endif
+    sweep.sent = 0;
+    if (++sweep.sizeIndex < SWEEP_SIZE_COUNT) return;
+    sweep.sizeIndex = 0;
+    if (++sweep.cipher < WSN_CIPHER_COUNT) return;
+    sweep.active = false;
+    payload.resize(MESSAGE_SIZE);
+    wsnLog(LOG_SWEEP_DONE);
+}
+
+void setup() {
+    Serial.begin(115200);
+    nonces.begin();
+    WiFi.mode(WIFI_STA);
+#if MARKER_PIN >= 0
+    pinMode(MARKER_PIN, OUTPUT);
+    digitalWrite(MARKER_PIN, LOW);
+#endif
+
+    if (!initESPNow()) {
+        Serial.println("ESP-NOW initialization failed");
+        ESP.restart();
+    }
+
+    if (!pairWithPeer()) {
+        Serial.println("Peer pairing failed");
+        ESP.restart();
+    }
+
+    // Key schedule semua engine sekali
+    wsnCipherRegistryBegin(key, &nonces);
+    printEngines();
+#if SWEEP_ON_BOOT
+    startSweep();
+#endif
+}
+
+void loop() {
+    if (sweep.active) {
+        sweepStep();
+    } else {
+        sendMessage(cipherId);
+    }
+    wsnLog(LOG_CYCLE_END);
+
+    while (Serial.available()) {
+        char command = Serial.read();
+        if (command == 'n') payload.resize(Serial.parseInt());
+        else if (command == 'c') {
+            long id = Serial.parseInt();
+            if (id >= 0 && id < WSN_CIPHER_COUNT) cipherId = (uint8_t)id;
+        }
+        else if (command == 'l') printEngines();
+        else if (command == 's') startSweep();
+        else if (command == 'x') {
+            sweep.active = false;
+            payload.resize(MESSAGE_SIZE);
+#if MARKER_PIN >= 0
+            digitalWrite(MARKER_PIN, LOW);
+#endif
+        }
+    }
+    wsnLogDrainFor(Serial, MESSAGE_PERIOD_MS);
+}
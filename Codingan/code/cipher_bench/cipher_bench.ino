@@ -0,0 +1,85 @@
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+#include <WsnBenchCiphers.h>
+#include <WsnPayload.h>
+
+// Benchmark kernel cipher di node dengan API yang sama seperti code/host/cipher_bench.
+// Hasil dikirim lewat serial sebagai CSV (atau JSON Lines); simpan log serial ke
+// bench_esp8266.csv lalu plot dengan "python computationTime.py bench_esp8266.csv".
+//
+// Library WsnNode harus ada di folder libraries sketchbook (Codingan/libraries).
+
+#define OUTPUT_JSON 0
+
+// Daya aktif CPU untuk kolom uj_per_byte (ESP8266 ~70 mA @ 3.3 V); ganti dengan hasil ukur
+// ina_power_2ms selama MARKER_PIN HIGH untuk angka yang lebih tepat
+#define ACTIVE_POWER_MW 230.0f
+
+// HIGH selama satu ukuran diukur, untuk jendela energi di ina_power_2ms (-1 = nonaktif)
+#define MARKER_PIN -1
+
+const unsigned long SERIAL_BAUD_RATE = 115200;
+
+// Dibatasi heap ESP8266; 5011/10011 = ukuran plaintext5kb/plaintext10kb
+const size_t BENCH_SIZES[] = {16, 64, 256, 1024, 4096, 5011, 10011};
+const size_t BENCH_SIZE_COUNT = sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]);
+
+WsnBenchConfig benchConfig;
+double samples[31];
+uint8_t *buffer = nullptr;
+
+void runBenchmarks() {
+  if (!OUTPUT_JSON) wsnBenchWriteCsvHeader(Serial);
+
+  for (size_t c = 0; c < wsnBenchCipherCount; c++) {
+    const WsnBenchCipher &cipher = wsnBenchCiphers[c];
+    for (size_t s = 0; s < BENCH_SIZE_COUNT; s++) {
+#if MARKER_PIN >= 0
+      digitalWrite(MARKER_PIN, HIGH);
+#endif
+      WsnBenchResult r = wsnBenchRun(cipher.name, cipher.kernel, nullptr, buffer, BENCH_SIZES[s],
+                                     benchConfig, samples);
+#if MARKER_PIN >= 0
+      digitalWrite(MARKER_PIN, LOW);
+#endif
+      if (OUTPUT_JSON) wsnBenchWriteJson(Serial, r);
+      else wsnBenchWriteCsv(Serial, r);
+    }
+  }
+  Serial.println("# selesai");
+}
+
+void setup() {
+  Serial.begin(SERIAL_BAUD_RATE);
+  delay(2000);
+
+  // Radio dimatikan supaya interrupt WiFi tidak ikut terukur
+  WiFi.mode(WIFI_OFF);
+#if MARKER_PIN >= 0
+  pinMode(MARKER_PIN, OUTPUT);
+  digitalWrite(MARKER_PIN, LOW);
+#endif
+
+  benchConfig.repeats = sizeof(samples) / sizeof(samples[0]);
+  benchConfig.activePowerMw = ACTIVE_POWER_MW;
+  buffer = (uint8_t *)malloc(BENCH_SIZES[BENCH_SIZE_COUNT - 1] + 16);
+  if (!buffer) {
+    Serial.println("# gagal alokasi buffer benchmark");
+    return;
+  }
+  // Isi dengan teks sensor sintetis seperti plaintext sender (waktu cipher tidak bergantung data)
+  WsnDht22Payload sensorText(BENCH_SIZES[BENCH_SIZE_COUNT - 1] + 16);
+  wsnPayloadReadAll(sensorText, buffer, sensorText.size());
+
+  runBenchmarks();
+}
+
+void loop() {
+  // Kirim 'b' lewat serial untuk mengulang benchmark
+  if (buffer && Serial.available() && Serial.read() == 'b') {
+    runBenchmarks();
+  }
+}
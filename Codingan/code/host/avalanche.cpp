@@ -0,0 +1,355 @@
+// Pengukuran avalanche effect untuk keempat cipher (ChaCha20, Snow-V, AES-256-CBC, CLEFIA-256)
+// memakai implementasi yang sama dengan node (library WsnNode).
+//
+// Tiap trial memakai key, nonce/IV dan plaintext acak; setiap bit input dari kelas yang
+// dipilih dibalik satu per satu dan ciphertext dibandingkan dengan ciphertext asal:
+//   - distribusi Hamming distance (histogram, mean, deviasi standar; ideal out_bits/2)
+//   - matriks Strict Avalanche Criterion P(bit output j berubah | bit input i dibalik)
+//
+// Matriks SAC diakumulasi dengan counter vertikal bit-sliced: 8 bit-plane per word 64 bit
+// output, satu penjumlahan = beberapa AND/XOR untuk 64 bit sekaligus, dan plane di-flush
+// ke counter 64 bit setiap 255 penjumlahan. Trial dibagi rata ke semua thread, masing-masing
+// dengan RNG dan akumulator sendiri, lalu digabung di akhir.
+//
+// Build : g++ -O2 -march=native -std=c++17 -pthread -I ../../libraries/WsnNode/src -o avalanche avalanche.cpp
+// Pakai : ./avalanche -c all -n 20000
+//         ./avalanche -c aes256cbc -i key -n 100000 -o hasil   (hasil_aes256cbc_key_hd.csv, _sac.csv)
+//
+// Catatan: untuk stream cipher (ChaCha20, Snow-V) membalik bit plaintext selalu mengubah
+// tepat satu bit ciphertext; itu sifat struktural, bukan kelemahan implementasi. Pada CBC,
+// bit plaintext di blok k hanya memengaruhi blok k dan sesudahnya. CLEFIA dipakai dalam
+// mode ECB di sender sehingga tidak punya kelas IV.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "WsnAes256.h"
+#include "WsnChaCha20.h"
+#include "WsnClefia256.h"
+#include "WsnSnowV.h"
+
+enum InputClass { INPUT_KEY, INPUT_IV, INPUT_PLAINTEXT, INPUT_CLASSES };
+
+const char *INPUT_NAMES[INPUT_CLASSES] = {"key", "iv", "plaintext"};
+
+struct CipherSpec {
+    const char *name;
+    size_t ivBytes;
+    void (*encrypt)(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output, size_t len);
+};
+
+void chachaEncrypt(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output, size_t len) {
+    chacha20EncryptDecrypt(input, output, len, key, iv, 1);  // counter awal sama dengan chacha_sender
+}
+
+void snowVEncrypt(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output, size_t len) {
+    snowVEncryptDecrypt(input, output, len, key, iv);
+}
+
+void aesEncrypt(const uint8_t *key, const uint8_t *iv, const uint8_t *input, uint8_t *output, size_t len) {
+    aes256CbcEncrypt(input, output, len, key, iv);
+}
+
+void clefiaEncrypt(const uint8_t *key, const uint8_t *, const uint8_t *input, uint8_t *output, size_t len) {
+    Clefia256Context ctx;
+    clefia256SetKey(ctx, key);
+    clefia256EcbEncrypt(ctx, input, output, len);
+}
+
+const CipherSpec CIPHERS[] = {
+    {"chacha20", 12, chachaEncrypt},
+    {"snowv", 16, snowVEncrypt},
+    {"aes256cbc", 16, aesEncrypt},
+    {"clefia256", 0, clefiaEncrypt},
+};
+
+// Counter vertikal: plane[k] menyimpan bit ke-k dari 64 counter 8 bit sekaligus
+struct SacAccumulator {
+    size_t inBits = 0, outWords = 0;
+    std::vector<uint64_t> planes;  // [inBit][outWord][8]
+    std::vector<uint64_t> counts;  // [inBit][outBit]
+    unsigned pending = 0;
+
+    void init(size_t in, size_t outBytes) {
+        inBits = in;
+        outWords = (outBytes + 7) / 8;
+        planes.assign(inBits * outWords * 8, 0);
+        counts.assign(inBits * outWords * 64, 0);
+    }
+
+    void add(size_t inBit, const uint64_t *diff) {
+        uint64_t *p = &planes[inBit * outWords * 8];
+        for (size_t w = 0; w < outWords; w++, p += 8) {
+            uint64_t carry = diff[w];
+            for (int k = 0; k < 8 && carry; k++) {
+                uint64_t next = p[k] & carry;
+                p[k] ^= carry;
+                carry = next;
+            }
+        }
+    }
+
+    // Dipanggil sekali per trial (setelah semua bit input); counter 8 bit penuh di 255
+    void endTrial() {
+        if (++pending == 255) flush();
+    }
+
+    void flush() {
+        for (size_t i = 0; i < inBits * outWords; i++) {
+            uint64_t *p = &planes[i * 8];
+            uint64_t *c = &counts[i * 64];
+            for (int k = 0; k < 8; k++) {
+                uint64_t plane = p[k];
+                while (plane) {
+                    c[__builtin_ctzll(plane)] += 1ull << k;
+                    plane &= plane - 1;
+                }
+                p[k] = 0;
+            }
+        }
+        pending = 0;
+    }
+};
+
+struct ClassResult {
+    size_t inBits = 0;
+    uint64_t trials = 0;
+    std::vector<uint64_t> histogram;  // indeks = Hamming distance
+    SacAccumulator sac;
+};
+
+struct Options {
+    size_t messageBytes = 64;
+    uint64_t trials = 10000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 0x5eed;
+    bool classes[INPUT_CLASSES] = {true, true, true};
+    std::string outputPrefix;
+};
+
+// Hamming distance dari dua ciphertext sekaligus menulis word XOR-nya (untuk SAC)
+inline unsigned diffWords(const uint8_t *a, const uint8_t *b, size_t len, uint64_t *diff) {
+    unsigned distance = 0;
+    size_t words = (len + 7) / 8;
+    for (size_t w = 0; w < words; w++) {
+        uint64_t x = 0, y = 0;
+        size_t n = std::min<size_t>(8, len - w * 8);
+        memcpy(&x, a + w * 8, n);
+        memcpy(&y, b + w * 8, n);
+        diff[w] = x ^ y;
+        distance += __builtin_popcountll(diff[w]);
+    }
+    return distance;
+}
+
+void runWorker(const CipherSpec &cipher, const Options &opt, uint64_t trials, uint64_t seed,
+               std::vector<ClassResult> &results) {
+    const size_t len = opt.messageBytes;
+    const size_t outBits = len * 8;
+    const size_t inBytes[INPUT_CLASSES] = {32, cipher.ivBytes, len};
+
+    for (int c = 0; c < INPUT_CLASSES; c++) {
+        results[c].inBits = inBytes[c] * 8;
+        results[c].histogram.assign(outBits + 1, 0);
+        if (opt.classes[c] && inBytes[c]) results[c].sac.init(inBytes[c] * 8, len);
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<uint8_t> inputs[INPUT_CLASSES] = {std::vector<uint8_t>(32),
+                                                  std::vector<uint8_t>(std::max<size_t>(cipher.ivBytes, 1)),
+                                                  std::vector<uint8_t>(len)};
+    std::vector<uint8_t> base(len), flipped(len);
+    std::vector<uint64_t> diff((len + 7) / 8);
+
+    auto fill = [&](std::vector<uint8_t> &v) {
+        for (size_t i = 0; i < v.size(); i += 8) {
+            uint64_t r = rng();
+            memcpy(&v[i], &r, std::min<size_t>(8, v.size() - i));
+        }
+    };
+
+    for (uint64_t t = 0; t < trials; t++) {
+        for (auto &v : inputs) fill(v);
+        const uint8_t *key = inputs[INPUT_KEY].data();
+        const uint8_t *iv = inputs[INPUT_IV].data();
+        const uint8_t *plaintext = inputs[INPUT_PLAINTEXT].data();
+        cipher.encrypt(key, iv, plaintext, base.data(), len);
+
+        for (int c = 0; c < INPUT_CLASSES; c++) {
+            if (!opt.classes[c] || !inBytes[c]) continue;
+            ClassResult &r = results[c];
+            uint8_t *target = inputs[c].data();
+            for (size_t bit = 0; bit < r.inBits; bit++) {
+                target[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+                cipher.encrypt(key, iv, plaintext, flipped.data(), len);
+                target[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+
+                r.histogram[diffWords(base.data(), flipped.data(), len, diff.data())]++;
+                r.sac.add(bit, diff.data());
+            }
+            r.trials++;
+            r.sac.endTrial();
+        }
+    }
+
+    for (int c = 0; c < INPUT_CLASSES; c++) {
+        if (opt.classes[c] && inBytes[c]) results[c].sac.flush();
+    }
+}
+
+void merge(ClassResult &into, const ClassResult &from) {
+    if (into.histogram.empty()) {
+        into = from;
+        return;
+    }
+    into.trials += from.trials;
+    for (size_t i = 0; i < into.histogram.size(); i++) into.histogram[i] += from.histogram[i];
+    for (size_t i = 0; i < into.sac.counts.size(); i++) into.sac.counts[i] += from.sac.counts[i];
+}
+
+void report(const CipherSpec &cipher, InputClass c, const ClassResult &r, const Options &opt) {
+    const size_t outBits = opt.messageBytes * 8;
+    uint64_t flips = 0;
+    double sum = 0, sumSq = 0;
+    for (size_t d = 0; d < r.histogram.size(); d++) {
+        flips += r.histogram[d];
+        sum += (double)d * r.histogram[d];
+        sumSq += (double)d * d * r.histogram[d];
+    }
+    double mean = sum / flips;
+    double stddev = std::sqrt(std::max(0.0, sumSq / flips - mean * mean));
+
+    // SAC: tiap sel idealnya 0.5; batas 3 sigma binomial untuk jumlah trial ini
+    double bound = 3 * 0.5 / std::sqrt((double)r.trials);
+    double maxDeviation = 0, meanDeviation = 0;
+    size_t outside = 0;
+    for (size_t i = 0; i < r.inBits; i++) {
+        for (size_t j = 0; j < outBits; j++) {
+            double p = (double)r.sac.counts[i * r.sac.outWords * 64 + j] / r.trials;
+            double deviation = std::fabs(p - 0.5);
+            maxDeviation = std::max(maxDeviation, deviation);
+            meanDeviation += deviation;
+            if (deviation > bound) outside++;
+        }
+    }
+    size_t cells = r.inBits * outBits;
+    meanDeviation /= cells;
+
+    printf("%-10s %-9s %8llu %11llu %9.4f %9.3f %9.4f %9.4f %8.4f%%\n", cipher.name, INPUT_NAMES[c],
+           (unsigned long long)r.trials, (unsigned long long)flips, mean / outBits, stddev, maxDeviation,
+           meanDeviation, 100.0 * outside / cells);
+
+    if (opt.outputPrefix.empty()) return;
+    std::string base = opt.outputPrefix + "_" + cipher.name + "_" + INPUT_NAMES[c];
+
+    FILE *hd = fopen((base + "_hd.csv").c_str(), "w");
+    if (hd) {
+        fprintf(hd, "distance,count\n");
+        for (size_t d = 0; d < r.histogram.size(); d++) {
+            if (r.histogram[d]) fprintf(hd, "%zu,%llu\n", d, (unsigned long long)r.histogram[d]);
+        }
+        fclose(hd);
+    }
+
+    FILE *sac = fopen((base + "_sac.csv").c_str(), "w");
+    if (sac) {
+        // Baris = bit input, kolom = bit output (urutan byte little-endian, bit 0 = LSB)
+        for (size_t i = 0; i < r.inBits; i++) {
+            for (size_t j = 0; j < outBits; j++) {
+                fprintf(sac, j ? ",%.5f" : "%.5f", (double)r.sac.counts[i * r.sac.outWords * 64 + j] / r.trials);
+            }
+            fputc('\n', sac);
+        }
+        fclose(sac);
+    }
+}
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+            "Penggunaan: %s [-c cipher] [-i kelas] [-n trial] [-l byte] [-j thread] [-s seed] [-o prefix]\n"
+            "  -c NAMA  chacha20 | snowv | aes256cbc | clefia256 | all (default all)\n"
+            "  -i KELAS key | iv | plaintext | all (default all, boleh dipisah koma)\n"
+            "  -n N     jumlah trial per cipher (default 10000)\n"
+            "  -l N     panjang pesan dalam byte (default 64, kelipatan 16)\n"
+            "  -j N     jumlah thread (default: semua core)\n"
+            "  -s N     seed RNG (default tetap, hasil bisa diulang)\n"
+            "  -o P     simpan histogram <P>_<cipher>_<kelas>_hd.csv dan matriks SAC _sac.csv\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    std::string cipherName = "all";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](void) -> const char * {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "-c") cipherName = value();
+        else if (arg == "-n") opt.trials = strtoull(value(), nullptr, 10);
+        else if (arg == "-l") opt.messageBytes = strtoul(value(), nullptr, 10);
+        else if (arg == "-j") opt.threads = std::max(1ul, strtoul(value(), nullptr, 10));
+        else if (arg == "-s") opt.seed = strtoull(value(), nullptr, 0);
+        else if (arg == "-o") opt.outputPrefix = value();
+        else if (arg == "-i") {
+            std::string list = value();
+            if (list != "all") {
+                for (int c = 0; c < INPUT_CLASSES; c++) {
+                    opt.classes[c] = list.find(INPUT_NAMES[c]) != std::string::npos;
+                }
+            }
+        } else {
+            printUsage(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    if (opt.messageBytes == 0 || opt.messageBytes % 16 != 0 || opt.trials == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    printf("%-10s %-9s %8s %11s %9s %9s %9s %9s %9s\n", "cipher", "input", "trials", "flips", "HD/bits",
+           "HD_std", "SAC_max", "SAC_mean", ">3sigma");
+
+    bool found = false;
+    for (const CipherSpec &cipher : CIPHERS) {
+        if (cipherName != "all" && cipherName != cipher.name) continue;
+        found = true;
+
+        unsigned threads = (unsigned)std::min<uint64_t>(opt.threads, opt.trials);
+        std::vector<std::vector<ClassResult>> partial(threads, std::vector<ClassResult>(INPUT_CLASSES));
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            uint64_t share = opt.trials / threads + (t < opt.trials % threads ? 1 : 0);
+            // Seed per thread diturunkan dengan konstanta golden ratio (splitmix64)
+            uint64_t seed = opt.seed + 0x9e3779b97f4a7c15ull * (t + 1);
+            workers.emplace_back(runWorker, std::cref(cipher), std::cref(opt), share, seed, std::ref(partial[t]));
+        }
+        for (std::thread &w : workers) w.join();
+
+        for (int c = 0; c < INPUT_CLASSES; c++) {
+            if (!opt.classes[c] || (c == INPUT_IV && cipher.ivBytes == 0)) continue;
+            ClassResult total;
+            for (auto &p : partial) merge(total, p[c]);
+            report(cipher, (InputClass)c, total, opt);
+        }
+    }
+    if (!found) {
+        fprintf(stderr, "Cipher tidak dikenal: %s\n", cipherName.c_str());
+        return 1;
+    }
+    return 0;
+}
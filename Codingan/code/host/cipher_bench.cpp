@@ -0,0 +1,101 @@
+// Benchmark kernel cipher di host (Linux) dengan WsnBench, API yang sama dengan sketch
+// code/cipher_bench di ESP8266/ESP32.
+//
+// Ukuran default dari 16 B sampai 1 MB, termasuk ukuran plaintextSets (5011 dan 10011 byte)
+// supaya hasilnya bisa dibandingkan langsung dengan grafik computationTime.py.
+//
+// Build : g++ -O2 -std=c++17 -I ../../libraries/WsnNode/src -o cipher_bench cipher_bench.cpp
+// Pakai : ./cipher_bench > bench_host.csv
+//         ./cipher_bench --json -c chacha20 -s 64,1024,1048576 -r 101
+//         ./cipher_bench -s 5011,10011 --power 15000   (uj_per_byte dengan daya paket CPU host)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "WsnBenchCiphers.h"
+#include "WsnPayload.h"
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+            "Penggunaan: %s [-c cipher] [-s ukuran,...] [-w warmup] [-r repeat] [--power mW] [--json] [-o file]\n"
+            "  -c NAMA  chacha20 | snowv | clefia256 | aes256cbc | chacha20poly1305 | aes256gcm |\n"
+            "           ascon128 | ascon128a | xchacha20 | all (default all)\n"
+            "  -s LIST  ukuran pesan dalam byte, dipisah koma\n"
+            "  -w N     jumlah warm-up (default 3)\n"
+            "  -r N     jumlah repeat pengukuran (default 31)\n"
+            "  --power MW  daya aktif untuk kolom uj_per_byte (default 230, ESP8266)\n"
+            "  --json   output JSON Lines (default CSV)\n"
+            "  -o FILE  tulis ke file (default stdout)\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> sizes = {16, 64, 256, 1024, 4096, 5011, 10011, 65536, 262144, 1048576};
+    std::string cipherName = "all";
+    WsnBenchConfig cfg;
+    bool json = false;
+    WsnStdout out;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](void) -> const char * {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "-c") cipherName = value();
+        else if (arg == "-w") cfg.warmup = (uint16_t)atoi(value());
+        else if (arg == "-r") cfg.repeats = (uint16_t)std::max(1, atoi(value()));
+        else if (arg == "--power") cfg.activePowerMw = (float)atof(value());
+        else if (arg == "--json") json = true;
+        else if (arg == "-o") {
+            out.file = fopen(value(), "w");
+            if (!out.file) {
+                perror("fopen");
+                return 1;
+            }
+        } else if (arg == "-s") {
+            sizes.clear();
+            for (char *p = (char *)value(); *p;) {
+                size_t n = strtoul(p, &p, 10);
+                if (n) sizes.push_back(n);
+                if (*p) p++;
+            }
+        } else {
+            printUsage(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    size_t maxSize = 0;
+    for (size_t n : sizes) maxSize = std::max(maxSize, n);
+    std::vector<uint8_t> buffer(maxSize + 16);
+    WsnDht22Payload sensorText(buffer.size());
+    wsnPayloadReadAll(sensorText, buffer.data(), buffer.size());
+    std::vector<double> samples(cfg.repeats);
+
+    if (!json) wsnBenchWriteCsvHeader(out);
+    bool found = false;
+    for (size_t c = 0; c < wsnBenchCipherCount; c++) {
+        const WsnBenchCipher &cipher = wsnBenchCiphers[c];
+        if (cipherName != "all" && cipherName != cipher.name) continue;
+        found = true;
+        for (size_t n : sizes) {
+            WsnBenchResult r = wsnBenchRun(cipher.name, cipher.kernel, nullptr, buffer.data(), n, cfg, samples.data());
+            if (json) wsnBenchWriteJson(out, r);
+            else wsnBenchWriteCsv(out, r);
+            fflush(out.file);
+        }
+    }
+    if (out.file != stdout) fclose(out.file);
+
+    if (!found) {
+        fprintf(stderr, "Cipher tidak dikenal: %s\n", cipherName.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Simulasi penjadwal daya WsnSleep.h di host (Linux): siklus sampel/kirim yang sama dengan
+// sender (SLEEP_SCHEDULER 1), dengan jam virtual. Deep sleep disimulasikan sebagai reboot:
+// semua objek dibuat ulang dan state batch/kebijakan laporan dimuat dari RTC memory tiruan,
+// sehingga jalur saveRtc/loadRtc ikut teruji.
+//
+// Waktu aktif per siklus dari model: --sample-ms tiap siklus, ditambah --send-ms saat batch
+// di-flush (enkripsi + kirim ESP-NOW). Hasil: residensi per mode, arus rata-rata dan
+// perkiraan umur baterai. Setiap pesan mengambil nonce dari WsnNonceManager; jumlah tulis flash
+// menunjukkan checkpoint nonce tidak bertambah karena deep sleep.
+//
+// Build : g++ -O2 -std=c++17 -I ../../libraries/WsnNode/src -o sleep_sim sleep_sim.cpp
+// Pakai : ./sleep_sim
+//         ./sleep_sim --period 10000 --deepest deep --cycles 8640 --battery 2500
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "WsnBatch.h"
+#include "WsnNonce.h"
+#include "WsnPayload.h"
+#include "WsnReportPolicy.h"
+#include "WsnSleep.h"
+
+WsnSleepScheduler *scheduler;
+WsnReportPolicy *reportPolicy;
+WsnBatch<WSN_BATCH_RTC_CAPACITY> *batch;
+WsnNonceManager *nonces;
+
+void saveState() {
+    batch->saveRtc(WSN_RTC_BATCH_OFFSET);
+    reportPolicy->saveRtc(WSN_RTC_POLICY_OFFSET);
+}
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+            "Penggunaan: %s [--period ms] [--deepest mode] [--sample-ms ms] [--send-ms ms] [--cycles N]\n"
+            "          [--policy] [--battery mAh]\n"
+            "  --period MS     periode siklus (default 2000)\n"
+            "  --deepest MODE  active | modem | light | deep (default light)\n"
+            "  --sample-ms MS  waktu aktif baca sensor per siklus (default 5)\n"
+            "  --send-ms MS    waktu aktif enkripsi + kirim per pesan (default 40)\n"
+            "  --cycles N      jumlah siklus (default 1800)\n"
+            "  --policy        pakai WsnReportPolicy sebelum batch\n"
+            "  --battery MAH   kapasitas baterai untuk perkiraan umur (default 2000)\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    WsnSleepConfig sleepConfig;
+    sleepConfig.onDeepSleep = saveState;
+    uint32_t sampleMs = 5;
+    uint32_t sendMs = 40;
+    uint32_t cycles = 1800;
+    bool usePolicy = false;
+    float batteryMah = 2000;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](void) -> const char * {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--period") sleepConfig.periodMs = (uint32_t)atol(value());
+        else if (arg == "--sample-ms") sampleMs = (uint32_t)atol(value());
+        else if (arg == "--send-ms") sendMs = (uint32_t)atol(value());
+        else if (arg == "--cycles") cycles = (uint32_t)atol(value());
+        else if (arg == "--policy") usePolicy = true;
+        else if (arg == "--battery") batteryMah = (float)atof(value());
+        else if (arg == "--deepest") {
+            std::string mode = value();
+            int s = 0;
+            while (s < WSN_POWER_STATE_COUNT && mode != wsnPowerStateName((WsnPowerState)s)) s++;
+            if (s == WSN_POWER_STATE_COUNT) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            sleepConfig.deepest = (WsnPowerState)s;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    WsnBatchConfig batchConfig;
+    batchConfig.binary = true;
+    WsnDht22Payload sensorStream(SIZE_MAX, 7, nullptr);
+    uint32_t messages = 0, restored = 0, flashWrites = 0;
+    uint8_t nonce[WSN_NONCE_SIZE];
+
+    scheduler = new WsnSleepScheduler(sleepConfig);
+    reportPolicy = new WsnReportPolicy();
+    batch = new WsnBatch<WSN_BATCH_RTC_CAPACITY>(batchConfig);
+    nonces = new WsnNonceManager();
+    scheduler->begin();
+    nonces->begin();
+
+    for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+        int16_t temperature, humidity;
+        wsnReportSample(sensorStream, temperature, humidity);
+        scheduler->addActiveMs(sampleMs);
+        uint32_t now = scheduler->nowMs();
+        if (!usePolicy || reportPolicy->evaluate(temperature, humidity, now) != WSN_REPORT_NONE) {
+            WsnBatchFlush flush = batch->add(temperature, humidity, now);
+            if (flush != WSN_BATCH_KEEP) {
+                size_t len;
+                free(batch->takeTextAlloc(flush, len));
+                nonces->next(nonce, sizeof(nonce));
+                scheduler->addActiveMs(sendMs);
+                messages++;
+            }
+        }
+
+        if (scheduler->sleep() == WSN_POWER_DEEP_SLEEP) {
+            // Reboot: RAM hilang, hanya RTC memory yang tersisa
+            size_t pending = batch->count();
+            uint64_t nextNonce = nonces->counter();
+            flashWrites += nonces->stats().flashWrites;
+            delete scheduler;
+            delete reportPolicy;
+            delete batch;
+            delete nonces;
+            scheduler = new WsnSleepScheduler(sleepConfig);
+            reportPolicy = new WsnReportPolicy();
+            batch = new WsnBatch<WSN_BATCH_RTC_CAPACITY>(batchConfig);
+            nonces = new WsnNonceManager();
+            nonces->begin();
+            if (!scheduler->begin() || !batch->loadRtc(WSN_RTC_BATCH_OFFSET) ||
+                !reportPolicy->loadRtc(WSN_RTC_POLICY_OFFSET) || batch->count() != pending ||
+                nonces->counter() != nextNonce) {
+                fprintf(stderr, "state RTC hilang setelah deep sleep (siklus %lu)\n", (unsigned long)cycle);
+                return 1;
+            }
+            restored++;
+        }
+    }
+
+    WsnStdout out;
+    const WsnRtcState &rtc = scheduler->rtc();
+    flashWrites += nonces->stats().flashWrites;
+    printf("periode %lu ms, %lu siklus, %lu pesan, %lu pemulihan dari RTC, waktu node %lu ms\n",
+           (unsigned long)sleepConfig.periodMs, (unsigned long)cycles, (unsigned long)messages,
+           (unsigned long)restored, (unsigned long)rtc.elapsedMs);
+    printf("nonce berikutnya %llu, tulis flash checkpoint %lu\n", (unsigned long long)nonces->counter(),
+           (unsigned long)flashWrites);
+    scheduler->printResidency(out);
+    float current = scheduler->averageCurrentMa();
+    if (current > 0) printf("baterai %.0f mAh: %.1f hari\n", batteryMah, batteryMah / current / 24);
+
+    delete scheduler;
+    delete reportPolicy;
+    delete batch;
+    delete nonces;
+    return 0;
+}
@@ -1,72 +1,250 @@
 #include <WiFi.h>
 #include <Wire.h>
-#include <Adafruit_INA219.h>
 #include <time.h>
 #include <sys/time.h>
 #include <SD.h>
 #include <SPI.h>
 
-#define SD_CS 5  // Pin CS untuk kartu SD
-#define BUFFER_SIZE 50  // Ukuran buffer
+#define SD_CS 5               // Pin CS untuk kartu SD
+#define SD_SPI_HZ 20000000    // Clock SPI kartu SD
+#define INA219_ADDR 0x40      // Alamat I2C INA219
+#define I2C_CLOCK_HZ 400000   // Fast-mode I2C (INA219 mendukung hingga 2.56 MHz)
+
+#define SAMPLE_INTERVAL_US 500  // Periode sampling (2 kHz)
+#define SECTOR_SIZE 512         // Ukuran satu sektor SD
+#define RING_SECTORS 16         // 16 x 512 B = 8 KB ring (~400 ms headroom)
+#define FLUSH_EVERY_SECTORS 32  // Flush FAT/direktori setiap 16 KB
+#define FLUSH_INTERVAL_MS 250   // ... atau paling lambat 250 ms setelah sektor terakhir ditulis
+
+// Berhenti logging: perintah serial 'x' atau STOP_PIN LOW (-1 = nonaktif). Sektor yang belum
+// penuh ditulis, lalu file di-flush dan ditutup; aman untuk mencabut daya setelah "selesai"
+#define STOP_PIN -1
+
+// Register INA219
+#define INA219_REG_CONFIG      0x00
+#define INA219_REG_BUSVOLTAGE  0x02
+#define INA219_REG_POWER       0x03
+#define INA219_REG_CURRENT     0x04
+#define INA219_REG_CALIBRATION 0x05
+
+// 32V range, gain /8 (320 mV), ADC bus & shunt 10-bit (148 us), continuous shunt+bus.
+// Dua konversi 148 us selesai dalam ~300 us, cukup untuk periode 500 us.
+const uint16_t INA219_CONFIG_VALUE = 0x2000 | 0x1800 | 0x0080 | 0x0008 | 0x0007;
+// Kalibrasi sama dengan Adafruit setCalibration_32V_2A(): current LSB 0.1 mA, power LSB 2 mW
+const uint16_t INA219_CAL_VALUE = 4096;
+const uint16_t CURRENT_LSB_UA = 100;
+const uint16_t POWER_LSB_MW = 2;
+const uint16_t SHUNT_MILLIOHM = 100;
 
 // Data Wi-Fi
 const char* ssid = "farras";
-const char* password = "123456789"; 
+const char* password = "123456789";
 
 // Deklarasi zona waktu (UTC +7 untuk Indonesia Barat)
 const long gmtOffset_sec = 7 * 3600;
 const int daylightOffset_sec = 0;
 
-// Nama file untuk data CSV
-const char* filename = "/sensor_data.csv";
+// Nama file untuk data biner (konversi ke CSV dengan ina_bin_to_csv.py)
+const char* filename = "/sensor_data.bin";
+
+// Satu sampel mentah dari register INA219 (10 byte)
+struct __attribute__((packed)) InaSample {
+  uint32_t timestamp_us;  // micros() saat sampel dibaca
+  int16_t current_raw;    // Register current, LSB = CURRENT_LSB_UA
+  uint16_t bus_raw;       // Register bus >> 3, LSB = 4 mV
+  uint16_t power_raw;     // Register power, LSB = POWER_LSB_MW
+};
+
+const size_t SAMPLES_PER_SECTOR = (SECTOR_SIZE - 4) / sizeof(InaSample);
+
+#define SECTOR_FLAG_OVERRUN 0x01  // Ada sampel yang hilang sebelum sektor ini
+
+// Satu sektor data, ditulis apa adanya ke SD
+struct __attribute__((packed)) DataSector {
+  uint16_t sequence;
+  uint8_t count;
+  uint8_t flags;
+  InaSample samples[SAMPLES_PER_SECTOR];
+  uint8_t reserved[SECTOR_SIZE - 4 - SAMPLES_PER_SECTOR * sizeof(InaSample)];
+};
 
-// Buffer untuk menyimpan data
-String dataBuffer[BUFFER_SIZE];
-int bufferIndex = 0;
+// Sektor pertama file: metadata untuk decoder
+struct __attribute__((packed)) FileHeader {
+  char magic[4];            // "INA1"
+  uint16_t version;
+  uint16_t sampleSize;
+  uint16_t samplesPerSector;
+  uint16_t currentLsb_uA;
+  uint16_t powerLsb_mW;
+  uint16_t shunt_mOhm;
+  uint32_t sampleInterval_us;
+  int64_t epoch_us;         // Waktu lokal (epoch, us) saat micros() == micros_ref
+  uint32_t micros_ref;
+  uint8_t reserved[SECTOR_SIZE - 32];
+};
 
-// Inisialisasi sensor INA219
-Adafruit_INA219 ina219;
+static_assert(sizeof(DataSector) == SECTOR_SIZE, "DataSector harus tepat 512 byte");
+static_assert(sizeof(FileHeader) == SECTOR_SIZE, "FileHeader harus tepat 512 byte");
+
+// Ring buffer sektor. Sampler (core 1) hanya menulis ring[head], writer (core 0)
+// hanya membaca ring[tail]; keduanya berkomunikasi lewat counter monoton.
+DataSector ring[RING_SECTORS];
+volatile uint32_t sectorsProduced = 0;
+volatile uint32_t sectorsWritten = 0;
+uint16_t sectorSequence = 0;
+bool sectorStarted = false;  // header ring[head] sudah diisi untuk sektor yang sedang diisi
+uint8_t pendingFlags = 0;
+uint32_t droppedSamples = 0;
+
+volatile bool stopRequested = false;  // sampler sudah berhenti, sektor terakhir sudah masuk ring
+volatile bool loggingStopped = false; // writer sudah menutup file
+
+File dataFile;
+TaskHandle_t writerTask = nullptr;
+uint32_t nextSampleTime = 0;
 
 // Fungsi untuk menginisialisasi waktu NTP
 void setupTime() {
   configTime(gmtOffset_sec, daylightOffset_sec, "pool.ntp.org", "time.nist.gov");
 }
 
-// Fungsi untuk mendapatkan timestamp dengan milidetik
-String getTimeWithMillis() {
-  struct timeval tv;
-  struct tm timeinfo;
-  
-  if (!getLocalTime(&timeinfo)) {
-    Serial.println("Gagal mendapatkan waktu");
-    return "00:00:00.000";
+void inaWriteRegister(uint8_t reg, uint16_t value) {
+  Wire.beginTransmission(INA219_ADDR);
+  Wire.write(reg);
+  Wire.write((uint8_t)(value >> 8));
+  Wire.write((uint8_t)value);
+  Wire.endTransmission();
+}
+
+uint16_t inaReadRegister(uint8_t reg) {
+  Wire.beginTransmission(INA219_ADDR);
+  Wire.write(reg);
+  Wire.endTransmission(false);
+  Wire.requestFrom((uint8_t)INA219_ADDR, (uint8_t)2);
+  uint16_t value = (uint16_t)Wire.read() << 8;
+  value |= Wire.read();
+  return value;
+}
+
+bool initINA219() {
+  Wire.begin();
+  Wire.setClock(I2C_CLOCK_HZ);
+
+  Wire.beginTransmission(INA219_ADDR);
+  if (Wire.endTransmission() != 0) {
+    return false;
   }
-  
+  inaWriteRegister(INA219_REG_CALIBRATION, INA219_CAL_VALUE);
+  inaWriteRegister(INA219_REG_CONFIG, INA219_CONFIG_VALUE);
+  return true;
+}
+
+// Tulis sektor metadata di awal file
+bool writeFileHeader() {
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, "INA1", 4);
+  header.version = 1;
+  header.sampleSize = sizeof(InaSample);
+  header.samplesPerSector = SAMPLES_PER_SECTOR;
+  header.currentLsb_uA = CURRENT_LSB_UA;
+  header.powerLsb_mW = POWER_LSB_MW;
+  header.shunt_mOhm = SHUNT_MILLIOHM;
+  header.sampleInterval_us = SAMPLE_INTERVAL_US;
+
+  struct timeval tv;
+  header.micros_ref = micros();
   gettimeofday(&tv, NULL);
-  
-  char timeStringBuff[50];
-  strftime(timeStringBuff, sizeof(timeStringBuff), "%H:%M:%S", &timeinfo);
-  
-  char millisStringBuff[60];
-  sprintf(millisStringBuff, "%s.%03d", timeStringBuff, (int)(tv.tv_usec / 1000));
-  
-  return String(millisStringBuff);
+  header.epoch_us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec + (int64_t)gmtOffset_sec * 1000000;
+
+  return dataFile.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
 }
 
-// Fungsi untuk menulis data dari buffer ke SD card
-void writeBufferToSD() {
-  File dataFile = SD.open(filename, FILE_APPEND);
-  if (dataFile) {
-    for (int i = 0; i < bufferIndex; i++) {
-      dataFile.println(dataBuffer[i]);
+// Task penulis SD: menulis sektor penuh dari ring tanpa mengganggu sampling.
+// Hanya task ini yang menyentuh dataFile setelah setup(), termasuk flush dan close saat berhenti
+void sdWriterTask(void* param) {
+  uint32_t sinceFlush = 0;
+  uint32_t lastFlush = millis();
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+    while (sectorsWritten != sectorsProduced) {
+      const DataSector& sector = ring[sectorsWritten % RING_SECTORS];
+      if (dataFile.write((const uint8_t*)&sector, SECTOR_SIZE) != SECTOR_SIZE) {
+        Serial.println("Error menulis sektor ke SD card!");
+      }
+      sectorsWritten = sectorsWritten + 1;
+      sinceFlush++;
+
+      if (sinceFlush >= FLUSH_EVERY_SECTORS) {
+        dataFile.flush();
+        sinceFlush = 0;
+        lastFlush = millis();
+      }
     }
-    dataFile.flush();
-    dataFile.close();
-    Serial.println("Data dari buffer ditulis ke SD card.");
-    bufferIndex = 0;  // Reset buffer index
-  } else {
-    Serial.println("Error menulis ke file CSV!");
+
+    // Batas waktu: data yang sudah ditulis masuk FAT/ukuran file walau laju sampel rendah
+    if (sinceFlush > 0 && millis() - lastFlush >= FLUSH_INTERVAL_MS) {
+      dataFile.flush();
+      sinceFlush = 0;
+      lastFlush = millis();
+    }
+
+    // stopRequested diset setelah sektor terakhir masuk ring, jadi ring sudah kosong di sini
+    if (stopRequested && sectorsWritten == sectorsProduced) {
+      dataFile.flush();
+      dataFile.close();
+      loggingStopped = true;
+      vTaskDelete(NULL);
+    }
+  }
+}
+
+// Baca satu sampel dan masukkan ke sektor aktif
+void captureSample() {
+  if (sectorsProduced - sectorsWritten >= RING_SECTORS) {
+    // Ring penuh (SD terlalu lambat): buang sampel, tandai di sektor berikutnya
+    droppedSamples++;
+    pendingFlags |= SECTOR_FLAG_OVERRUN;
+    return;
+  }
+
+  // Header diisi saat sampel pertama, setelah cek ring penuh: slot ini pasti sudah ditulis
+  // ke SD. Mengisi header tepat setelah sektor sebelumnya penuh bisa menimpa sektor yang
+  // sedang ditulis writer saat ring penuh
+  DataSector& sector = ring[sectorsProduced % RING_SECTORS];
+  if (!sectorStarted) {
+    sector.sequence = sectorSequence++;
+    sector.count = 0;
+    sector.flags = pendingFlags;
+    pendingFlags = 0;
+    sectorStarted = true;
+  }
+  InaSample& sample = sector.samples[sector.count];
+  sample.timestamp_us = micros();
+  sample.current_raw = (int16_t)inaReadRegister(INA219_REG_CURRENT);
+  sample.bus_raw = inaReadRegister(INA219_REG_BUSVOLTAGE) >> 3;
+  sample.power_raw = inaReadRegister(INA219_REG_POWER);
+
+  if (++sector.count == SAMPLES_PER_SECTOR) {
+    sectorStarted = false;
+    sectorsProduced = sectorsProduced + 1;
+    xTaskNotifyGive(writerTask);
+  }
+}
+
+// Sektor yang sedang diisi ditutup apa adanya (count = jumlah sampel, sisa nol) dan diantrekan
+void stopLogging() {
+  if (stopRequested) return;
+  if (sectorStarted) {
+    DataSector& sector = ring[sectorsProduced % RING_SECTORS];
+    memset(&sector.samples[sector.count], 0, (SAMPLES_PER_SECTOR - sector.count) * sizeof(InaSample));
+    sectorStarted = false;
+    sectorsProduced = sectorsProduced + 1;
   }
+  stopRequested = true;
+  xTaskNotifyGive(writerTask);
+  Serial.println("Berhenti logging, menunggu sektor terakhir ditulis...");
 }
 
 void setup() {
@@ -84,64 +262,90 @@ void setup() {
     Serial.print(".");
     retryCount++;
   }
-  
+
   if (WiFi.status() == WL_CONNECTED) {
     Serial.println(" Terhubung!");
     setupTime();
+    struct tm timeinfo;
+    getLocalTime(&timeinfo);
   } else {
     Serial.println(" Gagal terhubung ke WiFi.");
   }
 
+  // Wi-Fi tidak dipakai lagi setelah sinkronisasi waktu
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+
   // Inisialisasi SD card
-  if (!SD.begin(SD_CS)) {
+  if (!SD.begin(SD_CS, SPI, SD_SPI_HZ)) {
     Serial.println("Error menginisialisasi SD card!");
     return;
   }
 
   // Inisialisasi sensor INA219
-  if (!ina219.begin()) {
+  if (!initINA219()) {
     Serial.println("Gagal menemukan chip INA219!");
     while (1) { delay(10); }
   }
 
-  // Buat atau buka file CSV dan tulis header
-  File dataFile = SD.open(filename, FILE_WRITE);
-  if (dataFile) {
-    dataFile.println("Timestamp,Power (mW),Bus Voltage (V),Load Voltage (V),Current (mA)");
-    dataFile.close();
-    Serial.println("File CSV dibuat dengan header.");
-  } else {
-    Serial.println("Error membuat file CSV!");
+  // File tetap terbuka selama logging; tidak ada open/close per batch
+  dataFile = SD.open(filename, FILE_WRITE);
+  if (!dataFile || !writeFileHeader()) {
+    Serial.println("Error membuat file data!");
+    return;
   }
+  dataFile.flush();
+  Serial.println("File data biner dibuat dengan header.");
+
+#if STOP_PIN >= 0
+  pinMode(STOP_PIN, INPUT_PULLUP);
+#endif
+
+  // Writer di core 0, sampling tetap di loop() pada core 1
+  xTaskCreatePinnedToCore(sdWriterTask, "sdWriter", 4096, NULL, 1, &writerTask, 0);
+
+  nextSampleTime = micros();
 }
 
 void loop() {
-  // Baca nilai dari sensor INA219
-  float shuntvoltage = ina219.getShuntVoltage_mV();
-  float busvoltage = ina219.getBusVoltage_V();
-  float current_mA = ina219.getCurrent_mA();
-  float power_mW = ina219.getPower_mW();
-  float loadvoltage = busvoltage + (shuntvoltage / 1000);
-
-  // Dapatkan timestamp
-  String timestamp = getTimeWithMillis();
-
-  // Buat string data dalam format CSV
-  String dataEntry = timestamp + "," + 
-                    String(power_mW) + "," + 
-                    String(busvoltage) + "," + 
-                    String(loadvoltage) + "," + 
-                    String(current_mA);
-
-  // Simpan ke buffer
-  dataBuffer[bufferIndex] = dataEntry;
-  bufferIndex++;
-
-  // Jika buffer penuh, tulis ke SD card
-  if (bufferIndex >= BUFFER_SIZE) {
-    writeBufferToSD();
-  }
-
-  // Delay untuk jeda pembacaan data
-  delay(5);  // Simpan data setiap 10ms
-}
\ No newline at end of file
+  if (writerTask == nullptr) {
+    delay(1000);
+    return;
+  }
+
+  if (stopRequested) {
+    static bool reported = false;
+    if (loggingStopped && !reported) {
+      reported = true;
+      Serial.print("File ditutup, selesai. Sampel hilang: ");
+      Serial.println(droppedSamples);
+    }
+    delay(10);
+    return;
+  }
+
+  bool stop = Serial.available() && Serial.read() == 'x';
+#if STOP_PIN >= 0
+  stop = stop || digitalRead(STOP_PIN) == LOW;
+#endif
+  if (stop) {
+    stopLogging();
+    return;
+  }
+
+  // Jadwal absolut agar periode tidak bergeser
+  if ((int32_t)(micros() - nextSampleTime) >= 0) {
+    nextSampleTime += SAMPLE_INTERVAL_US;
+    captureSample();
+  }
+
+  // Laporan sampel yang hilang, dicetak jarang agar tidak mengganggu sampling
+  static uint32_t lastReport = 0;
+  static uint32_t reportedDrops = 0;
+  if (droppedSamples != reportedDrops && millis() - lastReport > 1000) {
+    lastReport = millis();
+    reportedDrops = droppedSamples;
+    Serial.print("Sampel hilang (ring penuh): ");
+    Serial.println(droppedSamples);
+  }
+}
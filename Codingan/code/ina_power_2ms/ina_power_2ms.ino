@@ -1,33 +1,268 @@
+#include <Wire.h>
 #include <Adafruit_INA219.h>
+#include <WsnFraming.h>
+
+// 1 = mode cepat: register mentah, micros(), batch biner ber-framing COBS
+//     (decode di host dengan ina_stream_decode.py)
+// 0 = mode lama: baris ASCII "millis,power" setiap 2 ms
+#define HIGH_RATE_MODE 0
 
 Adafruit_INA219 ina219;
 
+#if HIGH_RATE_MODE
+const unsigned long SERIAL_BAUD_RATE = 921600;
+const unsigned long TARGET_INTERVAL_US = 200;
+const uint32_t I2C_CLOCK_HZ = 1000000;
+#else
 const unsigned long SERIAL_BAUD_RATE = 115200;
-const unsigned long TARGET_INTERVAL_MS = 2; 
+#endif
+const unsigned long TARGET_INTERVAL_MS = 2;
 
 unsigned long lastMeasurementTime = 0;
 
+// Jendela energi: dibuka/ditutup oleh pin marker dari node yang diukur
+// (HIGH selama operasi) atau perintah serial 'S' (start) / 'E' (end).
+#define MARKER_PIN 4   // -1 untuk menonaktifkan pin marker
+
+// Integrasi trapezoid fixed point: daya dalam uW, waktu dalam us,
+// akumulator sum((p0 + p1) * dt) dalam satuan 0.5 pJ.
+struct EnergyWindow {
+  bool active;
+  bool hasPrev;
+  uint16_t index;
+  uint32_t startTime_us;
+  uint32_t prevTime_us;
+  uint32_t prevPower_uW;
+  uint32_t peakPower_uW;
+  uint32_t samples;
+  uint64_t trapezoidSum;
+};
+
+EnergyWindow window = {};
+bool lastMarkerState = false;
+
+#if HIGH_RATE_MODE
+#define INA219_ADDR 0x40
+#define INA219_REG_CONFIG     0x00
+#define INA219_REG_BUSVOLTAGE 0x02
+#define INA219_REG_POWER      0x03
+
+const uint32_t POWER_LSB_UW = 2000;  // Kalibrasi 32V_2A: power LSB 2 mW
+
+// 32V range, gain /8, ADC bus & shunt 9-bit (84 us), continuous shunt+bus
+// -> satu pasang konversi baru setiap ~170 us.
+const uint16_t INA219_FAST_CONFIG = 0x2000 | 0x1800 | 0x0000 | 0x0000 | 0x0007;
+
+#define FRAME_TYPE_SAMPLES 0x01
+#define FRAME_TYPE_WINDOW  0x02
+#define BATCH_SAMPLES 32
+
+// Sampel dalam batch: offset waktu dari baseTime plus register mentah.
+// power_raw LSB = 2 mW (kalibrasi 32V_2A dari ina219.begin()), bus_raw LSB = 4 mV.
+struct __attribute__((packed)) PackedSample {
+  uint16_t dt_us;
+  uint16_t power_raw;
+  uint16_t bus_raw;
+};
+
+struct __attribute__((packed)) SampleBatch {
+  uint8_t type;
+  uint8_t sequence;
+  uint8_t count;
+  uint32_t baseTime_us;
+  PackedSample samples[BATCH_SAMPLES];
+};
+
+// Ringkasan satu jendela energi; daya rata-rata = energi / durasi (dihitung di host)
+struct __attribute__((packed)) WindowReport {
+  uint8_t type;
+  uint16_t index;
+  uint32_t duration_us;
+  uint32_t samples;
+  uint64_t energy_nJ;
+  uint32_t peakPower_uW;
+};
+
+SampleBatch batch;
+uint8_t batchSequence = 0;
+uint32_t nextSampleTime = 0;
+
+// Frame: COBS(payload + CRC16) + 0x00 (WsnFraming.h)
+uint8_t frameBuffer[WSN_COBS_MAX(sizeof(SampleBatch) + 2) + 1];
+
+void sendFrame(const uint8_t *payload, size_t len) {
+  uint8_t raw[sizeof(SampleBatch) + 2];
+  size_t encodedLen = wsnFrameEncode(payload, len, raw, frameBuffer);
+  Serial.write(frameBuffer, encodedLen);
+}
+
+void inaWriteRegister(uint8_t reg, uint16_t value) {
+  Wire.beginTransmission(INA219_ADDR);
+  Wire.write(reg);
+  Wire.write((uint8_t)(value >> 8));
+  Wire.write((uint8_t)value);
+  Wire.endTransmission();
+}
+
+uint16_t inaReadRegister(uint8_t reg) {
+  Wire.beginTransmission(INA219_ADDR);
+  Wire.write(reg);
+  Wire.endTransmission(false);
+  Wire.requestFrom((uint8_t)INA219_ADDR, (uint8_t)2);
+  uint16_t value = (uint16_t)Wire.read() << 8;
+  value |= Wire.read();
+  return value;
+}
+
+void startBatch() {
+  batch.type = FRAME_TYPE_SAMPLES;
+  batch.sequence = batchSequence++;
+  batch.count = 0;
+}
+
+void captureSample(uint32_t now) {
+  if (batch.count == 0) {
+    batch.baseTime_us = now;
+  }
+  PackedSample &sample = batch.samples[batch.count++];
+  sample.dt_us = (uint16_t)(now - batch.baseTime_us);
+  sample.power_raw = inaReadRegister(INA219_REG_POWER);
+  sample.bus_raw = inaReadRegister(INA219_REG_BUSVOLTAGE) >> 3;
+  integrateSample(now, (uint32_t)sample.power_raw * POWER_LSB_UW);
+
+  if (batch.count == BATCH_SAMPLES) {
+    sendFrame((const uint8_t *)&batch, sizeof(batch));
+    startBatch();
+  }
+}
+#endif
+
+void startWindow(uint32_t now) {
+  window.active = true;
+  window.hasPrev = false;
+  window.startTime_us = now;
+  window.peakPower_uW = 0;
+  window.samples = 0;
+  window.trapezoidSum = 0;
+}
+
+void integrateSample(uint32_t now, uint32_t power_uW) {
+  if (!window.active) return;
+  if (window.hasPrev) {
+    uint32_t dt = now - window.prevTime_us;
+    window.trapezoidSum += (uint64_t)(window.prevPower_uW + power_uW) * dt;
+  }
+  window.prevTime_us = now;
+  window.prevPower_uW = power_uW;
+  window.hasPrev = true;
+  if (power_uW > window.peakPower_uW) window.peakPower_uW = power_uW;
+  window.samples++;
+}
+
+void stopWindow() {
+  if (!window.active) return;
+  window.active = false;
+
+  uint32_t duration_us = window.hasPrev ? window.prevTime_us - window.startTime_us : 0;
+
+#if HIGH_RATE_MODE
+  WindowReport report;
+  report.type = FRAME_TYPE_WINDOW;
+  report.index = window.index;
+  report.duration_us = duration_us;
+  report.samples = window.samples;
+  report.energy_nJ = window.trapezoidSum / 2000;  // 0.5 pJ -> nJ
+  report.peakPower_uW = window.peakPower_uW;
+  sendFrame((const uint8_t *)&report, sizeof(report));
+#else
+  double energy_J = (double)window.trapezoidSum * 0.5e-12;  // 0.5 pJ -> J
+  double mean_mW = duration_us > 0 ? energy_J / (duration_us * 1e-6) * 1000.0 : 0;
+
+  // Baris berawalan '#' agar bisa dilewati parser CSV (comment='#')
+  Serial.print(F("# window,"));
+  Serial.print(window.index);
+  Serial.print(',');
+  Serial.print(duration_us);
+  Serial.print(',');
+  Serial.print(window.samples);
+  Serial.print(',');
+  Serial.print(energy_J, 9);
+  Serial.print(',');
+  Serial.print(mean_mW, 4);
+  Serial.print(',');
+  Serial.print(window.peakPower_uW / 1000.0, 4);
+  Serial.print('\n');
+#endif
+  window.index++;
+}
+
+// Cek pin marker dan perintah serial; dipanggil sekali per sampel
+void updateWindowTriggers(uint32_t now) {
+#if MARKER_PIN >= 0
+  bool marker = digitalRead(MARKER_PIN) == HIGH;
+  if (marker != lastMarkerState) {
+    lastMarkerState = marker;
+    if (marker) startWindow(now); else stopWindow();
+  }
+#endif
+  while (Serial.available() > 0) {
+    char command = Serial.read();
+    if (command == 'S' || command == 's') {
+      startWindow(now);
+    } else if (command == 'E' || command == 'e') {
+      stopWindow();
+    }
+  }
+}
+
 void setup() {
+#if HIGH_RATE_MODE && defined(ESP32)
+  Serial.setTxBufferSize(4096);
+#endif
   Serial.begin(SERIAL_BAUD_RATE);
   while (!Serial) {
-    ; 
+    ;
   }
 
+#if MARKER_PIN >= 0
+  pinMode(MARKER_PIN, INPUT_PULLDOWN);
+#endif
+
   if (!ina219.begin()) {
     Serial.println(F("Failed to find INA219 chip"));
     while (1) { }
   }
+
+#if HIGH_RATE_MODE
+  // begin() sudah menulis kalibrasi 32V_2A; hanya konfigurasi ADC yang dipercepat
+  Wire.setClock(I2C_CLOCK_HZ);
+  inaWriteRegister(INA219_REG_CONFIG, INA219_FAST_CONFIG);
+  startBatch();
+  nextSampleTime = micros();
+#endif
 }
 
 void loop() {
+#if HIGH_RATE_MODE
+  uint32_t now = micros();
+  if ((int32_t)(now - nextSampleTime) >= 0) {
+    nextSampleTime += TARGET_INTERVAL_US;
+    updateWindowTriggers(now);
+    captureSample(now);
+  }
+#else
   unsigned long currentTime = millis();
   if (currentTime - lastMeasurementTime >= TARGET_INTERVAL_MS) {
     float power_mW = ina219.getPower_mW();
     float voltage_v = ina219.getBusVoltage_V();
+    uint32_t now = micros();
+    updateWindowTriggers(now);
+    integrateSample(now, power_mW > 0 ? (uint32_t)(power_mW * 1000.0f) : 0);
     Serial.print(currentTime);
     Serial.print(',');
-    Serial.print(power_mW, 4); 
+    Serial.print(power_mW, 4);
     Serial.print('\n');
     lastMeasurementTime = currentTime;
   }
-}
\ No newline at end of file
+#endif
+}
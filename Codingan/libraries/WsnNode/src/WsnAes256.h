@@ -0,0 +1,227 @@
+#ifndef WSN_AES256_H
+#define WSN_AES256_H
+
+// AES-256 (FIPS-197) mode CBC, kompatibel dengan AES256_Sender_Fix / AES256_Receiver_Fix.
+// Implementasi byte-oriented tanpa T-table supaya muat di RAM ESP8266; key schedule
+// dihitung sekali di Aes256Context dan bisa dipakai ulang untuk banyak pesan.
+
+#include "WsnPlatform.h"
+#include "WsnProfile.h"
+
+#define WSN_AES_BLOCK_SIZE 16
+
+static const uint8_t wsnAesSbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static const uint8_t wsnAesInvSbox[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+struct Aes256Context {
+    uint8_t roundKey[240];  // 15 round key x 16 byte
+};
+
+inline uint8_t aesXtime(uint8_t x) {
+    return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+inline void aes256SetKey(Aes256Context &ctx, const uint8_t key[32]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_KEY_SETUP);
+    static const uint8_t rcon[7] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40};
+    uint8_t *w = ctx.roundKey;
+    memcpy(w, key, 32);
+    for (int i = 8; i < 60; i++) {
+        uint8_t t[4];
+        memcpy(t, w + 4 * (i - 1), 4);
+        if (i % 8 == 0) {
+            uint8_t first = t[0];
+            t[0] = wsnAesSbox[t[1]] ^ rcon[i / 8 - 1];
+            t[1] = wsnAesSbox[t[2]];
+            t[2] = wsnAesSbox[t[3]];
+            t[3] = wsnAesSbox[first];
+        } else if (i % 8 == 4) {
+            for (int j = 0; j < 4; j++) t[j] = wsnAesSbox[t[j]];
+        }
+        for (int j = 0; j < 4; j++) {
+            w[4 * i + j] = w[4 * (i - 8) + j] ^ t[j];
+        }
+    }
+}
+
+inline void aesAddRoundKey(uint8_t s[16], const uint8_t *rk) {
+    for (int i = 0; i < 16; i++) s[i] ^= rk[i];
+}
+
+// SubBytes + ShiftRows (state kolom-mayor seperti di FIPS-197)
+inline void aesSubShift(uint8_t s[16]) {
+    uint8_t t[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            t[4 * c + r] = wsnAesSbox[s[4 * ((c + r) & 3) + r]];
+        }
+    }
+    memcpy(s, t, 16);
+}
+
+inline void aesInvSubShift(uint8_t s[16]) {
+    uint8_t t[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            t[4 * ((c + r) & 3) + r] = wsnAesInvSbox[s[4 * c + r]];
+        }
+    }
+    memcpy(s, t, 16);
+}
+
+inline void aesMixColumns(uint8_t s[16]) {
+    for (int c = 0; c < 4; c++) {
+        uint8_t *col = s + 4 * c;
+        uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+        uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+        col[0] ^= all ^ aesXtime(a0 ^ a1);
+        col[1] ^= all ^ aesXtime(a1 ^ a2);
+        col[2] ^= all ^ aesXtime(a2 ^ a3);
+        col[3] ^= all ^ aesXtime(a3 ^ a0);
+    }
+}
+
+// InvMixColumns = pra-proses {0e,0b,0d,09} -> {02,03,01,01} lalu MixColumns
+inline void aesInvMixColumns(uint8_t s[16]) {
+    for (int c = 0; c < 4; c++) {
+        uint8_t *col = s + 4 * c;
+        uint8_t u = aesXtime(aesXtime(col[0] ^ col[2]));
+        uint8_t v = aesXtime(aesXtime(col[1] ^ col[3]));
+        col[0] ^= u;
+        col[1] ^= v;
+        col[2] ^= u;
+        col[3] ^= v;
+    }
+    aesMixColumns(s);
+}
+
+inline void aes256EncryptBlock(const Aes256Context &ctx, const uint8_t in[16], uint8_t out[16]) {
+    uint8_t s[16];
+    memcpy(s, in, 16);
+    aesAddRoundKey(s, ctx.roundKey);
+    for (int round = 1; round < 14; round++) {
+        aesSubShift(s);
+        aesMixColumns(s);
+        aesAddRoundKey(s, ctx.roundKey + 16 * round);
+    }
+    aesSubShift(s);
+    aesAddRoundKey(s, ctx.roundKey + 16 * 14);
+    memcpy(out, s, 16);
+}
+
+inline void aes256DecryptBlock(const Aes256Context &ctx, const uint8_t in[16], uint8_t out[16]) {
+    uint8_t s[16];
+    memcpy(s, in, 16);
+    aesAddRoundKey(s, ctx.roundKey + 16 * 14);
+    for (int round = 13; round > 0; round--) {
+        aesInvSubShift(s);
+        aesAddRoundKey(s, ctx.roundKey + 16 * round);
+        aesInvMixColumns(s);
+    }
+    aesInvSubShift(s);
+    aesAddRoundKey(s, ctx.roundKey);
+    memcpy(out, s, 16);
+}
+
+// Panjang setelah padding. Sama seperti sketch: pesan yang sudah kelipatan 16
+// tidak diberi blok padding tambahan.
+inline size_t aes256PaddedLength(size_t len) {
+    return (len + WSN_AES_BLOCK_SIZE - 1) / WSN_AES_BLOCK_SIZE * WSN_AES_BLOCK_SIZE;
+}
+
+// PKCS7 Padding
+inline void aes256ApplyPadding(uint8_t *data, size_t len, size_t paddedLen) {
+    uint8_t padValue = (uint8_t)(paddedLen - len);
+    for (size_t i = len; i < paddedLen; ++i) {
+        data[i] = padValue;
+    }
+}
+
+inline size_t aes256RemovePadding(const uint8_t *data, size_t len) {
+    if (len == 0) return 0;
+    uint8_t padValue = data[len - 1];
+    if (padValue > WSN_AES_BLOCK_SIZE || padValue == 0 || padValue > len) return len; // Invalid padding
+    return len - padValue;
+}
+
+// CBC; len harus kelipatan 16, IV asli tidak diubah
+inline void aes256CbcEncrypt(const Aes256Context &ctx, const uint8_t *input, uint8_t *output, size_t len,
+                             const uint8_t iv[WSN_AES_BLOCK_SIZE]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+    uint8_t currentIv[WSN_AES_BLOCK_SIZE];
+    memcpy(currentIv, iv, WSN_AES_BLOCK_SIZE);
+    for (size_t i = 0; i < len; i += WSN_AES_BLOCK_SIZE) {
+        for (size_t j = 0; j < WSN_AES_BLOCK_SIZE; ++j) {
+            output[i + j] = input[i + j] ^ currentIv[j];
+        }
+        aes256EncryptBlock(ctx, output + i, output + i);
+        memcpy(currentIv, output + i, WSN_AES_BLOCK_SIZE);
+    }
+}
+
+inline void aes256CbcDecrypt(const Aes256Context &ctx, const uint8_t *input, uint8_t *output, size_t len,
+                             const uint8_t iv[WSN_AES_BLOCK_SIZE]) {
+    uint8_t currentIv[WSN_AES_BLOCK_SIZE];
+    WSN_PROFILE_SCOPE(WSN_PROF_DECRYPT);
+    uint8_t nextIv[WSN_AES_BLOCK_SIZE];
+    memcpy(currentIv, iv, WSN_AES_BLOCK_SIZE);
+    for (size_t i = 0; i < len; i += WSN_AES_BLOCK_SIZE) {
+        memcpy(nextIv, input + i, WSN_AES_BLOCK_SIZE);  // input boleh sama dengan output
+        aes256DecryptBlock(ctx, input + i, output + i);
+        for (size_t j = 0; j < WSN_AES_BLOCK_SIZE; ++j) {
+            output[i + j] ^= currentIv[j];
+        }
+        memcpy(currentIv, nextIv, WSN_AES_BLOCK_SIZE);
+    }
+}
+
+inline void aes256CbcEncrypt(const uint8_t *input, uint8_t *output, size_t len, const uint8_t key[32],
+                             const uint8_t iv[WSN_AES_BLOCK_SIZE]) {
+    Aes256Context ctx;
+    aes256SetKey(ctx, key);
+    aes256CbcEncrypt(ctx, input, output, len, iv);
+}
+
+inline void aes256CbcDecrypt(const uint8_t *input, uint8_t *output, size_t len, const uint8_t key[32],
+                             const uint8_t iv[WSN_AES_BLOCK_SIZE]) {
+    Aes256Context ctx;
+    aes256SetKey(ctx, key);
+    aes256CbcDecrypt(ctx, input, output, len, iv);
+}
+
+#endif // WSN_AES256_H
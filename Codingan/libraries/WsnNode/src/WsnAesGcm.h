@@ -0,0 +1,223 @@
+#ifndef WSN_AES_GCM_H
+#define WSN_AES_GCM_H
+
+// AES-256-GCM (NIST SP 800-38D) di samping mode CBC WsnAes256.h, untuk dibandingkan dengan
+// ChaCha20-Poly1305 (WsnChaChaPoly.h).
+//
+// aes256GcmSetKey dipanggil sekali per kunci: round key AES dan tabel GHASH disimpan di
+// Aes256GcmContext dan dipakai ulang untuk setiap pesan. Seal satu pass: blok CTR dienkripsi,
+// lalu ciphertext-nya langsung masuk GHASH. Open memverifikasi tag sebelum mendekripsi.
+// IV 96 bit saja (J0 = IV || 0^31 || 1), sama dengan nonce WsnNonce.h.
+//
+// GHASH:
+//   - node: tabel 4 bit Shoup (16 entri x 128 bit = 256 byte RAM), 32 lookup per blok
+//   - host x86-64: PCLMULQDQ (Intel, "Carry-Less Multiplication and Its Usage for Computing
+//     the GCM Mode"), dipilih saat jalan jika CPU mendukung; build tidak perlu -mpclmul
+
+#include "WsnAes256.h"
+
+#if !defined(ARDUINO) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WSN_GCM_CLMUL 1
+#include <immintrin.h>
+#else
+#define WSN_GCM_CLMUL 0
+#endif
+
+#define WSN_GCM_IV_SIZE 12
+#define WSN_GCM_TAG_SIZE 16
+
+struct Aes256GcmContext {
+    Aes256Context aes;
+    uint8_t h[16];       // H = AES_K(0^128)
+    uint64_t hh[16];     // tabel Shoup: kelipatan H untuk setiap nibble, bagian atas
+    uint64_t hl[16];     // bagian bawah
+    bool clmul;
+};
+
+#if WSN_GCM_CLMUL
+__attribute__((target("pclmul,ssse3"))) inline void gcmMultiplyClmul(const uint8_t h[16], uint8_t x[16]) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)x), reverse);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)h), reverse);
+
+    // Perkalian 128x128 -> 256 bit (Karatsuba tidak dipakai, 4 perkalian)
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Geser 1 bit ke kiri (representasi bit-reflected GCM)
+    __m128i carryLo = _mm_srli_epi32(lo, 31);
+    __m128i carryHi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    __m128i cross = _mm_srli_si128(carryLo, 12);
+    carryHi = _mm_slli_si128(carryHi, 4);
+    carryLo = _mm_slli_si128(carryLo, 4);
+    lo = _mm_or_si128(lo, carryLo);
+    hi = _mm_or_si128(_mm_or_si128(hi, carryHi), cross);
+
+    // Reduksi modulo x^128 + x^7 + x^2 + x + 1
+    __m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    __m128i t2 = _mm_srli_si128(t, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+    __m128i r = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    r = _mm_xor_si128(r, t2);
+    hi = _mm_xor_si128(hi, _mm_xor_si128(lo, r));
+
+    _mm_storeu_si128((__m128i *)x, _mm_shuffle_epi8(hi, reverse));
+}
+#endif
+
+inline void aes256GcmSetKey(Aes256GcmContext &ctx, const uint8_t key[32]) {
+    aes256SetKey(ctx.aes, key);
+    memset(ctx.h, 0, sizeof(ctx.h));
+    aes256EncryptBlock(ctx.aes, ctx.h, ctx.h);
+
+    // Tabel Shoup: entri 8, 4, 2, 1 = H, H*x, H*x^2, H*x^3; sisanya kombinasi XOR
+    uint64_t vh = wsnLoad64Be(ctx.h);
+    uint64_t vl = wsnLoad64Be(ctx.h + 8);
+    ctx.hh[0] = 0;
+    ctx.hl[0] = 0;
+    ctx.hh[8] = vh;
+    ctx.hl[8] = vl;
+    for (int i = 4; i > 0; i >>= 1) {
+        uint64_t reduce = (vl & 1) ? 0xE100000000000000ULL : 0;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ reduce;
+        ctx.hh[i] = vh;
+        ctx.hl[i] = vl;
+    }
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; j++) {
+            ctx.hh[i + j] = ctx.hh[i] ^ ctx.hh[j];
+            ctx.hl[i + j] = ctx.hl[i] ^ ctx.hl[j];
+        }
+    }
+
+#if WSN_GCM_CLMUL
+    ctx.clmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#else
+    ctx.clmul = false;
+#endif
+}
+
+// x = x * H di GF(2^128)
+inline void gcmMultiply(const Aes256GcmContext &ctx, uint8_t x[16]) {
+#if WSN_GCM_CLMUL
+    if (ctx.clmul) {
+        gcmMultiplyClmul(ctx.h, x);
+        return;
+    }
+#endif
+    // Reduksi untuk 4 bit yang tergeser keluar
+    static const uint16_t last4[16] = {
+        0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+        0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+    };
+    uint8_t nibble = x[15] & 0x0F;
+    uint64_t zh = ctx.hh[nibble];
+    uint64_t zl = ctx.hl[nibble];
+    for (int i = 15; i >= 0; i--) {
+        if (i != 15) {
+            nibble = x[i] & 0x0F;
+            uint8_t rem = (uint8_t)(zl & 0x0F);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)last4[rem] << 48);
+            zh ^= ctx.hh[nibble];
+            zl ^= ctx.hl[nibble];
+        }
+        nibble = x[i] >> 4;
+        uint8_t rem = (uint8_t)(zl & 0x0F);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)last4[rem] << 48);
+        zh ^= ctx.hh[nibble];
+        zl ^= ctx.hl[nibble];
+    }
+    wsnStore64Be(x, zh);
+    wsnStore64Be(x + 8, zl);
+}
+
+// GHASH data (blok terakhir dipadding nol)
+inline void gcmGhash(const Aes256GcmContext &ctx, uint8_t y[16], const uint8_t *data, size_t len) {
+    while (len) {
+        size_t n = len < 16 ? len : 16;
+        for (size_t j = 0; j < n; j++) y[j] ^= data[j];
+        gcmMultiply(ctx, y);
+        data += n;
+        len -= n;
+    }
+}
+
+// Counter 32 bit paling kanan, big-endian
+inline void gcmIncrement(uint8_t counter[16]) {
+    for (int i = 15; i >= 12; i--) {
+        if (++counter[i]) break;
+    }
+}
+
+inline void gcmStart(uint8_t j0[16], uint8_t y[16], const Aes256GcmContext &ctx, const uint8_t iv[WSN_GCM_IV_SIZE],
+                     const uint8_t *aad, size_t aadLen) {
+    memcpy(j0, iv, WSN_GCM_IV_SIZE);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+    memset(y, 0, 16);
+    gcmGhash(ctx, y, aad, aadLen);
+}
+
+// Blok panjang (bit, big-endian), lalu tag = E(J0) xor S
+inline void gcmFinish(const Aes256GcmContext &ctx, uint8_t y[16], const uint8_t j0[16], size_t aadLen, size_t len,
+                      uint8_t tag[WSN_GCM_TAG_SIZE]) {
+    uint8_t lengths[16];
+    wsnStore64Be(lengths, (uint64_t)aadLen * 8);
+    wsnStore64Be(lengths + 8, (uint64_t)len * 8);
+    gcmGhash(ctx, y, lengths, sizeof(lengths));
+    uint8_t mask[16];
+    aes256EncryptBlock(ctx.aes, j0, mask);
+    for (int i = 0; i < WSN_GCM_TAG_SIZE; i++) tag[i] = y[i] ^ mask[i];
+}
+
+// Enkripsi + tag dalam satu pass; input dan output boleh buffer yang sama
+inline void aes256GcmSeal(const Aes256GcmContext &ctx, const uint8_t iv[WSN_GCM_IV_SIZE], const uint8_t *aad,
+                          size_t aadLen, const uint8_t *input, uint8_t *output, size_t len,
+                          uint8_t tag[WSN_GCM_TAG_SIZE]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+    uint8_t j0[16], y[16], counter[16], keystream[16];
+    gcmStart(j0, y, ctx, iv, aad, aadLen);
+    memcpy(counter, j0, 16);
+    for (size_t i = 0; i < len; i += 16) {
+        size_t n = len - i < 16 ? len - i : 16;
+        gcmIncrement(counter);
+        aes256EncryptBlock(ctx.aes, counter, keystream);
+        for (size_t j = 0; j < n; j++) output[i + j] = input[i + j] ^ keystream[j];
+        gcmGhash(ctx, y, output + i, n);
+    }
+    gcmFinish(ctx, y, j0, aadLen, len, tag);
+}
+
+// Verifikasi lalu dekripsi; false jika tag salah, output tidak disentuh
+inline bool aes256GcmOpen(const Aes256GcmContext &ctx, const uint8_t iv[WSN_GCM_IV_SIZE], const uint8_t *aad,
+                          size_t aadLen, const uint8_t *input, uint8_t *output, size_t len,
+                          const uint8_t tag[WSN_GCM_TAG_SIZE]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_DECRYPT);
+    uint8_t j0[16], y[16], expected[WSN_GCM_TAG_SIZE];
+    gcmStart(j0, y, ctx, iv, aad, aadLen);
+    gcmGhash(ctx, y, input, len);
+    gcmFinish(ctx, y, j0, aadLen, len, expected);
+    if (!wsnTagEqual(expected, tag, sizeof(expected))) return false;
+
+    uint8_t counter[16], keystream[16];
+    memcpy(counter, j0, 16);
+    for (size_t i = 0; i < len; i += 16) {
+        size_t n = len - i < 16 ? len - i : 16;
+        gcmIncrement(counter);
+        aes256EncryptBlock(ctx.aes, counter, keystream);
+        for (size_t j = 0; j < n; j++) output[i + j] = input[i + j] ^ keystream[j];
+    }
+    return true;
+}
+
+#endif // WSN_AES_GCM_H
@@ -0,0 +1,293 @@
+#ifndef WSN_ASCON_H
+#define WSN_ASCON_H
+
+// ASCON-128 dan ASCON-128a (spesifikasi v1.2, pemenang NIST Lightweight Cryptography):
+// AEAD dengan key 128 bit, nonce 128 bit, tag 128 bit. State 320 bit = 5 word 64 bit.
+//
+//   ASCON-128  : rate 8 byte, 6 round per blok
+//   ASCON-128a : rate 16 byte, 8 round per blok (lebih cepat untuk pesan panjang)
+//
+// Representasi state:
+//   - node 32 bit (Xtensa): bit-interleaved, tiap word 64 bit dipecah jadi bit genap dan
+//     bit ganjil (2 x 32 bit), sehingga rotasi 64 bit menjadi dua rotasi 32 bit
+//   - host 64 bit: word 64 bit langsung
+// Konversi interleave hanya saat data masuk/keluar rate, bukan di dalam permutasi.
+//
+// Open mendekripsi sambil menyerap ciphertext (satu pass, tanpa pass verifikasi terpisah
+// yang menggandakan biaya permutasi); jika tag salah, output dinolkan sebelum kembali false,
+// jadi pemanggil tetap tidak pernah memakai plaintext palsu.
+
+#include "WsnPlatform.h"
+#include "WsnProfile.h"
+
+#if defined(WSN_ASCON_BI32)
+// dipaksa dari luar (mis. uji jalur 32 bit di host)
+#elif UINTPTR_MAX > 0xFFFFFFFFUL
+#define WSN_ASCON_BI32 0
+#else
+#define WSN_ASCON_BI32 1
+#endif
+
+#define WSN_ASCON_KEY_SIZE 16
+#define WSN_ASCON_NONCE_SIZE 16
+#define WSN_ASCON_TAG_SIZE 16
+
+enum WsnAsconVariant : uint8_t {
+    WSN_ASCON_128 = 0,
+    WSN_ASCON_128A
+};
+
+inline const char *wsnAsconVariantName(WsnAsconVariant variant) {
+    return variant == WSN_ASCON_128A ? "ascon128a" : "ascon128";
+}
+
+struct WsnAsconState {
+#if WSN_ASCON_BI32
+    uint32_t e[5];  // bit genap
+    uint32_t o[5];  // bit ganjil
+#else
+    uint64_t x[5];
+#endif
+};
+
+// S-box 5 bit bitsliced; sama untuk word 64 bit maupun tiap separuh interleaved
+template <typename T>
+inline void asconSbox(T &x0, T &x1, T &x2, T &x3, T &x4) {
+    x0 ^= x4; x4 ^= x3; x2 ^= x1;
+    T t0 = ~x0 & x1, t1 = ~x1 & x2, t2 = ~x2 & x3, t3 = ~x3 & x4, t4 = ~x4 & x0;
+    x0 ^= t1; x1 ^= t2; x2 ^= t3; x3 ^= t4; x4 ^= t0;
+    x1 ^= x0; x0 ^= x4; x3 ^= x2; x2 = ~x2;
+}
+
+#if WSN_ASCON_BI32
+inline uint32_t asconRotr32(uint32_t x, int s) {
+    return s ? wsnRotr32(x, s) : x;
+}
+
+// (re, ro) = ror64((e, o), n) dalam bentuk interleaved
+inline void asconRorPair(uint32_t &re, uint32_t &ro, uint32_t e, uint32_t o, int n) {
+    if (n & 1) {
+        re = asconRotr32(o, n / 2);
+        ro = asconRotr32(e, n / 2 + 1);
+    } else {
+        re = asconRotr32(e, n / 2);
+        ro = asconRotr32(o, n / 2);
+    }
+}
+
+// x ^= ror64(x, a) ^ ror64(x, b)
+inline void asconLinear(uint32_t &e, uint32_t &o, int a, int b) {
+    uint32_t ae, ao, be, bo;
+    asconRorPair(ae, ao, e, o, a);
+    asconRorPair(be, bo, e, o, b);
+    e ^= ae ^ be;
+    o ^= ao ^ bo;
+}
+
+// Bit genap x ke 16 bit bawah
+inline uint32_t asconCompress(uint32_t x) {
+    x &= 0x55555555;
+    x = (x | (x >> 1)) & 0x33333333;
+    x = (x | (x >> 2)) & 0x0F0F0F0F;
+    x = (x | (x >> 4)) & 0x00FF00FF;
+    return (x | (x >> 8)) & 0x0000FFFF;
+}
+
+inline uint32_t asconExpand(uint32_t x) {
+    x &= 0x0000FFFF;
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    return (x | (x << 1)) & 0x55555555;
+}
+
+inline uint64_t asconGetWord(const WsnAsconState &s, int i) {
+    uint32_t lo = asconExpand(s.e[i]) | asconExpand(s.o[i]) << 1;
+    uint32_t hi = asconExpand(s.e[i] >> 16) | asconExpand(s.o[i] >> 16) << 1;
+    return (uint64_t)hi << 32 | lo;
+}
+
+inline void asconXorWord(WsnAsconState &s, int i, uint64_t w) {
+    uint32_t lo = (uint32_t)w, hi = (uint32_t)(w >> 32);
+    s.e[i] ^= asconCompress(lo) | asconCompress(hi) << 16;
+    s.o[i] ^= asconCompress(lo >> 1) | asconCompress(hi >> 1) << 16;
+}
+
+inline void asconPermute(WsnAsconState &s, int rounds) {
+    // Konstanta round 0xF0, 0xE1, ..., 0x4B dipecah ke bit genap/ganjil
+    static const uint8_t rcEven[12] = {0xC, 0x9, 0xC, 0x9, 0x6, 0x3, 0x6, 0x3, 0xC, 0x9, 0xC, 0x9};
+    static const uint8_t rcOdd[12] = {0xC, 0xC, 0x9, 0x9, 0xC, 0xC, 0x9, 0x9, 0x6, 0x6, 0x3, 0x3};
+    for (int r = 12 - rounds; r < 12; r++) {
+        s.e[2] ^= rcEven[r];
+        s.o[2] ^= rcOdd[r];
+        asconSbox(s.e[0], s.e[1], s.e[2], s.e[3], s.e[4]);
+        asconSbox(s.o[0], s.o[1], s.o[2], s.o[3], s.o[4]);
+        asconLinear(s.e[0], s.o[0], 19, 28);
+        asconLinear(s.e[1], s.o[1], 61, 39);
+        asconLinear(s.e[2], s.o[2], 1, 6);
+        asconLinear(s.e[3], s.o[3], 10, 17);
+        asconLinear(s.e[4], s.o[4], 7, 41);
+    }
+}
+#else
+inline uint64_t asconRotr64(uint64_t x, int s) {
+    return (x >> s) | (x << (64 - s));
+}
+
+inline uint64_t asconGetWord(const WsnAsconState &s, int i) {
+    return s.x[i];
+}
+
+inline void asconXorWord(WsnAsconState &s, int i, uint64_t w) {
+    s.x[i] ^= w;
+}
+
+inline void asconPermute(WsnAsconState &s, int rounds) {
+    uint64_t *x = s.x;
+    for (int r = 12 - rounds; r < 12; r++) {
+        x[2] ^= (uint64_t)(((0xF - r) << 4) | r);
+        asconSbox(x[0], x[1], x[2], x[3], x[4]);
+        x[0] ^= asconRotr64(x[0], 19) ^ asconRotr64(x[0], 28);
+        x[1] ^= asconRotr64(x[1], 61) ^ asconRotr64(x[1], 39);
+        x[2] ^= asconRotr64(x[2], 1) ^ asconRotr64(x[2], 6);
+        x[3] ^= asconRotr64(x[3], 10) ^ asconRotr64(x[3], 17);
+        x[4] ^= asconRotr64(x[4], 7) ^ asconRotr64(x[4], 41);
+    }
+}
+#endif
+
+inline size_t asconRate(WsnAsconVariant variant) {
+    return variant == WSN_ASCON_128A ? 16 : 8;
+}
+
+inline int asconBlockRounds(WsnAsconVariant variant) {
+    return variant == WSN_ASCON_128A ? 8 : 6;
+}
+
+// block berisi rate byte (sudah dipadding)
+inline void asconXorBlock(WsnAsconState &s, size_t rate, const uint8_t *block) {
+    for (size_t w = 0; w < rate / 8; w++) asconXorWord(s, (int)w, wsnLoad64Be(block + 8 * w));
+}
+
+inline void asconExtractBlock(const WsnAsconState &s, size_t rate, uint8_t *block) {
+    for (size_t w = 0; w < rate / 8; w++) wsnStore64Be(block + 8 * w, asconGetWord(s, (int)w));
+}
+
+// Inisialisasi + associated data; hasil siap menerima pesan
+inline void asconStart(WsnAsconState &s, WsnAsconVariant variant, const uint8_t key[WSN_ASCON_KEY_SIZE],
+                       const uint8_t nonce[WSN_ASCON_NONCE_SIZE], const uint8_t *aad, size_t aadLen) {
+    const size_t rate = asconRate(variant);
+    const int rounds = asconBlockRounds(variant);
+    // IV = k || r || a || b (bit), lalu nol
+    uint64_t iv = variant == WSN_ASCON_128A ? 0x80800C0800000000ULL : 0x80400C0600000000ULL;
+    uint64_t k0 = wsnLoad64Be(key), k1 = wsnLoad64Be(key + 8);
+
+    memset(&s, 0, sizeof(s));
+    asconXorWord(s, 0, iv);
+    asconXorWord(s, 1, k0);
+    asconXorWord(s, 2, k1);
+    asconXorWord(s, 3, wsnLoad64Be(nonce));
+    asconXorWord(s, 4, wsnLoad64Be(nonce + 8));
+    asconPermute(s, 12);
+    asconXorWord(s, 3, k0);
+    asconXorWord(s, 4, k1);
+
+    if (aadLen) {
+        uint8_t block[16];
+        while (aadLen >= rate) {
+            asconXorBlock(s, rate, aad);
+            asconPermute(s, rounds);
+            aad += rate;
+            aadLen -= rate;
+        }
+        memset(block, 0, sizeof(block));
+        memcpy(block, aad, aadLen);
+        block[aadLen] = 0x80;
+        asconXorBlock(s, rate, block);
+        asconPermute(s, rounds);
+    }
+    asconXorWord(s, 4, 1);  // pemisah domain AD / pesan
+}
+
+inline void asconFinish(WsnAsconState &s, WsnAsconVariant variant, const uint8_t key[WSN_ASCON_KEY_SIZE],
+                        uint8_t tag[WSN_ASCON_TAG_SIZE]) {
+    int lane = (int)(asconRate(variant) / 8);
+    uint64_t k0 = wsnLoad64Be(key), k1 = wsnLoad64Be(key + 8);
+    asconXorWord(s, lane, k0);
+    asconXorWord(s, lane + 1, k1);
+    asconPermute(s, 12);
+    wsnStore64Be(tag, asconGetWord(s, 3) ^ k0);
+    wsnStore64Be(tag + 8, asconGetWord(s, 4) ^ k1);
+}
+
+// Enkripsi + tag dalam satu pass; input dan output boleh buffer yang sama
+inline void asconSeal(WsnAsconVariant variant, const uint8_t key[WSN_ASCON_KEY_SIZE],
+                      const uint8_t nonce[WSN_ASCON_NONCE_SIZE], const uint8_t *aad, size_t aadLen,
+                      const uint8_t *input, uint8_t *output, size_t len, uint8_t tag[WSN_ASCON_TAG_SIZE]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+    const size_t rate = asconRate(variant);
+    const int rounds = asconBlockRounds(variant);
+    WsnAsconState s;
+    asconStart(s, variant, key, nonce, aad, aadLen);
+
+    while (len >= rate) {
+        asconXorBlock(s, rate, input);
+        asconExtractBlock(s, rate, output);
+        asconPermute(s, rounds);
+        input += rate;
+        output += rate;
+        len -= rate;
+    }
+    // Blok terakhir (boleh kosong) dengan padding 0x80
+    uint8_t block[16];
+    memset(block, 0, sizeof(block));
+    if (len) memcpy(block, input, len);
+    block[len] = 0x80;
+    asconXorBlock(s, rate, block);
+    asconExtractBlock(s, rate, block);
+    if (len) memcpy(output, block, len);
+
+    asconFinish(s, variant, key, tag);
+}
+
+// Dekripsi + verifikasi; false jika tag salah (output sudah dinolkan)
+inline bool asconOpen(WsnAsconVariant variant, const uint8_t key[WSN_ASCON_KEY_SIZE],
+                      const uint8_t nonce[WSN_ASCON_NONCE_SIZE], const uint8_t *aad, size_t aadLen,
+                      const uint8_t *input, uint8_t *output, size_t len, const uint8_t tag[WSN_ASCON_TAG_SIZE]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_DECRYPT);
+    const size_t rate = asconRate(variant);
+    const int rounds = asconBlockRounds(variant);
+    uint8_t *start = output;
+    size_t total = len;
+    WsnAsconState s;
+    asconStart(s, variant, key, nonce, aad, aadLen);
+
+    // P = S_r xor C, lalu S_r xor P (= C): sama dengan menyerap plaintext seperti di Seal
+    uint8_t block[16];
+    while (len >= rate) {
+        asconExtractBlock(s, rate, block);
+        for (size_t j = 0; j < rate; j++) block[j] ^= input[j];
+        memcpy(output, block, rate);
+        asconXorBlock(s, rate, block);
+        asconPermute(s, rounds);
+        input += rate;
+        output += rate;
+        len -= rate;
+    }
+    asconExtractBlock(s, rate, block);
+    for (size_t j = 0; j < len; j++) block[j] ^= input[j];
+    if (len) memcpy(output, block, len);
+    memset(block + len, 0, sizeof(block) - len);
+    block[len] = 0x80;
+    asconXorBlock(s, rate, block);
+
+    uint8_t expected[WSN_ASCON_TAG_SIZE];
+    asconFinish(s, variant, key, expected);
+    if (!wsnTagEqual(expected, tag, sizeof(expected))) {
+        if (total) memset(start, 0, total);
+        return false;
+    }
+    return true;
+}
+
+#endif // WSN_ASCON_H
@@ -0,0 +1,237 @@
+#ifndef WSN_BATCH_H
+#define WSN_BATCH_H
+
+// Batch pembacaan sensor: banyak pembacaan bertimestamp dikumpulkan di RAM, lalu dikirim
+// dalam satu siklus bangun/enkripsi/kirim.
+//
+// Batch di-flush saat:
+//   - ukuran pesan hampir mencapai maxFrames frame ESP-NOW (WSN_BATCH_FULL), atau
+//   - pembacaan tertua sudah berumur maxAgeMs (WSN_BATCH_AGE).
+// Ukuran dihitung persis seperti yang akan dikirim: teks, atau pesan WsnSensorCodec jika
+// config.binary (SENSOR_CODEC 1 di sender).
+//
+// Hasil flush berupa teks biasa "Batch t0=<ms> dt=<ms>: TT.TT,HH.HH..." sehingga tahap
+// berikutnya (sensor codec, LZ, cipher) dan semua receiver tetap sama. Timestamp tiap
+// pembacaan disimpan di RAM; pesan membawa timestamp pertama dan rata-rata jarak sampel.
+//
+// Energi per pembacaan = (energi tetap per pesan + byte pesan * energi per byte) / jumlah
+// pembacaan; dibandingkan dengan satu pesan per pembacaan. Kedua konstanta dari sketch.
+//
+// Isi batch bisa disimpan ke RTC memory (saveRtc/loadRtc) agar bertahan selama deep sleep;
+// Capacity maksimal WSN_BATCH_RTC_CAPACITY.
+//
+// Di sketch sender (BATCH_MODE 1) satu pembacaan DHT22 per siklus masuk batch, menggantikan
+// PAYLOAD_SOURCE; dengan REPORT_POLICY 1 hanya pembacaan yang lolos kebijakan. Pesan hanya dibuat,
+// dienkripsi dan dikirim saat batch di-flush. messageEnergyUj sender = energi siklus 5011 byte
+// dari energy_analysis.py dikurangi 5011 byte x energi marginal cipher.
+
+#include "WsnPlatform.h"
+#include "WsnFraming.h"
+#include "WsnSensorCodec.h"
+
+#define WSN_BATCH_PREFIX_MAX 40  // "Batch t0=4294967295 dt=4294967295: " + cadangan
+#define WSN_BATCH_RTC_MAGIC 0x31425357UL  // "WSB1"
+#define WSN_BATCH_RTC_CAPACITY ((WSN_RTC_SIZE - WSN_RTC_BATCH_OFFSET - 8) / 8)
+
+// Kapasitas batch sender: 128 pembacaan di RAM, atau sebesar RTC memory jika harus bertahan
+// selama deep sleep
+#define WSN_BATCH_CAPACITY(deepSleep) ((deepSleep) ? WSN_BATCH_RTC_CAPACITY : 128)
+
+struct WsnBatchEntry {
+    uint32_t ms;
+    WsnSensorReading reading;
+};
+
+struct WsnBatchConfig {
+    uint16_t maxFrames = 1;
+    uint16_t frameBytes = 250;    // payload ESP-NOW per frame
+    uint16_t reserveBytes = 16;   // nonce/padding/header cipher per pesan
+    uint32_t maxAgeMs = 60000;
+    bool binary = false;
+    uint8_t keyframeInterval = 32;
+    float messageEnergyUj = 0;    // energi tetap per pesan
+    float byteEnergyUj = 0;       // energi marginal per byte
+};
+
+enum WsnBatchFlush : uint8_t {
+    WSN_BATCH_KEEP = 0,
+    WSN_BATCH_FULL,
+    WSN_BATCH_AGE
+};
+
+struct WsnBatchStats {
+    uint32_t readings;
+    uint32_t flushes;
+    uint32_t flushBySize;
+    uint32_t flushByAge;
+    uint32_t bytes;
+    uint16_t lastCount;
+    uint16_t lastBytes;
+    float lastEnergyPerReadingUj;
+    float unbatchedEnergyPerReadingUj;
+};
+
+inline size_t wsnVarintSize(uint32_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+template <size_t Capacity>
+class WsnBatch {
+public:
+    explicit WsnBatch(const WsnBatchConfig &config = WsnBatchConfig()) : config(config) {
+        memset(&counters, 0, sizeof(counters));
+        clear();
+    }
+
+    void clear() {
+        n = 0;
+        recordBytes = 0;
+        textBytes = 0;
+    }
+
+    // Menambah satu pembacaan (perseratus); mengembalikan alasan flush, KEEP jika belum perlu.
+    // Jika batch sudah penuh pembacaan tidak disimpan; flush dulu lalu tambahkan lagi.
+    WsnBatchFlush add(int16_t temperature, int16_t humidity, uint32_t nowMs) {
+        if (n == Capacity) return WSN_BATCH_FULL;
+        WsnSensorReading r = {temperature, humidity};
+        recordBytes += encodedRecordSize(r);
+        char value[8];
+        textBytes += wsnSensorFormatValue(value, temperature) + 1 + wsnSensorFormatValue(value, humidity);
+        entries[n].ms = nowMs;
+        entries[n].reading = r;
+        n++;
+        counters.readings++;
+        return due(nowMs);
+    }
+
+    WsnBatchFlush due(uint32_t nowMs) const {
+        if (!n) return WSN_BATCH_KEEP;
+        // Sisakan ruang untuk satu rekaman terburuk berikutnya
+        size_t worstRecord = config.binary ? 6 : 13;
+        if (n == Capacity || messageBytes() + worstRecord > budget()) return WSN_BATCH_FULL;
+        if (nowMs - entries[0].ms >= config.maxAgeMs) return WSN_BATCH_AGE;
+        return WSN_BATCH_KEEP;
+    }
+
+    size_t count() const { return n; }
+    const WsnBatchEntry &entry(size_t i) const { return entries[i]; }
+
+    // Perkiraan atas ukuran pesan yang akan dikirim (sebelum cipher)
+    size_t messageBytes() const {
+        if (config.binary) return 4 + 5 + 1 + WSN_BATCH_PREFIX_MAX + recordBytes + 1;
+        return WSN_BATCH_PREFIX_MAX + textBytes;
+    }
+
+    // Menulis batch sebagai teks ke out (cap termasuk '\0'), mengosongkan batch dan
+    // memperbarui statistik. Mengembalikan panjang teks, 0 jika batch kosong atau tidak muat.
+    size_t takeText(char *out, size_t cap, WsnBatchFlush reason) {
+        if (!n || cap < textLength() + 1) return 0;
+        uint32_t interval = n > 1 ? (entries[n - 1].ms - entries[0].ms) / (uint32_t)(n - 1) : 0;
+        size_t len = (size_t)sprintf(out, "Batch t0=%lu dt=%lu: ", (unsigned long)entries[0].ms,
+                                     (unsigned long)interval);
+        for (size_t i = 0; i < n; i++) {
+            len += wsnSensorFormatValue(out + len, entries[i].reading.temperature100);
+            out[len++] = ',';
+            len += wsnSensorFormatValue(out + len, entries[i].reading.humidity100);
+        }
+        out[len] = '\0';
+        account(reason, len);
+        clear();
+        return len;
+    }
+
+    // Seperti takeText, ke buffer heap baru (pemanggil wajib free()); nullptr jika kosong/heap habis
+    char *takeTextAlloc(WsnBatchFlush reason, size_t &len) {
+        size_t cap = textLength() + 1;
+        char *text = n ? (char *)malloc(cap) : nullptr;
+        if (text == nullptr) return nullptr;
+        len = takeText(text, cap, reason);
+        return text;
+    }
+
+    const WsnBatchStats &stats() const { return counters; }
+
+    // offset dalam byte dari awal RTC memory (lihat wsnRtcWrite)
+    bool saveRtc(uint32_t offset) const {
+        Snapshot snapshot;
+        snapshot.magic = WSN_BATCH_RTC_MAGIC;
+        snapshot.count = (uint16_t)n;
+        memcpy(snapshot.entries, entries, sizeof(entries));
+        snapshot.crc = wsnCrc16((const uint8_t *)snapshot.entries, n * sizeof(WsnBatchEntry));
+        return wsnRtcWrite(offset, &snapshot, sizeof(snapshot));
+    }
+
+    // false jika RTC kosong/rusak (mis. setelah power on); batch lalu dikosongkan
+    bool loadRtc(uint32_t offset) {
+        Snapshot snapshot;
+        clear();
+        if (!wsnRtcRead(offset, &snapshot, sizeof(snapshot))) return false;
+        if (snapshot.magic != WSN_BATCH_RTC_MAGIC || snapshot.count > Capacity ||
+            snapshot.crc != wsnCrc16((const uint8_t *)snapshot.entries, snapshot.count * sizeof(WsnBatchEntry))) {
+            return false;
+        }
+        // Ditambahkan ulang agar ukuran pesan dihitung lagi; statistik tidak ikut disimpan
+        for (size_t i = 0; i < snapshot.count; i++) {
+            const WsnBatchEntry &e = snapshot.entries[i];
+            add(e.reading.temperature100, e.reading.humidity100, e.ms);
+        }
+        counters.readings -= snapshot.count;
+        return true;
+    }
+
+private:
+    struct Snapshot {
+        uint32_t magic;
+        uint16_t count;
+        uint16_t crc;
+        WsnBatchEntry entries[Capacity];
+    };
+    static_assert(sizeof(Snapshot) % 4 == 0, "RTC memory ditulis per word");
+
+    size_t budget() const {
+        size_t total = (size_t)config.maxFrames * config.frameBytes;
+        return total > config.reserveBytes ? total - config.reserveBytes : 0;
+    }
+
+    size_t textLength() const { return WSN_BATCH_PREFIX_MAX + textBytes; }
+
+    // Ukuran rekaman ke-n persis seperti WsnSensorEncoder::add
+    size_t encodedRecordSize(const WsnSensorReading &r) const {
+        uint8_t interval = config.keyframeInterval ? config.keyframeInterval : 1;
+        if (n % interval == 0) return wsnVarintSize(wsnZigzag(r.temperature100)) + wsnVarintSize((uint16_t)r.humidity100);
+        const WsnSensorReading &last = entries[n - 1].reading;
+        uint32_t dt = wsnZigzag(r.temperature100 - last.temperature100);
+        uint32_t dh = wsnZigzag(r.humidity100 - last.humidity100);
+        return wsnVarintSize(dh << 2 | (dt < 3 ? dt : 3)) + (dt < 3 ? 0 : wsnVarintSize(dt - 3));
+    }
+
+    void account(WsnBatchFlush reason, size_t textLen) {
+        size_t bytes = (config.binary ? messageBytes() - WSN_BATCH_PREFIX_MAX + (textLen - textBytes) : textLen) +
+                       config.reserveBytes;
+        counters.flushes++;
+        if (reason == WSN_BATCH_AGE) counters.flushByAge++;
+        else counters.flushBySize++;
+        counters.bytes += (uint32_t)bytes;
+        counters.lastCount = (uint16_t)n;
+        counters.lastBytes = (uint16_t)bytes;
+        counters.lastEnergyPerReadingUj = (config.messageEnergyUj + bytes * config.byteEnergyUj) / n;
+        // Satu pesan per pembacaan: overhead pesan yang sama, satu rekaman
+        float single = (float)(bytes - (config.binary ? recordBytes : textBytes)) +
+                       (float)(config.binary ? recordBytes : textBytes) / n;
+        counters.unbatchedEnergyPerReadingUj = config.messageEnergyUj + single * config.byteEnergyUj;
+    }
+
+    WsnBatchConfig config;
+    WsnBatchStats counters;
+    WsnBatchEntry entries[Capacity];
+    size_t n;
+    size_t recordBytes;  // rekaman sebagai WsnSensorCodec
+    size_t textBytes;    // rekaman sebagai teks
+};
+
+#endif // WSN_BATCH_H
@@ -0,0 +1,112 @@
+#ifndef WSN_BENCH_H
+#define WSN_BENCH_H
+
+// Micro-benchmark kernel cipher dengan API yang sama di host dan di node.
+//
+// Tiap pengukuran: warm-up, kalibrasi jumlah iterasi supaya satu repeat cukup panjang
+// dibanding resolusi counter, lalu `repeats` kali pengukuran siklus. Hasilnya median,
+// p99 dan minimum siklus per panggilan, cycles/byte, waktu, MB/s dan energi per byte
+// (median waktu x daya aktif CPU; tanpa radio, sama dengan energi marginal per byte).
+//
+// Output ditulis ke objek apa saja yang punya print(const char *): Serial di sketch,
+// WsnStdout di host. Formatnya CSV (satu baris per ukuran) atau JSON Lines.
+
+#include <algorithm>
+
+#include "WsnPlatform.h"
+
+typedef void (*WsnBenchKernel)(void *ctx, uint8_t *buf, size_t len);
+
+struct WsnBenchConfig {
+    uint16_t warmup = 3;
+    uint16_t repeats = 31;
+    uint32_t minCycles = 20000;  // durasi minimum satu repeat
+    float activePowerMw = 230.0f; // ESP8266 aktif ~70 mA @ 3.3 V
+};
+
+struct WsnBenchResult {
+    const char *name;
+    size_t bytes;
+    uint16_t repeats;
+    uint32_t iterations;
+    double medianCycles;
+    double p99Cycles;
+    double minCycles;
+    double cyclesPerByte;
+    double medianUs;
+    double p99Us;
+    double mbPerSec;
+    double ujPerByte;
+};
+
+// samples: buffer milik pemanggil, minimal cfg.repeats elemen
+inline WsnBenchResult wsnBenchRun(const char *name, WsnBenchKernel kernel, void *ctx, uint8_t *buf, size_t len,
+                                  const WsnBenchConfig &cfg, double *samples) {
+    for (uint16_t i = 0; i < cfg.warmup; i++) {
+        kernel(ctx, buf, len);
+    }
+
+    wsn_cycles_t start = wsnCycleCount();
+    kernel(ctx, buf, len);
+    wsn_cycles_t once = wsnCycleCount() - start;
+    uint32_t iterations = once >= cfg.minCycles ? 1 : (uint32_t)(cfg.minCycles / (once ? once : 1));
+
+    for (uint16_t r = 0; r < cfg.repeats; r++) {
+        start = wsnCycleCount();
+        for (uint32_t i = 0; i < iterations; i++) {
+            kernel(ctx, buf, len);
+        }
+        wsn_cycles_t elapsed = wsnCycleCount() - start;
+        samples[r] = (double)elapsed / iterations;
+        wsnYield();
+    }
+    std::sort(samples, samples + cfg.repeats);
+
+    WsnBenchResult result;
+    double mhz = wsnCpuMhz();
+    size_t p99 = (cfg.repeats * 99 + 99) / 100;  // ceil(0.99 n), indeks 1-based
+    result.name = name;
+    result.bytes = len;
+    result.repeats = cfg.repeats;
+    result.iterations = iterations;
+    result.medianCycles = cfg.repeats % 2 ? samples[cfg.repeats / 2]
+                                          : (samples[cfg.repeats / 2 - 1] + samples[cfg.repeats / 2]) / 2;
+    result.p99Cycles = samples[std::min<size_t>(p99, cfg.repeats) - 1];
+    result.minCycles = samples[0];
+    result.cyclesPerByte = result.medianCycles / len;
+    result.medianUs = result.medianCycles / mhz;
+    result.p99Us = result.p99Cycles / mhz;
+    result.mbPerSec = len / result.medianUs;  // byte per mikrodetik = MB/s
+    result.ujPerByte = result.medianUs * cfg.activePowerMw / 1000 / len;  // us x mW = nJ
+    return result;
+}
+
+template <typename Out>
+void wsnBenchWriteCsvHeader(Out &out) {
+    out.print("platform,cpu_mhz,cipher,bytes,repeats,iterations,median_cycles,p99_cycles,min_cycles,"
+              "cycles_per_byte,median_us,p99_us,mb_per_s,uj_per_byte\n");
+}
+
+template <typename Out>
+void wsnBenchWriteCsv(Out &out, const WsnBenchResult &r) {
+    char line[208];
+    snprintf(line, sizeof(line), "%s,%u,%s,%u,%u,%u,%.1f,%.1f,%.1f,%.3f,%.3f,%.3f,%.3f,%.5f\n", wsnPlatformName(),
+             (unsigned)wsnCpuMhz(), r.name, (unsigned)r.bytes, r.repeats, (unsigned)r.iterations, r.medianCycles,
+             r.p99Cycles, r.minCycles, r.cyclesPerByte, r.medianUs, r.p99Us, r.mbPerSec, r.ujPerByte);
+    out.print(line);
+}
+
+template <typename Out>
+void wsnBenchWriteJson(Out &out, const WsnBenchResult &r) {
+    char line[352];
+    snprintf(line, sizeof(line),
+             "{\"platform\":\"%s\",\"cpu_mhz\":%u,\"cipher\":\"%s\",\"bytes\":%u,\"repeats\":%u,"
+             "\"iterations\":%u,\"median_cycles\":%.1f,\"p99_cycles\":%.1f,\"min_cycles\":%.1f,"
+             "\"cycles_per_byte\":%.3f,\"median_us\":%.3f,\"p99_us\":%.3f,\"mb_per_s\":%.3f,\"uj_per_byte\":%.5f}\n",
+             wsnPlatformName(), (unsigned)wsnCpuMhz(), r.name, (unsigned)r.bytes, r.repeats, (unsigned)r.iterations,
+             r.medianCycles, r.p99Cycles, r.minCycles, r.cyclesPerByte, r.medianUs, r.p99Us, r.mbPerSec,
+             r.ujPerByte);
+    out.print(line);
+}
+
+#endif // WSN_BENCH_H
@@ -0,0 +1,109 @@
+#ifndef WSN_BENCH_CIPHERS_H
+#define WSN_BENCH_CIPHERS_H
+
+// Kernel benchmark untuk keempat cipher, meniru pekerjaan sender per pesan:
+// key setup + enkripsi seluruh payload in-place (termasuk padding untuk AES/CLEFIA).
+// Varian AEAD menulis tag 16 byte setelah pesan. Buffer harus punya ruang len + 16 byte.
+
+#include "WsnAes256.h"
+#include "WsnAesGcm.h"
+#include "WsnAscon.h"
+#include "WsnBench.h"
+#include "WsnChaCha20.h"
+#include "WsnChaChaPoly.h"
+#include "WsnClefia256.h"
+#include "WsnSnowV.h"
+#include "WsnXChaCha20.h"
+
+static const uint8_t wsnBenchKey[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+static const uint8_t wsnBenchIv[16] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10
+};
+
+inline void wsnBenchChaCha20(void *, uint8_t *buf, size_t len) {
+    chacha20EncryptDecrypt(buf, buf, len, wsnBenchKey, wsnBenchIv, 1);
+}
+
+// Seal satu pass; tag 16 byte ditulis di ruang padding setelah pesan
+inline void wsnBenchChaCha20Poly1305(void *, uint8_t *buf, size_t len) {
+    chacha20Poly1305Seal(wsnBenchKey, wsnBenchIv, nullptr, 0, buf, buf, len, buf + len);
+}
+
+// Nonce 24 byte dengan prefix tetap: subkey HChaCha20 dari cache setelah panggilan pertama,
+// seperti pesan-pesan dalam satu sesi WsnSessionNonce
+inline void wsnBenchXChaCha20(void *, uint8_t *buf, size_t len) {
+    static XChaCha20Context ctx;
+    static bool ready = false;
+    static uint8_t nonce[WSN_XCHACHA_NONCE_SIZE];
+    if (!ready) {
+        xchacha20SetKey(ctx, wsnBenchKey);
+        memcpy(nonce, wsnBenchIv, 16);
+        ready = true;
+    }
+    xchacha20EncryptDecrypt(ctx, buf, buf, len, nonce, 1);
+}
+
+inline void wsnBenchSnowV(void *, uint8_t *buf, size_t len) {
+    snowVEncryptDecrypt(buf, buf, len, wsnBenchKey, wsnBenchIv);
+}
+
+inline void wsnBenchAes256Cbc(void *, uint8_t *buf, size_t len) {
+    size_t paddedLen = aes256PaddedLength(len);
+    aes256ApplyPadding(buf, len, paddedLen);
+    aes256CbcEncrypt(buf, buf, paddedLen, wsnBenchKey, wsnBenchIv);
+}
+
+// Key schedule + tabel GHASH sekali per kunci (seperti sender yang menyimpan konteks),
+// tidak dihitung per pesan
+inline void wsnBenchAes256Gcm(void *, uint8_t *buf, size_t len) {
+    static Aes256GcmContext ctx;
+    static bool ready = false;
+    if (!ready) {
+        aes256GcmSetKey(ctx, wsnBenchKey);
+        ready = true;
+    }
+    aes256GcmSeal(ctx, wsnBenchIv, nullptr, 0, buf, buf, len, buf + len);
+}
+
+// Key 128 bit = 16 byte pertama wsnBenchKey, nonce = wsnBenchIv
+inline void wsnBenchAscon128(void *, uint8_t *buf, size_t len) {
+    asconSeal(WSN_ASCON_128, wsnBenchKey, wsnBenchIv, nullptr, 0, buf, buf, len, buf + len);
+}
+
+inline void wsnBenchAscon128a(void *, uint8_t *buf, size_t len) {
+    asconSeal(WSN_ASCON_128A, wsnBenchKey, wsnBenchIv, nullptr, 0, buf, buf, len, buf + len);
+}
+
+inline void wsnBenchClefia256(void *, uint8_t *buf, size_t len) {
+    size_t paddedLen = (len + WSN_CLEFIA_BLOCK_SIZE - 1) / WSN_CLEFIA_BLOCK_SIZE * WSN_CLEFIA_BLOCK_SIZE;
+    memset(buf + len, 0, paddedLen - len);
+    Clefia256Context ctx;
+    clefia256SetKey(ctx, wsnBenchKey);
+    clefia256EcbEncrypt(ctx, buf, buf, paddedLen);
+}
+
+struct WsnBenchCipher {
+    const char *name;
+    WsnBenchKernel kernel;
+};
+
+// Empat pertama urutannya sama dengan grafik computationTime.py; varian AEAD di belakang
+static const WsnBenchCipher wsnBenchCiphers[] = {
+    {"chacha20", wsnBenchChaCha20},
+    {"snowv", wsnBenchSnowV},
+    {"clefia256", wsnBenchClefia256},
+    {"aes256cbc", wsnBenchAes256Cbc},
+    {"chacha20poly1305", wsnBenchChaCha20Poly1305},
+    {"aes256gcm", wsnBenchAes256Gcm},
+    {"ascon128", wsnBenchAscon128},
+    {"ascon128a", wsnBenchAscon128a},
+    {"xchacha20", wsnBenchXChaCha20},
+};
+
+static const size_t wsnBenchCipherCount = sizeof(wsnBenchCiphers) / sizeof(wsnBenchCiphers[0]);
+
+#endif // WSN_BENCH_CIPHERS_H
@@ -0,0 +1,80 @@
+#ifndef WSN_CHACHA20_H
+#define WSN_CHACHA20_H
+
+// ChaCha20 (RFC 7539), kompatibel dengan chacha_sender / chacha_receiver:
+// key 256 bit, nonce 96 bit, counter blok 32 bit.
+
+#include "WsnPlatform.h"
+#include "WsnProfile.h"
+
+// Quarter round (penjumlahan, xor, rotasi)
+inline void chacha20QuarterRound(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
+    a += b; d ^= a; d = wsnRotl32(d, 16);
+    c += d; b ^= c; b = wsnRotl32(b, 12);
+    a += b; d ^= a; d = wsnRotl32(d, 8);
+    c += d; b ^= c; b = wsnRotl32(b, 7);
+}
+
+// 20 round tanpa penjumlahan state awal (dipakai juga oleh HChaCha20)
+inline void chacha20Rounds(uint32_t x[16]) {
+    for (int i = 0; i < 10; i++) {
+        chacha20QuarterRound(x[0], x[4], x[ 8], x[12]);
+        chacha20QuarterRound(x[1], x[5], x[ 9], x[13]);
+        chacha20QuarterRound(x[2], x[6], x[10], x[14]);
+        chacha20QuarterRound(x[3], x[7], x[11], x[15]);
+        chacha20QuarterRound(x[0], x[5], x[10], x[15]);
+        chacha20QuarterRound(x[1], x[6], x[11], x[12]);
+        chacha20QuarterRound(x[2], x[7], x[ 8], x[13]);
+        chacha20QuarterRound(x[3], x[4], x[ 9], x[14]);
+    }
+}
+
+// Menghasilkan satu blok keystream 64 byte dari state
+inline void chacha20Block(uint32_t out[16], const uint32_t in[16]) {
+    memcpy(out, in, sizeof(uint32_t) * 16);
+    chacha20Rounds(out);
+    for (int i = 0; i < 16; i++) {
+        out[i] += in[i];
+    }
+}
+
+inline void chacha20InitState(uint32_t state[16], const uint8_t key[32], const uint8_t nonce[12], uint32_t counter) {
+    state[0] = 0x61707865;
+    state[1] = 0x3320646E;
+    state[2] = 0x79622D32;
+    state[3] = 0x6B206574;
+    for (int i = 0; i < 8; i++) {
+        state[4 + i] = wsnLoad32(key + 4 * i);
+    }
+    state[12] = counter;
+    state[13] = wsnLoad32(nonce);
+    state[14] = wsnLoad32(nonce + 4);
+    state[15] = wsnLoad32(nonce + 8);
+}
+
+// XOR dengan keystream; fungsi yang sama untuk enkripsi dan dekripsi
+inline void chacha20EncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len,
+                                   const uint8_t key[32], const uint8_t nonce[12], uint32_t counter) {
+    uint32_t state[16];
+    chacha20InitState(state, key, nonce, counter);
+
+    uint32_t block[16];
+    uint8_t keystream[64];
+    size_t i = 0;
+    while (i < len) {
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_KEYSTREAM);
+            chacha20Block(block, state);
+            state[12]++;
+            for (int w = 0; w < 16; w++) {
+                wsnStore32(keystream + 4 * w, block[w]);
+            }
+        }
+        WSN_PROFILE_SCOPE(WSN_PROF_XOR);
+        for (size_t j = 0; j < 64 && i < len; ++j, ++i) {
+            output[i] = input[i] ^ keystream[j];
+        }
+    }
+}
+
+#endif // WSN_CHACHA20_H
@@ -0,0 +1,217 @@
+#ifndef WSN_CHACHA_POLY_H
+#define WSN_CHACHA_POLY_H
+
+// ChaCha20-Poly1305 AEAD (RFC 8439 bagian 2.8) di atas chacha20Block dari WsnChaCha20.h.
+//
+// Seal satu kali jalan: setiap blok keystream 64 byte di-XOR lalu ciphertext-nya langsung
+// masuk Poly1305 selagi masih di cache, tanpa pass kedua atas pesan. Open memverifikasi tag
+// dulu (hanya Poly1305 atas ciphertext), baru mendekripsi; pesan palsu/rusak tidak sampai
+// didekripsi atau ditulis ke SD.
+//
+// Poly1305 memakai limb 26 bit (seperti poly1305-donna 32 bit): hanya perkalian 32x32->64,
+// tanpa aritmetika 128 bit, cocok untuk Xtensa LX106 maupun host.
+
+#include "WsnChaCha20.h"
+
+#define WSN_POLY1305_TAG_SIZE 16
+
+struct WsnPoly1305 {
+    uint32_t r[5];
+    uint32_t h[5];
+    uint32_t pad[4];
+    uint8_t buffer[16];
+    size_t leftover;
+};
+
+inline void poly1305Init(WsnPoly1305 &ctx, const uint8_t key[32]) {
+    // r di-clamp (RFC 8439 2.5.1) sekaligus dipecah ke limb 26 bit
+    ctx.r[0] = wsnLoad32(key + 0) & 0x3FFFFFF;
+    ctx.r[1] = (wsnLoad32(key + 3) >> 2) & 0x3FFFF03;
+    ctx.r[2] = (wsnLoad32(key + 6) >> 4) & 0x3FFC0FF;
+    ctx.r[3] = (wsnLoad32(key + 9) >> 6) & 0x3F03FFF;
+    ctx.r[4] = (wsnLoad32(key + 12) >> 8) & 0x00FFFFF;
+    for (int i = 0; i < 5; i++) ctx.h[i] = 0;
+    for (int i = 0; i < 4; i++) ctx.pad[i] = wsnLoad32(key + 16 + 4 * i);
+    ctx.leftover = 0;
+}
+
+// h = (h + m) * r mod 2^130 - 5 untuk setiap blok 16 byte; hibit 0 hanya untuk blok terakhir
+// yang sudah diberi padding 0x01
+inline void poly1305Blocks(WsnPoly1305 &ctx, const uint8_t *m, size_t bytes, uint32_t hibit) {
+    const uint32_t r0 = ctx.r[0], r1 = ctx.r[1], r2 = ctx.r[2], r3 = ctx.r[3], r4 = ctx.r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = ctx.h[0], h1 = ctx.h[1], h2 = ctx.h[2], h3 = ctx.h[3], h4 = ctx.h[4];
+
+    while (bytes >= 16) {
+        h0 += wsnLoad32(m + 0) & 0x3FFFFFF;
+        h1 += (wsnLoad32(m + 3) >> 2) & 0x3FFFFFF;
+        h2 += (wsnLoad32(m + 6) >> 4) & 0x3FFFFFF;
+        h3 += (wsnLoad32(m + 9) >> 6) & 0x3FFFFFF;
+        h4 += (wsnLoad32(m + 12) >> 8) | hibit;
+
+        uint64_t d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+        uint64_t d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+        uint64_t d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+        uint64_t d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+        uint64_t d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+        uint32_t c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3FFFFFF;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3FFFFFF;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3FFFFFF;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3FFFFFF;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3FFFFFF;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3FFFFFF;
+        h1 += c;
+
+        m += 16;
+        bytes -= 16;
+    }
+
+    ctx.h[0] = h0; ctx.h[1] = h1; ctx.h[2] = h2; ctx.h[3] = h3; ctx.h[4] = h4;
+}
+
+inline void poly1305Update(WsnPoly1305 &ctx, const uint8_t *m, size_t len) {
+    if (ctx.leftover) {
+        size_t take = 16 - ctx.leftover;
+        if (take > len) take = len;
+        memcpy(ctx.buffer + ctx.leftover, m, take);
+        ctx.leftover += take;
+        m += take;
+        len -= take;
+        if (ctx.leftover < 16) return;
+        poly1305Blocks(ctx, ctx.buffer, 16, 1UL << 24);
+        ctx.leftover = 0;
+    }
+    size_t full = len & ~(size_t)15;
+    if (full) {
+        poly1305Blocks(ctx, m, full, 1UL << 24);
+        m += full;
+        len -= full;
+    }
+    if (len) {
+        memcpy(ctx.buffer, m, len);
+        ctx.leftover = len;
+    }
+}
+
+// Nol sampai batas 16 byte (pad16 di konstruksi AEAD)
+inline void poly1305PadZeros(WsnPoly1305 &ctx) {
+    static const uint8_t zeros[16] = {0};
+    if (ctx.leftover) poly1305Update(ctx, zeros, 16 - ctx.leftover);
+}
+
+inline void poly1305Finish(WsnPoly1305 &ctx, uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    if (ctx.leftover) {
+        ctx.buffer[ctx.leftover] = 1;
+        memset(ctx.buffer + ctx.leftover + 1, 0, 15 - ctx.leftover);
+        poly1305Blocks(ctx, ctx.buffer, 16, 0);
+    }
+
+    uint32_t h0 = ctx.h[0], h1 = ctx.h[1], h2 = ctx.h[2], h3 = ctx.h[3], h4 = ctx.h[4];
+    uint32_t c = h1 >> 26; h1 &= 0x3FFFFFF;
+    h2 += c; c = h2 >> 26; h2 &= 0x3FFFFFF;
+    h3 += c; c = h3 >> 26; h3 &= 0x3FFFFFF;
+    h4 += c; c = h4 >> 26; h4 &= 0x3FFFFFF;
+    h0 += c * 5; c = h0 >> 26; h0 &= 0x3FFFFFF;
+    h1 += c;
+
+    // g = h - p; pilih g jika tidak negatif, tanpa cabang
+    uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3FFFFFF;
+    uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3FFFFFF;
+    uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3FFFFFF;
+    uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3FFFFFF;
+    uint32_t g4 = h4 + c - (1UL << 26);
+    uint32_t mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+
+    // 130 bit -> 128 bit, lalu tambah s
+    h0 = h0 | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+    uint64_t f = (uint64_t)h0 + ctx.pad[0];              wsnStore32(tag + 0, (uint32_t)f);
+    f = (uint64_t)h1 + ctx.pad[1] + (f >> 32);           wsnStore32(tag + 4, (uint32_t)f);
+    f = (uint64_t)h2 + ctx.pad[2] + (f >> 32);           wsnStore32(tag + 8, (uint32_t)f);
+    f = (uint64_t)h3 + ctx.pad[3] + (f >> 32);           wsnStore32(tag + 12, (uint32_t)f);
+
+    memset(&ctx, 0, sizeof(ctx));
+}
+
+// Kunci Poly1305 dari blok ChaCha20 counter 0, lalu AAD + pad16
+inline void chacha20Poly1305Begin(WsnPoly1305 &mac, uint32_t state[16], const uint8_t key[32],
+                                  const uint8_t nonce[12], const uint8_t *aad, size_t aadLen) {
+    chacha20InitState(state, key, nonce, 0);
+    uint32_t block[16];
+    uint8_t polyKey[32];
+    chacha20Block(block, state);
+    for (int w = 0; w < 8; w++) wsnStore32(polyKey + 4 * w, block[w]);
+    state[12] = 1;
+    poly1305Init(mac, polyKey);
+    memset(polyKey, 0, sizeof(polyKey));
+    poly1305Update(mac, aad, aadLen);
+    poly1305PadZeros(mac);
+}
+
+// pad16(ciphertext) || le64(len AAD) || le64(len ciphertext)
+inline void chacha20Poly1305End(WsnPoly1305 &mac, size_t aadLen, size_t len, uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    uint8_t lengths[16];
+    poly1305PadZeros(mac);
+    wsnStore32(lengths, (uint32_t)aadLen);
+    wsnStore32(lengths + 4, (uint32_t)((uint64_t)aadLen >> 32));
+    wsnStore32(lengths + 8, (uint32_t)len);
+    wsnStore32(lengths + 12, (uint32_t)((uint64_t)len >> 32));
+    poly1305Update(mac, lengths, sizeof(lengths));
+    poly1305Finish(mac, tag);
+}
+
+// Enkripsi + tag dalam satu pass; input dan output boleh buffer yang sama
+inline void chacha20Poly1305Seal(const uint8_t key[32], const uint8_t nonce[12], const uint8_t *aad, size_t aadLen,
+                                 const uint8_t *input, uint8_t *output, size_t len,
+                                 uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    WsnPoly1305 mac;
+    uint32_t state[16];
+    chacha20Poly1305Begin(mac, state, key, nonce, aad, aadLen);
+
+    uint32_t block[16];
+    uint8_t keystream[64];
+    for (size_t i = 0; i < len; i += 64) {
+        size_t n = len - i < 64 ? len - i : 64;
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_KEYSTREAM);
+            chacha20Block(block, state);
+            state[12]++;
+            for (int w = 0; w < 16; w++) wsnStore32(keystream + 4 * w, block[w]);
+        }
+        WSN_PROFILE_SCOPE(WSN_PROF_XOR);
+        for (size_t j = 0; j < n; j++) output[i + j] = input[i + j] ^ keystream[j];
+        poly1305Update(mac, output + i, n);
+    }
+    chacha20Poly1305End(mac, aadLen, len, tag);
+}
+
+// Hanya memeriksa tag (tanpa dekripsi), mis. sebelum menyimpan atau meneruskan pesan
+inline bool chacha20Poly1305Verify(const uint8_t key[32], const uint8_t nonce[12], const uint8_t *aad, size_t aadLen,
+                                   const uint8_t *ciphertext, size_t len, const uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    WsnPoly1305 mac;
+    uint32_t state[16];
+    uint8_t expected[WSN_POLY1305_TAG_SIZE];
+    chacha20Poly1305Begin(mac, state, key, nonce, aad, aadLen);
+    poly1305Update(mac, ciphertext, len);
+    chacha20Poly1305End(mac, aadLen, len, expected);
+    return wsnTagEqual(expected, tag, sizeof(expected));
+}
+
+// Verifikasi lalu dekripsi; false jika tag salah, output tidak disentuh
+inline bool chacha20Poly1305Open(const uint8_t key[32], const uint8_t nonce[12], const uint8_t *aad, size_t aadLen,
+                                 const uint8_t *input, uint8_t *output, size_t len,
+                                 const uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    if (!chacha20Poly1305Verify(key, nonce, aad, aadLen, input, len, tag)) return false;
+    chacha20EncryptDecrypt(input, output, len, key, nonce, 1);
+    return true;
+}
+
+#endif // WSN_CHACHA_POLY_H
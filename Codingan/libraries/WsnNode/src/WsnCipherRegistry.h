@@ -0,0 +1,246 @@
+#ifndef WSN_CIPHER_REGISTRY_H
+#define WSN_CIPHER_REGISTRY_H
+
+// Registry cipher saat jalan: satu firmware sender/receiver membawa semua engine, dipilih per
+// pesan. Byte pertama pesan = ID cipher (indeks wsnCipherEngines), receiver memilih engine dari
+// situ, jadi kampanye A/B bisa menyapu cipher x ukuran tanpa flash ulang.
+//
+//   stream/blok (WsnSecureLink):  [id][IV/nonce][ciphertext]
+//   AEAD (seal satu pesan):       [id][nonce][tag 16][ciphertext]
+//
+// Dispatch lewat pointer fungsi sekali per pesan (dan per frame ke sink); loop enkripsi di dalam
+// tetap instance template WsnSecureLink tanpa fungsi virtual. Satu kunci 256 bit untuk semua
+// engine (ASCON: 16 byte pertama), nonce dari satu WsnNonceManager sehingga tidak ada nonce yang
+// terulang antar engine. Key schedule AES/CLEFIA/GCM dihitung sekali di wsnCipherRegistryBegin.
+
+#include "WsnAesGcm.h"
+#include "WsnAscon.h"
+#include "WsnChaChaPoly.h"
+#include "WsnSecureLink.h"
+
+#define WSN_REGISTRY_FRAME_BYTES 250
+#define WSN_REGISTRY_TAG_SIZE 16
+
+// Urutan sama dengan wsnBenchCiphers (WsnBenchCiphers.h), tanpa xchacha20
+enum WsnCipherId : uint8_t {
+    WSN_CIPHER_CHACHA20 = 0,
+    WSN_CIPHER_SNOWV,
+    WSN_CIPHER_CLEFIA256,
+    WSN_CIPHER_AES256CBC,
+    WSN_CIPHER_CHACHA20POLY1305,
+    WSN_CIPHER_AES256GCM,
+    WSN_CIPHER_ASCON128,
+    WSN_CIPHER_ASCON128A,
+    WSN_CIPHER_COUNT
+};
+
+// Dipanggil per frame (mis. esp_now_send); false menghentikan pesan
+typedef bool (*WsnFrameSink)(uint8_t *frame, size_t len, void *user);
+
+template <class Cipher, template <class> class Mode>
+using WsnRegistryLink = WsnSecureLink<Cipher, Mode, WsnMessageIvFraming<WSN_REGISTRY_FRAME_BYTES, 1>>;
+
+// CLEFIA memakai CBC + IV per pesan (clefia_sender MESSAGE_IV 1), bukan ECB
+struct WsnCipherRegistryState {
+    uint8_t key[32];
+    WsnNonceManager *nonces = nullptr;
+    WsnRegistryLink<WsnChaCha20Core, WsnKeystreamMode> chacha20;
+    WsnRegistryLink<WsnSnowVCore, WsnKeystreamMode> snowv;
+    WsnRegistryLink<WsnClefia256Core, WsnCbcMode> clefia256;
+    WsnRegistryLink<WsnAes256Core, WsnCbcMode> aes256cbc;
+    Aes256GcmContext gcm;
+};
+
+inline WsnCipherRegistryState &wsnCipherRegistryState() {
+    static WsnCipherRegistryState state;
+    return state;
+}
+
+// nonces sudah begin(); di sender dan receiver dengan kunci yang sama
+inline void wsnCipherRegistryBegin(const uint8_t key[32], WsnNonceManager *nonces) {
+    WsnCipherRegistryState &state = wsnCipherRegistryState();
+    memcpy(state.key, key, sizeof(state.key));
+    state.nonces = nonces;
+    state.chacha20.begin(key, nonces);
+    state.snowv.begin(key, nonces);
+    state.clefia256.begin(key, nonces);
+    state.aes256cbc.begin(key, nonces);
+    aes256GcmSetKey(state.gcm, key);
+}
+
+inline bool wsnRegistrySendFrames(uint8_t *message, size_t len, WsnFrameSink sink, void *user) {
+    for (size_t offset = 0; offset < len; offset += WSN_REGISTRY_FRAME_BYTES) {
+        size_t n = len - offset < WSN_REGISTRY_FRAME_BYTES ? len - offset : WSN_REGISTRY_FRAME_BYTES;
+        if (!sink(message + offset, n, user)) return false;
+    }
+    return true;
+}
+
+// ---- Engine stream/blok: WsnSecureLink, plaintext dibaca per frame ----
+
+template <class Link, Link WsnCipherRegistryState::*Member>
+size_t wsnRegistryLinkLength(size_t len) {
+    return Link::wireLength(len);
+}
+
+template <class Link, Link WsnCipherRegistryState::*Member>
+bool wsnRegistryLinkSeal(uint8_t id, WsnPayloadSource &source, WsnFrameSink sink, void *user,
+                         uint32_t &encryptMicros) {
+    Link &link = wsnCipherRegistryState().*Member;
+    link.header[0] = id;
+    bool ok = link.seal(source, [&](uint8_t *frame, size_t n) { return sink(frame, n, user); });
+    encryptMicros = link.lastEncryptMicros;
+    return ok;
+}
+
+template <class Link, Link WsnCipherRegistryState::*Member>
+bool wsnRegistryLinkOpen(uint8_t *message, size_t len, size_t &plaintextLen, uint32_t &decryptMicros) {
+    Link &link = wsnCipherRegistryState().*Member;
+    bool ok = link.open(message, len, plaintextLen);
+    decryptMicros = link.lastDecryptMicros;
+    return ok;
+}
+
+// ---- Engine AEAD: tag di header, jadi pesan utuh di heap selama seal ----
+
+typedef void (*WsnAeadSealFn)(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len, uint8_t *tag);
+typedef bool (*WsnAeadOpenFn)(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                              const uint8_t *tag);
+
+inline void wsnRegistryChaChaPolySeal(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                                      uint8_t *tag) {
+    chacha20Poly1305Seal(wsnCipherRegistryState().key, nonce, nullptr, 0, input, output, len, tag);
+}
+
+inline bool wsnRegistryChaChaPolyOpen(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                                      const uint8_t *tag) {
+    return chacha20Poly1305Open(wsnCipherRegistryState().key, nonce, nullptr, 0, input, output, len, tag);
+}
+
+inline void wsnRegistryGcmSeal(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                               uint8_t *tag) {
+    aes256GcmSeal(wsnCipherRegistryState().gcm, nonce, nullptr, 0, input, output, len, tag);
+}
+
+inline bool wsnRegistryGcmOpen(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                               const uint8_t *tag) {
+    return aes256GcmOpen(wsnCipherRegistryState().gcm, nonce, nullptr, 0, input, output, len, tag);
+}
+
+template <WsnAsconVariant Variant>
+void wsnRegistryAsconSeal(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len, uint8_t *tag) {
+    asconSeal(Variant, wsnCipherRegistryState().key, nonce, nullptr, 0, input, output, len, tag);
+}
+
+template <WsnAsconVariant Variant>
+bool wsnRegistryAsconOpen(const uint8_t *nonce, const uint8_t *input, uint8_t *output, size_t len,
+                          const uint8_t *tag) {
+    return asconOpen(Variant, wsnCipherRegistryState().key, nonce, nullptr, 0, input, output, len, tag);
+}
+
+template <size_t NonceSize, WsnAeadSealFn Seal, WsnAeadOpenFn Open>
+size_t wsnRegistryAeadLength(size_t len) {
+    return 1 + NonceSize + WSN_REGISTRY_TAG_SIZE + len;
+}
+
+template <size_t NonceSize, WsnAeadSealFn Seal, WsnAeadOpenFn Open>
+bool wsnRegistryAeadSeal(uint8_t id, WsnPayloadSource &source, WsnFrameSink sink, void *user,
+                         uint32_t &encryptMicros) {
+    const size_t prefix = 1 + NonceSize + WSN_REGISTRY_TAG_SIZE;
+    size_t len = source.size();
+    uint8_t *message = (uint8_t *)malloc(prefix + len);
+    if (message == nullptr) return false;
+
+    WsnNonceManager *nonces = wsnCipherRegistryState().nonces;
+    source.rewind();
+    if (nonces == nullptr || !nonces->next(message + 1, NonceSize) ||
+        wsnPayloadReadAll(source, message + prefix, len) != len) {
+        free(message);
+        return false;
+    }
+    message[0] = id;
+
+    uint32_t start = wsnMicros();
+    Seal(message + 1, message + prefix, message + prefix, len, message + 1 + NonceSize);
+    encryptMicros = wsnMicros() - start;
+
+    bool ok = wsnRegistrySendFrames(message, prefix + len, sink, user);
+    free(message);
+    return ok;
+}
+
+// false jika tag salah; plaintext mulai message[0]
+template <size_t NonceSize, WsnAeadSealFn Seal, WsnAeadOpenFn Open>
+bool wsnRegistryAeadOpen(uint8_t *message, size_t len, size_t &plaintextLen, uint32_t &decryptMicros) {
+    const size_t prefix = 1 + NonceSize + WSN_REGISTRY_TAG_SIZE;
+    if (len < prefix) return false;
+    uint8_t header[NonceSize + WSN_REGISTRY_TAG_SIZE];
+    memcpy(header, message + 1, sizeof(header));
+    plaintextLen = len - prefix;
+    // Ciphertext digeser ke awal supaya dekripsi in-place (input == output)
+    memmove(message, message + prefix, plaintextLen);
+
+    uint32_t start = wsnMicros();
+    bool ok = Open(header, message, message, plaintextLen, header + NonceSize);
+    decryptMicros = wsnMicros() - start;
+    return ok;
+}
+
+// ---- Tabel ----
+
+struct WsnCipherEngine {
+    const char *name;
+    bool authenticated;                   // tag salah = pesan dibuang
+    bool zeroPadded;                      // plaintext diisi nol sampai kelipatan 16, dibuang pemanggil
+    size_t (*wireLength)(size_t len);     // termasuk byte ID
+    bool (*seal)(uint8_t id, WsnPayloadSource &source, WsnFrameSink sink, void *user, uint32_t &encryptMicros);
+    bool (*open)(uint8_t *message, size_t len, size_t &plaintextLen, uint32_t &decryptMicros);
+};
+
+#define WSN_REGISTRY_LINK(name, member, zeroPadded)                                                \
+    {name, false, zeroPadded,                                                                      \
+     wsnRegistryLinkLength<decltype(WsnCipherRegistryState::member), &WsnCipherRegistryState::member>, \
+     wsnRegistryLinkSeal<decltype(WsnCipherRegistryState::member), &WsnCipherRegistryState::member>,   \
+     wsnRegistryLinkOpen<decltype(WsnCipherRegistryState::member), &WsnCipherRegistryState::member>}
+
+#define WSN_REGISTRY_AEAD(name, nonceSize, seal, open)                                             \
+    {name, true, false, wsnRegistryAeadLength<nonceSize, seal, open>, wsnRegistryAeadSeal<nonceSize, seal, open>, \
+     wsnRegistryAeadOpen<nonceSize, seal, open>}
+
+static const WsnCipherEngine wsnCipherEngines[WSN_CIPHER_COUNT] = {
+    WSN_REGISTRY_LINK("chacha20", chacha20, false),
+    WSN_REGISTRY_LINK("snowv", snowv, false),
+    WSN_REGISTRY_LINK("clefia256", clefia256, true),
+    WSN_REGISTRY_LINK("aes256cbc", aes256cbc, false),
+    WSN_REGISTRY_AEAD("chacha20poly1305", 12, wsnRegistryChaChaPolySeal, wsnRegistryChaChaPolyOpen),
+    WSN_REGISTRY_AEAD("aes256gcm", WSN_GCM_IV_SIZE, wsnRegistryGcmSeal, wsnRegistryGcmOpen),
+    WSN_REGISTRY_AEAD("ascon128", WSN_ASCON_NONCE_SIZE, wsnRegistryAsconSeal<WSN_ASCON_128>,
+                      wsnRegistryAsconOpen<WSN_ASCON_128>),
+    WSN_REGISTRY_AEAD("ascon128a", WSN_ASCON_NONCE_SIZE, wsnRegistryAsconSeal<WSN_ASCON_128A>,
+                      wsnRegistryAsconOpen<WSN_ASCON_128A>),
+};
+
+#undef WSN_REGISTRY_LINK
+#undef WSN_REGISTRY_AEAD
+
+// nullptr jika ID tidak dikenal (firmware lama / pesan rusak)
+inline const WsnCipherEngine *wsnCipherEngine(uint8_t id) {
+    return id < WSN_CIPHER_COUNT ? &wsnCipherEngines[id] : nullptr;
+}
+
+// ID dari nama ("aes256gcm"), -1 jika tidak ada
+inline int wsnCipherFind(const char *name) {
+    for (int i = 0; i < WSN_CIPHER_COUNT; i++) {
+        if (strcmp(wsnCipherEngines[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// Enkripsi plaintext dari source dengan engine id dan kirim per frame
+inline bool wsnCipherSeal(uint8_t id, WsnPayloadSource &source, WsnFrameSink sink, void *user,
+                          uint32_t &encryptMicros) {
+    const WsnCipherEngine *engine = wsnCipherEngine(id);
+    return engine != nullptr && engine->seal(id, source, sink, user, encryptMicros);
+}
+
+#endif // WSN_CIPHER_REGISTRY_H
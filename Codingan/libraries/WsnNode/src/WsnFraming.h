@@ -0,0 +1,79 @@
+#ifndef WSN_FRAMING_H
+#define WSN_FRAMING_H
+
+// Framing stream biner yang sama dengan ina_power_2ms: COBS(payload + CRC16 LE) + 0x00.
+// Decoder host: cobs_decode() / crc16() di visualisasi data/ina_stream_decode.py.
+
+#include "WsnPlatform.h"
+
+// Ukuran maksimum hasil COBS untuk input n byte (tanpa delimiter 0x00)
+#define WSN_COBS_MAX(n) ((n) + (n) / 254 + 1)
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+inline uint16_t wsnCrc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Consistent Overhead Byte Stuffing: hasil tidak pernah berisi 0x00,
+// sehingga 0x00 bisa dipakai sebagai pemisah frame.
+inline size_t wsnCobsEncode(const uint8_t *input, size_t len, uint8_t *output) {
+    size_t readIndex = 0;
+    size_t writeIndex = 1;
+    size_t codeIndex = 0;
+    uint8_t code = 1;
+
+    while (readIndex < len) {
+        if (input[readIndex] == 0) {
+            output[codeIndex] = code;
+            code = 1;
+            codeIndex = writeIndex++;
+            readIndex++;
+        } else {
+            output[writeIndex++] = input[readIndex++];
+            code++;
+            if (code == 0xFF) {
+                output[codeIndex] = code;
+                code = 1;
+                codeIndex = writeIndex++;
+            }
+        }
+    }
+    output[codeIndex] = code;
+    return writeIndex;
+}
+
+// Mengembalikan panjang hasil decode, atau 0 jika frame rusak
+inline size_t wsnCobsDecode(const uint8_t *input, size_t len, uint8_t *output) {
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+    while (readIndex < len) {
+        uint8_t code = input[readIndex];
+        if (code == 0 || readIndex + code > len) return 0;
+        readIndex++;
+        for (uint8_t i = 1; i < code; i++) {
+            output[writeIndex++] = input[readIndex++];
+        }
+        if (code < 0xFF && readIndex < len) output[writeIndex++] = 0;
+    }
+    return writeIndex;
+}
+
+// payload -> COBS(payload + CRC16) + 0x00 di output; output minimal WSN_COBS_MAX(len + 2) + 1 byte.
+// scratch minimal len + 2 byte.
+inline size_t wsnFrameEncode(const uint8_t *payload, size_t len, uint8_t *scratch, uint8_t *output) {
+    memcpy(scratch, payload, len);
+    uint16_t crc = wsnCrc16(payload, len);
+    scratch[len] = (uint8_t)crc;
+    scratch[len + 1] = (uint8_t)(crc >> 8);
+    size_t n = wsnCobsEncode(scratch, len + 2, output);
+    output[n++] = 0x00;
+    return n;
+}
+
+#endif // WSN_FRAMING_H
@@ -0,0 +1,248 @@
+#ifndef WSN_LATENCY_H
+#define WSN_LATENCY_H
+
+// Latensi end-to-end per pesan: dari plaintext diambil di sender sampai tersimpan di SD receiver.
+//
+// Sender mengirim satu frame trailer setelah fragmen terakhir. Trailer berisi timestamp
+// micros() sender: sample, enkripsi selesai, fragmen pertama dan terakhir dikirim.
+// Receiver menambahkan timestamp fragmen pertama/terakhir diterima, dekripsi selesai dan
+// SD selesai. Timestamp sender dikonversi ke clock receiver dengan offset dari
+// pertukaran sinkronisasi dua arah ala NTP lewat ESP-NOW (WsnClockSync).
+//
+// Frame trailer dan sync dikenali dari magic 32 bit dan panjang tetap. Peluang fragmen
+// ciphertext biasa cocok dengan keduanya sekitar 2^-32.
+//
+// Tiap stage diakumulasi di histogram log-linear (resolusi ~12%) untuk p50/p95/p99 di node.
+// Baris "lat,..." per pesan bisa dianalisis persis di host dengan latency_report.py.
+
+#include "WsnPlatform.h"
+
+#define WSN_LATENCY_MAGIC 0x314C4E57UL  // "WNL1"
+#define WSN_SYNC_MAGIC 0x31534E57UL     // "WNS1"
+
+#define WSN_SYNC_REQUEST 0
+#define WSN_SYNC_RESPONSE 1
+
+struct __attribute__((packed)) WsnLatencyTrailer {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t sample_us;
+    uint32_t encryptDone_us;
+    uint32_t firstSent_us;
+    uint32_t lastSent_us;
+};
+
+struct __attribute__((packed)) WsnSyncFrame {
+    uint32_t magic;
+    uint8_t type;
+    uint32_t t1;  // request dikirim (clock peminta)
+    uint32_t t2;  // request diterima (clock penjawab)
+    uint32_t t3;  // response dikirim (clock penjawab)
+};
+
+inline bool wsnIsLatencyTrailer(const uint8_t *data, size_t len) {
+    return len == sizeof(WsnLatencyTrailer) && wsnLoad32(data) == WSN_LATENCY_MAGIC;
+}
+
+inline bool wsnIsSyncFrame(const uint8_t *data, size_t len) {
+    return len == sizeof(WsnSyncFrame) && wsnLoad32(data) == WSN_SYNC_MAGIC;
+}
+
+inline void wsnSyncBuildRequest(WsnSyncFrame &frame, uint32_t t1) {
+    frame.magic = WSN_SYNC_MAGIC;
+    frame.type = WSN_SYNC_REQUEST;
+    frame.t1 = t1;
+    frame.t2 = frame.t3 = 0;
+}
+
+// Dipanggil penjawab (sender) di callback terima; t3 diambil tepat sebelum esp_now_send
+inline void wsnSyncBuildResponse(WsnSyncFrame &response, const WsnSyncFrame &request, uint32_t t2, uint32_t t3) {
+    response.magic = WSN_SYNC_MAGIC;
+    response.type = WSN_SYNC_RESPONSE;
+    response.t1 = request.t1;
+    response.t2 = t2;
+    response.t3 = t3;
+}
+
+// Estimasi offset clock remote terhadap clock lokal. Dari beberapa pertukaran terakhir
+// dipakai yang round-trip-nya paling kecil (paling sedikit antrian/retry).
+class WsnClockSync {
+public:
+    static const int WINDOW = 8;
+
+    // t4 = micros() lokal saat response diterima
+    void onResponse(const WsnSyncFrame &frame, uint32_t t4) {
+        int32_t rtt = (int32_t)(t4 - frame.t1) - (int32_t)(frame.t3 - frame.t2);
+        int32_t offset = (int32_t)(((int64_t)(int32_t)(frame.t2 - frame.t1) + (int32_t)(frame.t3 - t4)) / 2);
+        if (rtt < 0) return;
+        samples[next].offset = offset;
+        samples[next].rtt = rtt;
+        next = (next + 1) % WINDOW;
+        if (count < WINDOW) count++;
+    }
+
+    bool valid() const { return count > 0; }
+
+    // remote - lokal (us)
+    int32_t offset() const { return best().offset; }
+    int32_t rtt() const { return best().rtt; }
+
+    uint32_t toLocal(uint32_t remote_us) const { return remote_us - (uint32_t)offset(); }
+
+private:
+    struct Sample {
+        int32_t offset;
+        int32_t rtt;
+    };
+
+    Sample best() const {
+        Sample b = {0, 0};
+        for (int i = 0; i < count; i++) {
+            if (i == 0 || samples[i].rtt < b.rtt) b = samples[i];
+        }
+        return b;
+    }
+
+    Sample samples[WINDOW] = {};
+    int next = 0;
+    int count = 0;
+};
+
+// Histogram log-linear: 8 sub-bucket per oktaf, nilai 0..2^24 us (~16 s)
+class WsnLatencyHistogram {
+public:
+    static const int SUB_BITS = 3;
+    static const int BUCKETS = (24 - SUB_BITS + 1) << SUB_BITS;
+
+    void add(uint32_t us) {
+        hist[bucketOf(us)]++;
+        total++;
+        if (us > maxValue) maxValue = us;
+    }
+
+    uint32_t count() const { return total; }
+    uint32_t max() const { return maxValue; }
+
+    // Nilai tengah bucket yang memuat kuantil q
+    uint32_t quantile(double q) const {
+        if (!total) return 0;
+        uint32_t rank = (uint32_t)(q * (total - 1)) + 1;
+        uint32_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += hist[b];
+            if (seen >= rank) return (lowerBound(b) + lowerBound(b + 1)) / 2;
+        }
+        return maxValue;
+    }
+
+    void reset() {
+        memset(hist, 0, sizeof(hist));
+        total = 0;
+        maxValue = 0;
+    }
+
+private:
+    static int bucketOf(uint32_t v) {
+        if (v < (1u << SUB_BITS)) return (int)v;
+        int exponent = 31 - __builtin_clz(v);
+        int b = ((exponent - SUB_BITS + 1) << SUB_BITS) + (int)((v >> (exponent - SUB_BITS)) & ((1 << SUB_BITS) - 1));
+        return b < BUCKETS ? b : BUCKETS - 1;
+    }
+
+    static uint32_t lowerBound(int b) {
+        if (b < (1 << SUB_BITS)) return (uint32_t)b;
+        int exponent = (b >> SUB_BITS) + SUB_BITS - 1;
+        return ((1u << SUB_BITS) | (uint32_t)(b & ((1 << SUB_BITS) - 1))) << (exponent - SUB_BITS);
+    }
+
+    uint16_t hist[BUCKETS] = {};
+    uint32_t total = 0;
+    uint32_t maxValue = 0;
+};
+
+enum WsnLatencyStage {
+    WSN_LAT_ENCRYPT,     // sample -> enkripsi selesai (sender)
+    WSN_LAT_QUEUE,       // enkripsi selesai -> fragmen pertama dikirim (sender)
+    WSN_LAT_SEND,        // fragmen pertama -> fragmen terakhir dikirim (sender)
+    WSN_LAT_FIRST_AIR,   // fragmen pertama dikirim -> diterima (lintas clock)
+    WSN_LAT_LAST_AIR,    // fragmen terakhir dikirim -> diterima (lintas clock)
+    WSN_LAT_REASSEMBLY,  // fragmen terakhir diterima -> dekripsi selesai (termasuk timeout akhir pesan)
+    WSN_LAT_STORE,       // dekripsi selesai -> SD selesai
+    WSN_LAT_TOTAL,       // sample -> SD selesai (lintas clock)
+    WSN_LAT_STAGE_COUNT
+};
+
+static const char *const wsnLatencyStageNames[WSN_LAT_STAGE_COUNT] = {
+    "encrypt", "queue", "send", "first_air", "last_air", "reassembly", "store", "total",
+};
+
+// Timestamp sisi receiver untuk satu pesan (clock lokal)
+struct WsnReceiveTimes {
+    uint32_t firstRx_us;
+    uint32_t lastRx_us;
+    uint32_t decryptDone_us;
+    uint32_t sdDone_us;
+};
+
+class WsnLatencyStats {
+public:
+    // Mengisi stage[] (us); stage lintas clock yang negatif (offset belum akurat) dipotong ke 0
+    void record(const WsnLatencyTrailer &t, const WsnReceiveTimes &rx, const WsnClockSync &sync,
+                uint32_t stage[WSN_LAT_STAGE_COUNT]) {
+        uint32_t sample = sync.toLocal(t.sample_us);
+        uint32_t firstSent = sync.toLocal(t.firstSent_us);
+        uint32_t lastSent = sync.toLocal(t.lastSent_us);
+
+        stage[WSN_LAT_ENCRYPT] = t.encryptDone_us - t.sample_us;
+        stage[WSN_LAT_QUEUE] = t.firstSent_us - t.encryptDone_us;
+        stage[WSN_LAT_SEND] = t.lastSent_us - t.firstSent_us;
+        stage[WSN_LAT_FIRST_AIR] = clampSpan(firstSent, rx.firstRx_us);
+        stage[WSN_LAT_LAST_AIR] = clampSpan(lastSent, rx.lastRx_us);
+        stage[WSN_LAT_REASSEMBLY] = rx.decryptDone_us - rx.lastRx_us;
+        stage[WSN_LAT_STORE] = rx.sdDone_us - rx.decryptDone_us;
+        stage[WSN_LAT_TOTAL] = clampSpan(sample, rx.sdDone_us);
+
+        for (int s = 0; s < WSN_LAT_STAGE_COUNT; s++) {
+            histograms[s].add(stage[s]);
+        }
+    }
+
+    template <typename Out>
+    void printRecord(Out &out, uint32_t sequence, const uint32_t stage[WSN_LAT_STAGE_COUNT],
+                     const WsnClockSync &sync) {
+        char line[160];
+        int n = snprintf(line, sizeof(line), "lat,%lu", (unsigned long)sequence);
+        for (int s = 0; s < WSN_LAT_STAGE_COUNT; s++) {
+            n += snprintf(line + n, sizeof(line) - n, ",%lu", (unsigned long)stage[s]);
+        }
+        snprintf(line + n, sizeof(line) - n, ",%ld,%ld\n", (long)sync.offset(), (long)sync.rtt());
+        out.print(line);
+    }
+
+    template <typename Out>
+    void printSummary(Out &out) {
+        char line[96];
+        out.print("# stage,count,p50_us,p95_us,p99_us,max_us\n");
+        for (int s = 0; s < WSN_LAT_STAGE_COUNT; s++) {
+            const WsnLatencyHistogram &h = histograms[s];
+            snprintf(line, sizeof(line), "# %s,%lu,%lu,%lu,%lu,%lu\n", wsnLatencyStageNames[s],
+                     (unsigned long)h.count(), (unsigned long)h.quantile(0.50), (unsigned long)h.quantile(0.95),
+                     (unsigned long)h.quantile(0.99), (unsigned long)h.max());
+            out.print(line);
+        }
+    }
+
+    void reset() {
+        for (WsnLatencyHistogram &h : histograms) h.reset();
+    }
+
+private:
+    static uint32_t clampSpan(uint32_t from, uint32_t to) {
+        int32_t span = (int32_t)(to - from);
+        return span > 0 ? (uint32_t)span : 0;
+    }
+
+    WsnLatencyHistogram histograms[WSN_LAT_STAGE_COUNT];
+};
+
+#endif // WSN_LATENCY_H
@@ -0,0 +1,226 @@
+#ifndef WSN_LOG_H
+#define WSN_LOG_H
+
+// Log biner tertunda: record kecil ditulis ke ring buffer RAM, dikirim ke Serial belakangan.
+//
+// Teks format tidak pernah dikirim dari node. Sketch mendefinisikan tabel format sebagai
+// X-macro, node hanya mengirim ID format + argumen bertipe:
+//
+//   #define WSN_LOG_FORMATS(X) X(LOG_ENCRYPT_TIME, "Encryption Time: %lu us") X(LOG_CIPHERTEXT, "Ciphertext[%u]: %b")
+//   WSN_LOG_DECLARE(WSN_LOG_FORMATS)
+//
+//   wsnLog(LOG_ENCRYPT_TIME, elapsed);
+//   wsnLog(LOG_CIPHERTEXT, (uint32_t)len, wsnLogBlob(ciphertext, 16));
+//   wsnLogDrain(Serial);            // di loop / selama menunggu
+//
+// Decoder host (visualisasi data/log_decode.py) membaca tabel X(...) dari sketch yang sama
+// dan menyusun kembali teksnya. %b mencetak blob sebagai hex.
+//
+// Record: [id][micros u32][tag arg]..., tag 'u' u32, 'i' i32, 'f' float, 's'/'b' len u8 + byte.
+// Setiap record langsung di-frame COBS + CRC16 (WsnFraming.h) sebelum masuk ring, sehingga
+// byte yang di-drain bisa bercampur dengan Serial.print biasa dan tetap bisa dipisahkan.
+// Ring penuh: record dibuang dan dihitung; begitu ada ruang, record "dropped" dikirim.
+
+#include "WsnFraming.h"
+
+#ifndef WSN_LOG_RING_SIZE
+#define WSN_LOG_RING_SIZE 2048  // harus pangkat dua
+#endif
+
+#ifndef WSN_LOG_MAX_RECORD
+#define WSN_LOG_MAX_RECORD 96  // payload per record sebelum framing
+#endif
+
+#define WSN_LOG_ID_DROPPED 0xFF  // argumen: jumlah record yang dibuang
+
+#define WSN_LOG_ENUM_ENTRY(name, fmt) name,
+#define WSN_LOG_DECLARE(formats) enum WsnLogId : uint8_t { formats(WSN_LOG_ENUM_ENTRY) WSN_LOG_ID_COUNT };
+
+struct WsnLogBlob {
+    const uint8_t *data;
+    uint8_t len;
+};
+
+// Blob lebih panjang dari 255 byte dipotong
+inline WsnLogBlob wsnLogBlob(const uint8_t *data, size_t len) {
+    WsnLogBlob blob = {data, (uint8_t)(len < 255 ? len : 255)};
+    return blob;
+}
+
+class WsnLogRing {
+public:
+    // Menyalin frame utuh ke ring; false jika tidak muat (frame tidak ditulis sebagian)
+    bool push(const uint8_t *frame, size_t len, bool countDrop = true) {
+        WsnCriticalSection lock;
+        if (WSN_LOG_RING_SIZE - (head - tail) < len) {
+            if (countDrop) dropped++;
+            return false;
+        }
+        for (size_t i = 0; i < len; i++) {
+            buffer[(head + i) & (WSN_LOG_RING_SIZE - 1)] = frame[i];
+        }
+        head += len;
+        return true;
+    }
+
+    // Bagian bersambung berikutnya yang siap dikirim
+    size_t peek(const uint8_t **data) {
+        WsnCriticalSection lock;
+        uint32_t offset = tail & (WSN_LOG_RING_SIZE - 1);
+        uint32_t used = head - tail;
+        *data = buffer + offset;
+        return used < WSN_LOG_RING_SIZE - offset ? used : WSN_LOG_RING_SIZE - offset;
+    }
+
+    void consume(size_t len) {
+        WsnCriticalSection lock;
+        tail += len;
+    }
+
+    uint32_t takeDropped() {
+        WsnCriticalSection lock;
+        uint32_t n = dropped;
+        dropped = 0;
+        return n;
+    }
+
+    void addDropped(uint32_t n) {
+        WsnCriticalSection lock;
+        dropped += n;
+    }
+
+    size_t used() const { return head - tail; }
+
+private:
+    uint8_t buffer[WSN_LOG_RING_SIZE];
+    volatile uint32_t head = 0;  // free-running, diindeks dengan mask
+    volatile uint32_t tail = 0;
+    uint32_t dropped = 0;
+};
+
+inline WsnLogRing &wsnLogRing() {
+    static WsnLogRing ring;
+    return ring;
+}
+
+// Penulis record; argumen yang tidak muat di WSN_LOG_MAX_RECORD dibuang dari belakang
+class WsnLogRecord {
+public:
+    explicit WsnLogRecord(uint8_t id) {
+        payload[0] = id;
+        wsnStore32(payload + 1, wsnMicros());
+        len = 5;
+    }
+
+    void add(uint32_t v) { putWord('u', v); }
+    void add(int32_t v) { putWord('i', (uint32_t)v); }
+    void add(float v) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        putWord('f', bits);
+    }
+    void add(double v) { add((float)v); }
+    void add(char *s) { add((const char *)s); }
+    void add(const char *s) { putBytes('s', (const uint8_t *)s, strlen(s)); }
+    void add(const WsnLogBlob &b) { putBytes('b', b.data, b.len); }
+
+    // Tipe integer lain (unsigned long di ESP, size_t, int) dipetakan ke u32/i32
+    template <typename T>
+    void add(T v) {
+        if ((T)-1 < (T)0) add((int32_t)v);
+        else add((uint32_t)v);
+    }
+
+    bool commit(bool countDrop = true) {
+        uint8_t scratch[WSN_LOG_MAX_RECORD + 2];
+        uint8_t frame[WSN_COBS_MAX(WSN_LOG_MAX_RECORD + 2) + 1];
+        size_t n = wsnFrameEncode(payload, len, scratch, frame);
+        return wsnLogRing().push(frame, n, countDrop);
+    }
+
+private:
+    void putWord(uint8_t tag, uint32_t v) {
+        if (len + 5 > WSN_LOG_MAX_RECORD) return;
+        payload[len] = tag;
+        wsnStore32(payload + len + 1, v);
+        len += 5;
+    }
+
+    void putBytes(uint8_t tag, const uint8_t *data, size_t n) {
+        if (len + 2 > WSN_LOG_MAX_RECORD) return;
+        if (n > 255) n = 255;
+        if (n > WSN_LOG_MAX_RECORD - len - 2) n = WSN_LOG_MAX_RECORD - len - 2;
+        payload[len] = tag;
+        payload[len + 1] = (uint8_t)n;
+        memcpy(payload + len + 2, data, n);
+        len += 2 + n;
+    }
+
+    uint8_t payload[WSN_LOG_MAX_RECORD];
+    size_t len;
+};
+
+inline void wsnLogAddArgs(WsnLogRecord &) {}
+
+template <typename T, typename... Rest>
+void wsnLogAddArgs(WsnLogRecord &record, T first, Rest... rest) {
+    record.add(first);
+    wsnLogAddArgs(record, rest...);
+}
+
+// Biaya: encode COBS + CRC record (puluhan byte) dan memcpy ke ring; tidak pernah menunggu Serial
+template <typename... Args>
+bool wsnLog(uint8_t id, Args... args) {
+    WsnLogRecord record(id);
+    wsnLogAddArgs(record, args...);
+    return record.commit();
+}
+
+// Kirim isi ring sebanyak yang muat di buffer TX tanpa blocking. Mengembalikan byte terkirim.
+template <typename Out>
+size_t wsnLogDrain(Out &out) {
+    WsnLogRing &ring = wsnLogRing();
+    size_t sent = 0;
+    for (;;) {
+        int room = out.availableForWrite();
+        if (room <= 0) break;
+        const uint8_t *data;
+        size_t n = ring.peek(&data);
+        if (!n) break;
+        if (n > (size_t)room) n = (size_t)room;
+        n = out.write(data, n);
+        if (!n) break;
+        ring.consume(n);
+        sent += n;
+    }
+
+    // Dicatat setelah isi ring terkirim supaya urutannya tetap: record lama, lalu jumlah yang hilang
+    uint32_t dropped = ring.takeDropped();
+    if (dropped) {
+        WsnLogRecord record(WSN_LOG_ID_DROPPED);
+        record.add(dropped);
+        if (!record.commit(false)) ring.addDropped(dropped);  // masih penuh: coba lagi di drain berikutnya
+    }
+    return sent;
+}
+
+// Pengganti delay(ms) yang mengosongkan log selama menunggu
+template <typename Out>
+void wsnLogDrainFor(Out &out, uint32_t ms) {
+    uint32_t start = wsnMillis();
+    do {
+        wsnLogDrain(out);
+        wsnYield();
+    } while (wsnMillis() - start < ms);
+}
+
+// Blocking sampai ring kosong, mis. sebelum deep sleep
+template <typename Out>
+void wsnLogFlush(Out &out) {
+    while (wsnLogRing().used()) {
+        wsnLogDrain(out);
+        wsnYield();
+    }
+}
+
+#endif // WSN_LOG_H
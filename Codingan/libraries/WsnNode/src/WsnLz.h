@@ -0,0 +1,273 @@
+#ifndef WSN_LZ_H
+#define WSN_LZ_H
+
+// Kompresor LZ77 kecil (keluarga LZSS/LZ4) di antara sumber payload dan cipher.
+//
+// Kompresor streaming dengan RAM tetap (tanpa heap): jendela 1 KB + lookahead + staging 256 B
+// + tabel hash 512 entri, ~2.7 KB per instance (sebaiknya global). Input boleh datang per chunk
+// berapa pun ukurannya; hasilnya sama dengan mengompres sekaligus, karena byte terakhir baru
+// dienkode setelah lookahead penuh atau saat finish().
+//
+// Format pesan:
+//   [0xC7][varint panjang asli] token...
+//   0LLLLLLL                 : L+1 byte literal menyusul (1..128)
+//   1LLLLLOO OOOOOOOO [ext]  : salin L+3 byte dari offset O+1 ke belakang (L = 31: panjang 34 + ext)
+//
+// Byte pertama 0xC7 bukan ASCII dan berbeda dari WsnSensorCodec (0xD5), jadi receiver bisa
+// mendeteksi ketiganya: teks biasa, pesan sensor biner, pesan terkompresi.
+// Decoder host: visualisasi data/lz_decode.py.
+
+#include "WsnPlatform.h"
+
+#define WSN_LZ_MAGIC 0xC7
+#define WSN_LZ_WINDOW 1024  // maksimum 1024 (offset 10 bit)
+#define WSN_LZ_STAGE 256
+#define WSN_LZ_HASH_BITS 9
+#define WSN_LZ_MIN_MATCH 3
+#define WSN_LZ_MAX_MATCH (34 + 255)
+
+// Batas atas ukuran keluaran untuk input n byte (semua literal + header)
+#define WSN_LZ_MAX_COMPRESSED(n) ((n) + (n) / 128 + 8)
+
+struct WsnLzStats {
+    uint32_t inputBytes;
+    uint32_t outputBytes;
+    uint32_t micros;  // waktu kompres/dekompres
+};
+
+class WsnLzCompressor {
+public:
+    // Header pesan; totalLen = jumlah byte yang akan diberikan ke update()
+    bool begin(uint32_t totalLen, uint8_t *output, size_t capacity) {
+        out = output;
+        cap = capacity;
+        outLen = 0;
+        failed = false;
+        bufLen = 0;
+        pos = 0;
+        litCount = 0;
+        memset(head, 0, sizeof(head));
+        put(WSN_LZ_MAGIC);
+        do {
+            uint8_t b = totalLen & 0x7F;
+            totalLen >>= 7;
+            put(totalLen ? (uint8_t)(b | 0x80) : b);
+        } while (totalLen);
+        return !failed;
+    }
+
+    bool update(const uint8_t *input, size_t len) {
+        while (len && !failed) {
+            size_t n = len < WSN_LZ_STAGE ? len : WSN_LZ_STAGE;
+            if (bufLen + n > sizeof(buf)) slide();
+            memcpy(buf + bufLen, input, n);
+            bufLen += n;
+            if (bufLen > WSN_LZ_MAX_MATCH) encode(bufLen - WSN_LZ_MAX_MATCH);
+            input += n;
+            len -= n;
+        }
+        return !failed;
+    }
+
+    // Mengembalikan panjang pesan, 0 jika buffer keluaran tidak cukup
+    size_t finish() {
+        encode(bufLen);
+        flushLiterals();
+        return failed ? 0 : outLen;
+    }
+
+private:
+    static uint32_t hash(const uint8_t *p) {
+        uint32_t v = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16;
+        return (v * 2654435761u) >> (32 - WSN_LZ_HASH_BITS);
+    }
+
+    void put(uint8_t b) {
+        if (outLen < cap) out[outLen++] = b;
+        else failed = true;
+    }
+
+    void flushLiterals() {
+        if (!litCount) return;
+        put((uint8_t)(litCount - 1));
+        if (cap - outLen < litCount) {
+            failed = true;
+        } else if (!failed) {
+            memcpy(out + outLen, literals, litCount);
+            outLen += litCount;
+        }
+        litCount = 0;
+    }
+
+    // Geser jendela: simpan WSN_LZ_WINDOW byte sebelum pos (plus lookahead) di depan buffer.
+    // bufLen - pos <= WSN_LZ_MAX_MATCH, jadi setelah geser selalu ada ruang satu stage.
+    void slide() {
+        size_t shift = pos - WSN_LZ_WINDOW;
+        memmove(buf, buf + shift, bufLen - shift);
+        for (uint16_t &h : head) h = h > shift ? (uint16_t)(h - shift) : 0;
+        bufLen -= shift;
+        pos -= shift;
+    }
+
+    void insert(size_t p) {
+        if (p + WSN_LZ_MIN_MATCH <= bufLen) head[hash(buf + p)] = (uint16_t)(p + 1);
+    }
+
+    // Enkode byte pos..stop-1; match boleh memanjang sampai bufLen
+    void encode(size_t stop) {
+        size_t p = pos;
+        size_t end = bufLen;
+        while (p < stop) {
+            size_t matchLen = 0;
+            size_t offset = 0;
+            if (p + WSN_LZ_MIN_MATCH <= end) {
+                uint32_t h = hash(buf + p);
+                size_t candidate = head[h];
+                head[h] = (uint16_t)(p + 1);
+                if (candidate && p - (candidate - 1) <= WSN_LZ_WINDOW) {
+                    size_t c = candidate - 1;
+                    size_t limit = end - p < WSN_LZ_MAX_MATCH ? end - p : WSN_LZ_MAX_MATCH;
+                    while (matchLen < limit && buf[c + matchLen] == buf[p + matchLen]) matchLen++;
+                    offset = p - c;
+                }
+            }
+
+            if (matchLen >= WSN_LZ_MIN_MATCH) {
+                flushLiterals();
+                size_t code = matchLen - WSN_LZ_MIN_MATCH;
+                uint8_t lenField = code < 31 ? (uint8_t)code : 31;
+                put((uint8_t)(0x80 | lenField << 2 | (offset - 1) >> 8));
+                put((uint8_t)(offset - 1));
+                if (lenField == 31) put((uint8_t)(matchLen - 34));
+                for (size_t i = 1; i < matchLen; i++) insert(p + i);
+                p += matchLen;
+            } else {
+                literals[litCount++] = buf[p++];
+                if (litCount == sizeof(literals)) flushLiterals();
+            }
+        }
+        pos = p;
+    }
+
+    uint8_t buf[WSN_LZ_WINDOW + WSN_LZ_MAX_MATCH + WSN_LZ_STAGE];
+    uint16_t head[1 << WSN_LZ_HASH_BITS];  // posisi + 1 di buf, 0 = kosong
+    uint8_t literals[128];
+    size_t bufLen = 0;
+    size_t pos = 0;  // byte berikutnya yang belum dienkode
+    size_t litCount = 0;
+
+    uint8_t *out = nullptr;
+    size_t cap = 0;
+    size_t outLen = 0;
+    bool failed = false;
+};
+
+inline bool wsnLzIsCompressed(const uint8_t *data, size_t len) {
+    return len >= 2 && data[0] == WSN_LZ_MAGIC;
+}
+
+// Panjang asli dari header; posisi token pertama ke *tokens. 0 jika bukan pesan LZ.
+inline uint32_t wsnLzOriginalLength(const uint8_t *data, size_t len, size_t *tokens = nullptr) {
+    if (!wsnLzIsCompressed(data, len)) return 0;
+    uint32_t v = 0;
+    for (size_t i = 1; i < len && i < 6; i++) {
+        v |= (uint32_t)(data[i] & 0x7F) << (7 * (i - 1));
+        if (!(data[i] & 0x80)) {
+            if (tokens) *tokens = i + 1;
+            return v;
+        }
+    }
+    return 0;
+}
+
+// Dekompres satu pesan utuh; jendela = buffer keluaran itu sendiri. Byte setelah token
+// terakhir (padding blok cipher) diabaikan. Mengembalikan panjang asli, 0 jika rusak.
+inline size_t wsnLzDecompress(const uint8_t *data, size_t len, uint8_t *out, size_t cap) {
+    size_t pos;
+    uint32_t total = wsnLzOriginalLength(data, len, &pos);
+    if (!total || total > cap) return 0;
+    size_t n = 0;
+    while (n < total) {
+        if (pos >= len) return 0;
+        uint8_t token = data[pos++];
+        if (!(token & 0x80)) {
+            size_t count = (size_t)token + 1;
+            if (len - pos < count || total - n < count) return 0;
+            memcpy(out + n, data + pos, count);
+            pos += count;
+            n += count;
+        } else {
+            if (pos >= len) return 0;
+            size_t lenField = (token >> 2) & 31;
+            size_t offset = ((size_t)(token & 3) << 8 | data[pos++]) + 1;
+            size_t count = lenField + WSN_LZ_MIN_MATCH;
+            if (lenField == 31) {
+                if (pos >= len) return 0;
+                count = 34 + data[pos++];
+            }
+            if (offset > n || total - n < count) return 0;
+            // Salin per byte: sumber boleh tumpang tindih dengan tujuan (run berulang)
+            for (size_t i = 0; i < count; i++, n++) out[n] = out[n - offset];
+        }
+    }
+    return n;
+}
+
+// Untuk sender: kompres len byte ke buffer heap baru (pemanggil wajib free()).
+// nullptr jika heap habis atau hasilnya tidak lebih kecil; kirim data aslinya saja.
+inline uint8_t *wsnLzCompressAlloc(WsnLzCompressor &compressor, const uint8_t *data, size_t len,
+                                   size_t &compressedLen, WsnLzStats *stats = nullptr) {
+    uint32_t start = wsnMicros();
+    size_t cap = WSN_LZ_MAX_COMPRESSED(len);
+    uint8_t *out = (uint8_t *)malloc(cap);
+    if (out == nullptr) return nullptr;
+    compressor.begin((uint32_t)len, out, cap);
+    compressor.update(data, len);
+    compressedLen = compressor.finish();
+    if (stats) {
+        stats->inputBytes = (uint32_t)len;
+        stats->outputBytes = (uint32_t)compressedLen;
+        stats->micros = wsnMicros() - start;
+    }
+    if (!compressedLen || compressedLen >= len) {
+        free(out);
+        return nullptr;
+    }
+    return out;
+}
+
+// Untuk receiver: pesan LZ -> data asli di heap baru, diakhiri '\0' (pemanggil wajib free()).
+// nullptr jika bukan pesan LZ, rusak, atau heap habis.
+inline uint8_t *wsnLzDecompressAlloc(const uint8_t *data, size_t len, size_t &outLen, WsnLzStats *stats = nullptr) {
+    uint32_t start = wsnMicros();
+    uint32_t total = wsnLzOriginalLength(data, len);
+    if (!total) return nullptr;
+    uint8_t *out = (uint8_t *)malloc((size_t)total + 1);
+    if (out == nullptr) return nullptr;
+    outLen = wsnLzDecompress(data, len, out, total);
+    if (!outLen) {
+        free(out);
+        return nullptr;
+    }
+    out[outLen] = '\0';
+    if (stats) {
+        stats->inputBytes = (uint32_t)len;
+        stats->outputBytes = (uint32_t)outLen;
+        stats->micros = wsnMicros() - start;
+    }
+    return out;
+}
+
+// Daya CPU selama kompresi: ESP8266 aktif ~70 mA @ 3.3 V
+#define WSN_LZ_ACTIVE_POWER_MW 230.0f
+
+// Estimasi energi yang dihemat satu pesan (uJ): byte yang tidak perlu dienkripsi dan
+// dikirim dikali energi marginal per byte, dikurangi energi CPU untuk kompresi.
+// energyPerByteUj dari selisih energi pesan 10 KB dan 5 KB (energy_analysis.py).
+inline float wsnLzEnergySavedUj(const WsnLzStats &stats, float energyPerByteUj,
+                                float activePowerMw = WSN_LZ_ACTIVE_POWER_MW) {
+    float saved = ((float)stats.inputBytes - (float)stats.outputBytes) * energyPerByteUj;
+    return saved - stats.micros * activePowerMw / 1000.0f;
+}
+
+#endif // WSN_LZ_H
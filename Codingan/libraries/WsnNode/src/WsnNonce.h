@@ -0,0 +1,205 @@
+#ifndef WSN_NONCE_H
+#define WSN_NONCE_H
+
+// Nonce/IV per pesan dari counter pesan + ID node, pengganti random() per byte.
+//
+// Layout nonce (little-endian): [0, 4) ID node, [4, 12) counter 64 bit, sisanya nol. Nonce unik
+// selama satu kunci tidak dipakai dua node dengan ID sama. Counter tidak pernah mundur:
+//   - RTC memory (WSN_RTC_NONCE_OFFSET) menyimpan nilai berikutnya setiap kali nonce dibuat,
+//     sebelum nonce dipakai; bangun dari deep sleep, ESP.restart() dan watchdog reset lanjut
+//     tanpa celah dan tanpa tulis flash.
+//   - Flash (EEPROM) menyimpan batas atas blok: sebelum nilai pertama blok checkpointInterval
+//     dipakai, akhir blok ditulis dulu. Setelah power off counter mulai dari batas itu, jadi
+//     paling banyak checkpointInterval nilai terlewat dan tidak ada yang terulang.
+// Tulis flash = 1 per checkpointInterval pesan (+1 setelah power on), tidak tergantung jumlah
+// deep sleep. Dengan 1 pesan per 2 detik dan interval 1024: sekali per ~34 menit.
+//
+// ChaCha20 (12 byte) dan Snow-V (16 byte) memakai nonce langsung. IV mode CBC (AES-256,
+// Clefia) harus tidak bisa ditebak: blok nonce dienkripsi dulu dengan kunci pesan
+// (NIST SP 800-38A lampiran C), lihat sketch.
+
+#include "WsnPlatform.h"
+#include "WsnFraming.h"
+
+#if defined(ESP8266) || defined(ESP32)
+#include <EEPROM.h>
+#endif
+
+#define WSN_NONCE_SIZE 12
+#define WSN_NONCE_MAGIC 0x3257U           // "W2"
+#define WSN_NONCE_MAGIC_V1 0x314E5357UL  // "WSN1", record lama dengan counter 48 bit
+
+// ID node default: chip ID ESP8266 / 32 bit bawah MAC efuse ESP32
+inline uint32_t wsnNodeId() {
+#if defined(ESP8266)
+    return ESP.getChipId();
+#elif defined(ESP32)
+    return (uint32_t)ESP.getEfuseMac();
+#else
+    return 1;
+#endif
+}
+
+// Satu record, di RTC (nilai berikutnya) maupun di flash (batas atas blok)
+struct WsnNonceRecord {
+    uint16_t magic;
+    uint16_t crc;          // CRC-16 field setelah ini
+    uint32_t nodeId;
+    uint32_t counterLow;
+    uint32_t counterHigh;  // counter 64 bit, sama lebarnya dengan counter di nonce
+};
+
+// Format record sebelum counter 64 bit. Hanya dibaca: firmware lama yang diperbarui tetap
+// melanjutkan counter-nya, record berikutnya ditulis dalam format baru.
+struct WsnNonceRecordV1 {
+    uint32_t magic;
+    uint32_t nodeId;
+    uint32_t counterLow;
+    uint16_t counterHigh;
+    uint16_t crc;          // CRC-16 field sebelumnya
+};
+
+static_assert(sizeof(WsnNonceRecord) == 16, "record nonce harus muat di slot RTC 16 byte");
+static_assert(sizeof(WsnNonceRecordV1) == sizeof(WsnNonceRecord), "record lama dan baru berbagi slot");
+
+#if !defined(ESP8266) && !defined(ESP32)
+// Host: flash tiruan di RAM, bertahan selama proses agar tool host bisa mensimulasikan power off
+inline uint8_t *wsnNonceFlashMemory() {
+    static uint8_t memory[64];
+    return memory;
+}
+#endif
+
+// Flash: EEPROM emulasi (ESP8266: satu sektor flash, ESP32: NVS). offset dalam byte
+inline void wsnNonceFlashRead(uint32_t offset, WsnNonceRecord &record) {
+#if defined(ESP8266) || defined(ESP32)
+    EEPROM.begin(offset + sizeof(record));
+    EEPROM.get(offset, record);
+#else
+    memcpy(&record, wsnNonceFlashMemory() + offset, sizeof(record));
+#endif
+}
+
+inline bool wsnNonceFlashWrite(uint32_t offset, const WsnNonceRecord &record) {
+#if defined(ESP8266) || defined(ESP32)
+    EEPROM.begin(offset + sizeof(record));
+    EEPROM.put(offset, record);
+    return EEPROM.commit();
+#else
+    if (offset + sizeof(record) > 64) return false;
+    memcpy(wsnNonceFlashMemory() + offset, &record, sizeof(record));
+    return true;
+#endif
+}
+
+struct WsnNonceConfig {
+    uint32_t nodeId = 0;                // 0 = wsnNodeId()
+    uint32_t checkpointInterval = 1024; // nonce per tulis flash
+    uint32_t flashOffset = 0;           // byte di EEPROM
+    uint32_t rtcOffset = WSN_RTC_NONCE_OFFSET;
+};
+
+struct WsnNonceStats {
+    uint32_t issued;       // nonce sejak begin()
+    uint32_t flashWrites;
+    bool fromRtc;          // begin() melanjutkan dari RTC memory, bukan dari flash
+};
+
+class WsnNonceManager {
+public:
+    explicit WsnNonceManager(const WsnNonceConfig &config = WsnNonceConfig()) : config(config) {
+        if (this->config.nodeId == 0) this->config.nodeId = wsnNodeId();
+        if (this->config.checkpointInterval == 0) this->config.checkpointInterval = 1;
+        memset(&counters, 0, sizeof(counters));
+    }
+
+    // Awal setup(): lanjut dari RTC jika valid, selain itu dari batas atas blok di flash
+    void begin() {
+        WsnNonceRecord record;
+        uint64_t stored = 0;
+        wsnNonceFlashRead(config.flashOffset, record);
+        decode(record, stored);
+        ceiling = stored;
+
+        // RTC berisi nilai berikutnya yang persis. Jika lebih besar dari flash (mis. flash dihapus),
+        // next() langsung menulis checkpoint baru. Power off: semua nilai sampai batas atas blok
+        // mungkin sudah terpakai, mulai dari batas itu.
+        uint64_t next = 0;
+        counters.fromRtc = wsnRtcRead(config.rtcOffset, &record, sizeof(record)) && decode(record, next);
+        counterValue = counters.fromRtc ? next : stored;
+    }
+
+    // Mengisi nonce (len >= WSN_NONCE_SIZE, sisa byte nol) dan memajukan counter.
+    // false jika checkpoint flash gagal ditulis atau counter habis (2^64 - 1 nonce); nonce tidak
+    // diberikan agar tidak bisa terulang.
+    bool next(uint8_t *nonce, size_t len) {
+        if (len < WSN_NONCE_SIZE || counterValue == UINT64_MAX) return false;
+        if (counterValue >= ceiling) {
+            uint64_t end = counterValue > UINT64_MAX - config.checkpointInterval
+                               ? UINT64_MAX
+                               : counterValue + config.checkpointInterval;
+            if (!checkpoint(end)) return false;
+        }
+
+        wsnStore32(nonce, config.nodeId);
+        wsnStore32(nonce + 4, (uint32_t)counterValue);
+        wsnStore32(nonce + 8, (uint32_t)(counterValue >> 32));
+        memset(nonce + WSN_NONCE_SIZE, 0, len - WSN_NONCE_SIZE);
+
+        counterValue++;
+        WsnNonceRecord record = makeRecord(counterValue);
+        wsnRtcWrite(config.rtcOffset, &record, sizeof(record));
+        counters.issued++;
+        return true;
+    }
+
+    uint64_t counter() const { return counterValue; }  // nilai nonce berikutnya
+    uint32_t nodeId() const { return config.nodeId; }
+    const WsnNonceStats &stats() const { return counters; }
+
+private:
+    WsnNonceRecord makeRecord(uint64_t v) const {
+        WsnNonceRecord record;
+        record.magic = WSN_NONCE_MAGIC;
+        record.nodeId = config.nodeId;
+        record.counterLow = (uint32_t)v;
+        record.counterHigh = (uint32_t)(v >> 32);
+        record.crc = recordCrc(record);
+        return record;
+    }
+
+    static uint16_t recordCrc(const WsnNonceRecord &record) {
+        return wsnCrc16((const uint8_t *)&record.nodeId, sizeof(record) - offsetof(WsnNonceRecord, nodeId));
+    }
+
+    // Nilai counter dari record format baru atau lama; false jika kosong, rusak atau node lain
+    bool decode(const WsnNonceRecord &record, uint64_t &v) const {
+        if (record.magic == WSN_NONCE_MAGIC && record.crc == recordCrc(record)) {
+            if (record.nodeId != config.nodeId) return false;
+            v = (uint64_t)record.counterHigh << 32 | record.counterLow;
+            return true;
+        }
+        WsnNonceRecordV1 old;
+        memcpy(&old, &record, sizeof(old));
+        if (old.magic != WSN_NONCE_MAGIC_V1 || old.nodeId != config.nodeId ||
+            old.crc != wsnCrc16((const uint8_t *)&old, offsetof(WsnNonceRecordV1, crc))) {
+            return false;
+        }
+        v = (uint64_t)old.counterHigh << 32 | old.counterLow;
+        return true;
+    }
+
+    bool checkpoint(uint64_t newCeiling) {
+        if (!wsnNonceFlashWrite(config.flashOffset, makeRecord(newCeiling))) return false;
+        ceiling = newCeiling;
+        counters.flashWrites++;
+        return true;
+    }
+
+    WsnNonceConfig config;
+    WsnNonceStats counters;
+    uint64_t counterValue = 0;
+    uint64_t ceiling = 0;  // batas atas blok yang sudah tercatat di flash
+};
+
+#endif // WSN_NONCE_H
@@ -0,0 +1,200 @@
+#ifndef WSN_PAYLOAD_H
+#define WSN_PAYLOAD_H
+
+// Sumber plaintext untuk sender dan benchmark, dibaca bertahap (chunk) lewat satu antarmuka.
+//
+//   WsnFlashPayload   dataset teks tetap yang disimpan di flash (WSN_PROGMEM), tidak disalin ke DRAM
+//   WsnStreamPayload  file SPIFFS/LittleFS/SD (objek apa saja dengan read/size/seek)
+//   WsnDht22Payload   urutan "TT.TT,HH.HH" sintetis mirip data sensor/dht22_data.txt, ukuran bebas
+//
+// Generator deterministik: seed dan ukuran yang sama selalu menghasilkan byte yang sama,
+// sehingga receiver/host bisa memverifikasi hasil dekripsi tanpa menyimpan dataset.
+
+#include "WsnPlatform.h"
+
+class WsnPayloadSource {
+public:
+    virtual ~WsnPayloadSource() {}
+
+    // Total byte yang akan dihasilkan dari awal
+    virtual size_t size() const = 0;
+    // Mengisi sampai maxLen byte berikutnya; 0 berarti habis
+    virtual size_t read(uint8_t *buf, size_t maxLen) = 0;
+    virtual void rewind() = 0;
+};
+
+// Membaca seluruh sisa sumber ke buf (maksimal len byte); mengembalikan byte yang terbaca
+inline size_t wsnPayloadReadAll(WsnPayloadSource &source, uint8_t *buf, size_t len) {
+    size_t total = 0;
+    while (total < len) {
+        size_t n = source.read(buf + total, len - total);
+        if (!n) break;
+        total += n;
+    }
+    return total;
+}
+
+// Plaintext satu siklus sebagai string di heap (diakhiri '\0'), dari awal sumber.
+// Pemanggil wajib free(); nullptr jika heap tidak cukup.
+inline char *wsnPayloadLoadText(WsnPayloadSource &source) {
+    size_t len = source.size();
+    char *text = (char *)malloc(len + 1);
+    if (text == nullptr) return nullptr;
+    source.rewind();
+    text[wsnPayloadReadAll(source, (uint8_t *)text, len)] = '\0';
+    return text;
+}
+
+// Dataset tetap di flash. data harus dideklarasikan dengan WSN_PROGMEM:
+//   static const char dataset[] WSN_PROGMEM = "...";
+//   WsnFlashPayload payload(dataset, sizeof(dataset) - 1);
+class WsnFlashPayload : public WsnPayloadSource {
+public:
+    WsnFlashPayload(const char *data, size_t len) : data(data), len(len) {}
+
+    size_t size() const override { return len; }
+
+    size_t read(uint8_t *buf, size_t maxLen) override {
+        size_t n = len - position < maxLen ? len - position : maxLen;
+        wsnCopyFromFlash(buf, data + position, n);
+        position += n;
+        return n;
+    }
+
+    void rewind() override { position = 0; }
+
+private:
+    const char *data;
+    size_t len;
+    size_t position = 0;
+};
+
+// File apa saja dengan size(), read(uint8_t *, size_t) dan seek(0): fs::File di ESP, File SD
+template <typename File>
+class WsnStreamPayload : public WsnPayloadSource {
+public:
+    explicit WsnStreamPayload(File &file) : file(file) {}
+
+    size_t size() const override { return file.size(); }
+    size_t read(uint8_t *buf, size_t maxLen) override { return file.read(buf, maxLen); }
+    void rewind() override { file.seek(0); }
+
+private:
+    File &file;
+};
+
+// Parameter random walk; default diambil dari data sensor/dht22_data.txt (566 sampel, ruangan):
+// suhu 30.4..30.8 C dan jarang berubah (~1% sampel), kelembapan 70.6..77.2 %RH (~4% sampel).
+struct WsnDht22Model {
+    int16_t temperature10 = 308;    // nilai awal, 0.1 C
+    int16_t humidity10 = 738;       // nilai awal, 0.1 %RH
+    int16_t temperatureMin10 = 290;
+    int16_t temperatureMax10 = 330;
+    int16_t humidityMin10 = 600;
+    int16_t humidityMax10 = 850;
+    uint16_t temperatureChangePerMille = 10;
+    uint16_t humidityChangePerMille = 40;
+    uint8_t temperatureMaxStep10 = 4;  // perubahan terbesar per sampel, 0.1 C
+    uint8_t humidityMaxStep10 = 17;
+};
+
+// Menghasilkan tepat `len` byte: prefix lalu rekaman "TT.TT,HH.HH" berurutan tanpa pemisah,
+// sama dengan format plaintext10kb/plaintext5kb lama. Rekaman terakhir bisa terpotong.
+class WsnDht22Payload : public WsnPayloadSource {
+public:
+    static const size_t RECORD_SIZE = 11;
+
+    WsnDht22Payload(size_t len, uint32_t seed = 1, const char *prefix = "Data Suhu: ",
+                    const WsnDht22Model &model = WsnDht22Model())
+        : len(len), seed(seed ? seed : 1), prefix(prefix), model(model) {
+        rewind();
+    }
+
+    void resize(size_t newLen) {
+        len = newLen;
+        rewind();
+    }
+
+    size_t size() const override { return len; }
+
+    size_t read(uint8_t *buf, size_t maxLen) override {
+        size_t n = 0;
+        while (n < maxLen && position < len) {
+            if (recordPos == recordLen) nextRecord();
+            size_t take = recordLen - recordPos;
+            if (take > maxLen - n) take = maxLen - n;
+            if (take > len - position) take = len - position;
+            memcpy(buf + n, record + recordPos, take);
+            recordPos += take;
+            position += take;
+            n += take;
+        }
+        return n;
+    }
+
+    void rewind() override {
+        position = 0;
+        state = seed;
+        temperature10 = model.temperature10;
+        humidity10 = model.humidity10;
+        recordLen = prefix ? strlen(prefix) : 0;
+        if (recordLen > sizeof(record)) recordLen = sizeof(record);
+        if (recordLen) memcpy(record, prefix, recordLen);
+        recordPos = 0;
+        firstRecord = true;
+    }
+
+    // Nilai rekaman terakhir yang dihasilkan (untuk codec biner / verifikasi)
+    int16_t temperature() const { return temperature10; }
+    int16_t humidity() const { return humidity10; }
+
+private:
+    // xorshift32: cukup untuk data uji, bukan untuk kriptografi
+    uint32_t nextRandom() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    int16_t step(int16_t value, uint16_t perMille, uint8_t maxStep, int16_t lo, int16_t hi) {
+        if (nextRandom() % 1000 >= perMille) return value;
+        // Langkah kecil jauh lebih sering daripada lompatan besar
+        uint32_t r = nextRandom();
+        int magnitude = 1 + (int)((r >> 8) % maxStep) * (int)((r >> 24) % maxStep) / maxStep;
+        int16_t next = (int16_t)(value + ((r & 1) ? magnitude : -magnitude));
+        if (next < lo || next > hi) next = (int16_t)(value - (next - value));
+        return next;
+    }
+
+    void nextRecord() {
+        if (!firstRecord) {
+            temperature10 = step(temperature10, model.temperatureChangePerMille, model.temperatureMaxStep10,
+                                 model.temperatureMin10, model.temperatureMax10);
+            humidity10 = step(humidity10, model.humidityChangePerMille, model.humidityMaxStep10,
+                              model.humidityMin10, model.humidityMax10);
+        }
+        firstRecord = false;
+        // DHT22 beresolusi 0.1; ditulis dua desimal seperti Serial.print(float) di sketch pengambil data
+        snprintf(record, sizeof(record), "%02d.%d0,%02d.%d0", temperature10 / 10, temperature10 % 10,
+                 humidity10 / 10, humidity10 % 10);
+        recordLen = RECORD_SIZE;
+        recordPos = 0;
+    }
+
+    size_t len;
+    uint32_t seed;
+    const char *prefix;
+    WsnDht22Model model;
+
+    size_t position;
+    uint32_t state;
+    int16_t temperature10;
+    int16_t humidity10;
+    char record[32];  // prefix atau satu rekaman
+    size_t recordLen;
+    size_t recordPos;
+    bool firstRecord;
+};
+
+#endif // WSN_PAYLOAD_H
@@ -0,0 +1,258 @@
+#ifndef WSN_PLATFORM_H
+#define WSN_PLATFORM_H
+
+// Lapisan tipis antara sketch ESP8266/ESP32 dan host (Linux).
+// Semua header WsnNode hanya bergantung pada file ini, sehingga kode cipher
+// yang sama bisa dipakai di node maupun di tool host (code/host).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#if defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#endif
+#define WSN_PROGMEM PROGMEM
+#define wsnReadByte(p) pgm_read_byte(p)
+#define wsnReadDword(p) pgm_read_dword(p)
+#define wsnCopyFromFlash(dst, src, n) memcpy_P(dst, src, n)
+#if defined(ESP8266)
+#define WSN_HOT ICACHE_RAM_ATTR
+#elif defined(ESP32)
+#define WSN_HOT IRAM_ATTR
+#else
+#define WSN_HOT
+#endif
+
+inline uint32_t wsnMicros() { return micros(); }
+inline uint32_t wsnMillis() { return millis(); }
+
+// Register CCOUNT Xtensa, 32 bit (wrap ~53 s di 80 MHz); cukup untuk selisih per operasi
+typedef uint32_t wsn_cycles_t;
+
+inline wsn_cycles_t wsnCycleCount() { return ESP.getCycleCount(); }
+inline uint32_t wsnCpuMhz() { return ESP.getCpuFreqMHz(); }
+// Beri kesempatan WiFi stack/watchdog di antara pengukuran panjang
+inline void wsnYield() { yield(); }
+
+// Critical section pendek untuk data yang juga disentuh callback ESP-NOW / task lain
+class WsnCriticalSection {
+public:
+#if defined(ESP32)
+    WsnCriticalSection() { portENTER_CRITICAL(&mux()); }
+    ~WsnCriticalSection() { portEXIT_CRITICAL(&mux()); }
+
+private:
+    static portMUX_TYPE &mux() {
+        static portMUX_TYPE m = portMUX_INITIALIZER_UNLOCKED;
+        return m;
+    }
+#elif defined(ESP8266)
+    WsnCriticalSection() : saved(xt_rsil(15)) {}
+    ~WsnCriticalSection() { xt_wsr_ps(saved); }
+
+private:
+    uint32_t saved;
+#else
+    WsnCriticalSection() { noInterrupts(); }
+    ~WsnCriticalSection() { interrupts(); }
+#endif
+};
+
+// Random dari RNG hardware (ESP8266: RANDOM_REG32, ESP32: esp_fill_random). Hanya benar-benar
+// acak saat radio WiFi menyala; panggil setelah WiFi.mode()
+inline void wsnRandomBytes(uint8_t *out, size_t len) {
+#if defined(ESP8266)
+    ESP.random(out, len);
+#elif defined(ESP32)
+    esp_fill_random(out, len);
+#else
+    for (size_t i = 0; i < len; i++) out[i] = (uint8_t)random(256);
+#endif
+}
+
+inline const char *wsnPlatformName() {
+#if defined(ESP8266)
+    return "esp8266";
+#elif defined(ESP32)
+    return "esp32";
+#else
+    return "arduino";
+#endif
+}
+
+#else  // Host
+
+#include <chrono>
+#include <random>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define WSN_PROGMEM
+#define wsnReadByte(p) (*(const uint8_t *)(p))
+#define wsnReadDword(p) (*(const uint32_t *)(p))
+#define wsnCopyFromFlash(dst, src, n) memcpy(dst, src, n)
+#define WSN_HOT
+
+inline uint32_t wsnMicros() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint32_t wsnMillis() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// x86: TSC (frekuensi nominal, bukan clock inti saat turbo); arsitektur lain: nanodetik
+typedef uint64_t wsn_cycles_t;
+
+inline wsn_cycles_t wsnCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Frekuensi wsnCycleCount dalam MHz, dikalibrasi sekali terhadap steady_clock
+inline uint32_t wsnCpuMhz() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const uint32_t mhz = [] {
+        using namespace std::chrono;
+        auto t0 = steady_clock::now();
+        wsn_cycles_t c0 = wsnCycleCount();
+        std::this_thread::sleep_for(milliseconds(50));
+        wsn_cycles_t c1 = wsnCycleCount();
+        double us = duration_cast<nanoseconds>(steady_clock::now() - t0).count() / 1000.0;
+        uint32_t rate = (uint32_t)((c1 - c0) / us + 0.5);
+        return rate ? rate : 1u;
+    }();
+    return mhz;
+#else
+    return 1000;
+#endif
+}
+
+inline void wsnYield() {}
+
+// Tool host memanggil library dari satu thread
+class WsnCriticalSection {
+public:
+    WsnCriticalSection() {}
+};
+
+inline void wsnRandomBytes(uint8_t *out, size_t len) {
+    static std::random_device device;
+    for (size_t i = 0; i < len; i++) out[i] = (uint8_t)device();
+}
+
+inline const char *wsnPlatformName() { return "host"; }
+
+// Pengganti Serial di host untuk fungsi yang menulis lewat out.print(const char *)
+struct WsnStdout {
+    FILE *file = stdout;
+    void print(const char *text) { fputs(text, file); }
+    size_t write(const uint8_t *data, size_t len) { return fwrite(data, 1, len, file); }
+    int availableForWrite() { return 4096; }
+};
+
+#endif
+
+// RTC memory: bertahan selama deep sleep, hilang saat power off. offset dan size dalam byte,
+// kelipatan 4, data harus align 4. ESP8266: 512 byte RTC user memory; ESP32: RTC slow memory
+// (RTC_DATA_ATTR); host dan board lain: RAM biasa (untuk simulasi deep sleep di tool host).
+#define WSN_RTC_SIZE 512
+
+// Tata letak RTC memory untuk header WsnNode (byte):
+//   [0, 48)    WsnRtcState, WsnSleep.h
+//   [48, 64)   counter nonce, WsnNonce.h
+//   [64, 128)  WsnReportPolicy
+//   [128, 512) WsnBatch, maksimal WSN_BATCH_RTC_CAPACITY pembacaan
+#define WSN_RTC_STATE_OFFSET 0
+#define WSN_RTC_NONCE_OFFSET 48
+#define WSN_RTC_POLICY_OFFSET 64
+#define WSN_RTC_BATCH_OFFSET 128
+
+#if defined(ESP8266)
+inline bool wsnRtcRead(uint32_t offset, void *data, size_t size) {
+    return ESP.rtcUserMemoryRead(offset / 4, (uint32_t *)data, size);
+}
+
+inline bool wsnRtcWrite(uint32_t offset, const void *data, size_t size) {
+    return ESP.rtcUserMemoryWrite(offset / 4, (uint32_t *)data, size);
+}
+#else
+#if defined(ESP32)
+#define WSN_RTC_ATTR RTC_DATA_ATTR
+#else
+#define WSN_RTC_ATTR
+#endif
+
+inline uint8_t *wsnRtcMemory() {
+    static WSN_RTC_ATTR uint32_t memory[WSN_RTC_SIZE / 4];
+    return (uint8_t *)memory;
+}
+
+inline bool wsnRtcRead(uint32_t offset, void *data, size_t size) {
+    if (offset % 4 || offset > WSN_RTC_SIZE || size > WSN_RTC_SIZE - offset) return false;
+    memcpy(data, wsnRtcMemory() + offset, size);
+    return true;
+}
+
+inline bool wsnRtcWrite(uint32_t offset, const void *data, size_t size) {
+    if (offset % 4 || offset > WSN_RTC_SIZE || size > WSN_RTC_SIZE - offset) return false;
+    memcpy(wsnRtcMemory() + offset, data, size);
+    return true;
+}
+#endif
+
+// Little-endian load/store tanpa asumsi alignment (Xtensa tidak boleh unaligned load)
+inline uint32_t wsnLoad32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline void wsnStore32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Big-endian 64 bit (GHASH, ASCON)
+inline uint64_t wsnLoad64Be(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+inline void wsnStore64Be(uint8_t *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+inline uint32_t wsnRotl32(uint32_t x, int s) {
+    return (x << s) | (x >> (32 - s));
+}
+
+inline uint32_t wsnRotr32(uint32_t x, int s) {
+    return (x >> s) | (x << (32 - s));
+}
+
+// Perbandingan tag waktu-konstan
+inline bool wsnTagEqual(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+    return diff == 0;
+}
+
+#endif // WSN_PLATFORM_H
@@ -0,0 +1,129 @@
+#ifndef WSN_PROFILE_H
+#define WSN_PROFILE_H
+
+// Profiler scope berbasis cycle counter (CCOUNT di Xtensa, TSC di host).
+//
+// Aktifkan dengan #define WSN_PROFILE 1 sebelum include header WsnNode mana pun.
+// Tanpa itu semua makro di bawah kosong dan tidak ada tabel/kode yang ikut dikompilasi.
+//
+//   void encryptMessage(...) {
+//       WSN_PROFILE_SCOPE(WSN_PROF_ENCRYPT);
+//       ...
+//   }
+//   if (Serial.read() == 'p') WSN_PROFILE_DUMP(Serial);
+//
+// Setiap scope menyimpan count, min, max, total siklus dan histogram log2 di tabel
+// statis berukuran tetap (tanpa malloc, aman dipanggil dari callback ESP-NOW).
+// Scope bersarang dihitung inklusif: waktu XOR juga masuk ke ENCRYPT.
+
+#include "WsnPlatform.h"
+
+#ifndef WSN_PROFILE
+#define WSN_PROFILE 0
+#endif
+
+enum WsnProfileScope {
+    WSN_PROF_KEY_SETUP,
+    WSN_PROF_KEYSTREAM,
+    WSN_PROF_XOR,
+    WSN_PROF_ENCRYPT,
+    WSN_PROF_DECRYPT,
+    WSN_PROF_FRAGMENT,
+    WSN_PROF_ESPNOW_SEND,
+    WSN_PROF_SEND_CALLBACK,
+    WSN_PROF_RECV_CALLBACK,
+    WSN_PROF_SD_WRITE,
+    WSN_PROF_USER0,
+    WSN_PROF_USER1,
+    WSN_PROF_SCOPE_COUNT
+};
+
+#if WSN_PROFILE
+
+#define WSN_PROFILE_BUCKETS 24  // bucket i: [2^i, 2^(i+1)) siklus, bucket terakhir >= 2^23
+
+static const char *const wsnProfileNames[WSN_PROF_SCOPE_COUNT] = {
+    "key_setup", "keystream", "xor", "encrypt", "decrypt", "fragment",
+    "espnow_send", "send_cb", "recv_cb", "sd_write", "user0", "user1",
+};
+
+struct WsnProfileEntry {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t histogram[WSN_PROFILE_BUCKETS];
+};
+
+// Satu tabel untuk seluruh program (static lokal di fungsi inline dibagi antar translation unit)
+inline WsnProfileEntry *wsnProfileTable() {
+    static WsnProfileEntry table[WSN_PROF_SCOPE_COUNT];
+    return table;
+}
+
+inline void wsnProfileReset() {
+    memset(wsnProfileTable(), 0, sizeof(WsnProfileEntry) * WSN_PROF_SCOPE_COUNT);
+}
+
+inline void WSN_HOT wsnProfileRecord(WsnProfileScope scope, uint32_t cycles) {
+    WsnProfileEntry &e = wsnProfileTable()[scope];
+    if (e.count == 0 || cycles < e.minCycles) e.minCycles = cycles;
+    if (cycles > e.maxCycles) e.maxCycles = cycles;
+    e.count++;
+    e.totalCycles += cycles;
+    int bucket = cycles ? 31 - __builtin_clz(cycles) : 0;
+    e.histogram[bucket < WSN_PROFILE_BUCKETS ? bucket : WSN_PROFILE_BUCKETS - 1]++;
+}
+
+class WsnProfileGuard {
+public:
+    explicit WsnProfileGuard(WsnProfileScope scope) : scope(scope), start(wsnCycleCount()) {}
+    ~WsnProfileGuard() { wsnProfileRecord(scope, (uint32_t)(wsnCycleCount() - start)); }
+
+private:
+    WsnProfileScope scope;
+    wsn_cycles_t start;
+};
+
+// Satu baris per scope yang pernah tercatat, lalu histogram non-nol sebagai "bucket:count"
+template <typename Out>
+void wsnProfileDump(Out &out) {
+    char line[160];
+    double mhz = wsnCpuMhz();
+    snprintf(line, sizeof(line), "# profile %s %u MHz\n# scope,count,min_cyc,mean_cyc,max_cyc,mean_us,total_ms\n",
+             wsnPlatformName(), (unsigned)mhz);
+    out.print(line);
+    for (int s = 0; s < WSN_PROF_SCOPE_COUNT; s++) {
+        const WsnProfileEntry &e = wsnProfileTable()[s];
+        if (!e.count) continue;
+        double mean = (double)e.totalCycles / e.count;
+        snprintf(line, sizeof(line), "%s,%lu,%lu,%.1f,%lu,%.3f,%.3f\n", wsnProfileNames[s], (unsigned long)e.count,
+                 (unsigned long)e.minCycles, mean, (unsigned long)e.maxCycles, mean / mhz,
+                 e.totalCycles / mhz / 1000.0);
+        out.print(line);
+
+        out.print("#  hist");
+        for (int b = 0; b < WSN_PROFILE_BUCKETS; b++) {
+            if (!e.histogram[b]) continue;
+            snprintf(line, sizeof(line), " %d:%lu", b, (unsigned long)e.histogram[b]);
+            out.print(line);
+        }
+        out.print("\n");
+    }
+}
+
+#define WSN_PROFILE_CONCAT_(a, b) a##b
+#define WSN_PROFILE_CONCAT(a, b) WSN_PROFILE_CONCAT_(a, b)
+#define WSN_PROFILE_SCOPE(scope) WsnProfileGuard WSN_PROFILE_CONCAT(wsnProfileGuard_, __LINE__)(scope)
+#define WSN_PROFILE_DUMP(out) wsnProfileDump(out)
+#define WSN_PROFILE_RESET() wsnProfileReset()
+
+#else
+
+#define WSN_PROFILE_SCOPE(scope) do {} while (0)
+#define WSN_PROFILE_DUMP(out) do {} while (0)
+#define WSN_PROFILE_RESET() do {} while (0)
+
+#endif // WSN_PROFILE
+
+#endif // WSN_PROFILE_H
@@ -0,0 +1,236 @@
+#ifndef WSN_REPORT_POLICY_H
+#define WSN_REPORT_POLICY_H
+
+// Kebijakan pelaporan berbasis perubahan di node sensor, dievaluasi sebelum enkripsi.
+//
+// Pesan hanya dienkripsi dan dikirim jika:
+//   - pembacaan pertama,
+//   - keluar/masuk batas alarm (langsung, tanpa menunggu deadband),
+//   - suhu atau kelembapan bergeser lebih dari deadband dari nilai yang terakhir DILAPORKAN
+//     (bukan sampel terakhir, jadi perubahan lambat tetap terakumulasi),
+//   - sudah heartbeatMs tanpa laporan (receiver tahu node masih hidup).
+// Selain itu siklus dilewati dan dicatat sebagai enkripsi serta wake-up radio yang dihindari.
+//
+// Nilai dalam perseratus (3080 = 30.80), sama dengan WsnSensorCodec.h.
+
+#include "WsnPlatform.h"
+#include "WsnFraming.h"
+#include "WsnLog.h"
+#include "WsnPayload.h"
+
+#define WSN_REPORT_RTC_MAGIC 0x31505357UL  // "WSP1"
+
+enum WsnReportReason : uint8_t {
+    WSN_REPORT_NONE = 0,  // dilewati
+    WSN_REPORT_FIRST,
+    WSN_REPORT_ALARM,
+    WSN_REPORT_CHANGE,
+    WSN_REPORT_HEARTBEAT,
+    WSN_REPORT_REASON_COUNT
+};
+
+inline const char *wsnReportReasonName(WsnReportReason reason) {
+    static const char *const names[WSN_REPORT_REASON_COUNT] = {"skip", "first", "alarm", "change", "heartbeat"};
+    return reason < WSN_REPORT_REASON_COUNT ? names[reason] : "?";
+}
+
+// Default deadband sekitar resolusi efektif DHT22; alarm mati sampai batasnya diisi sketch
+struct WsnReportConfig {
+    int16_t temperatureDeadband = 10;   // 0.10 C
+    int16_t humidityDeadband = 50;      // 0.50 %RH
+    uint32_t heartbeatMs = 60000;
+    int16_t temperatureAlarmLow = INT16_MIN;
+    int16_t temperatureAlarmHigh = INT16_MAX;
+    int16_t humidityAlarmLow = INT16_MIN;
+    int16_t humidityAlarmHigh = INT16_MAX;
+};
+
+struct WsnReportStats {
+    uint32_t samples;
+    uint32_t reports[WSN_REPORT_REASON_COUNT];  // reports[WSN_REPORT_NONE] = sampel yang dilewati
+    uint32_t encryptAvoided;
+    uint32_t radioWakeupsAvoided;  // frame ESP-NOW yang tidak jadi dikirim
+};
+
+class WsnReportPolicy {
+public:
+    explicit WsnReportPolicy(const WsnReportConfig &config = WsnReportConfig()) : config(config) { reset(); }
+
+    void reset() {
+        memset(&counters, 0, sizeof(counters));
+        reported = false;
+        inAlarm = false;
+    }
+
+    WsnReportReason evaluate(int16_t temperature, int16_t humidity, uint32_t nowMs) {
+        counters.samples++;
+        bool alarm = temperature < config.temperatureAlarmLow || temperature > config.temperatureAlarmHigh ||
+                     humidity < config.humidityAlarmLow || humidity > config.humidityAlarmHigh;
+
+        WsnReportReason reason = WSN_REPORT_NONE;
+        if (!reported) reason = WSN_REPORT_FIRST;
+        else if (alarm != inAlarm) reason = WSN_REPORT_ALARM;
+        else if (distance(temperature, lastTemperature) > config.temperatureDeadband ||
+                 distance(humidity, lastHumidity) > config.humidityDeadband) reason = WSN_REPORT_CHANGE;
+        else if (nowMs - lastReportMs >= config.heartbeatMs) reason = WSN_REPORT_HEARTBEAT;
+        inAlarm = alarm;
+
+        counters.reports[reason]++;
+        if (reason == WSN_REPORT_NONE) {
+            counters.encryptAvoided++;
+            counters.radioWakeupsAvoided += framesPerReport;
+        } else {
+            reported = true;
+            lastTemperature = temperature;
+            lastHumidity = humidity;
+            lastReportMs = nowMs;
+        }
+        return reason;
+    }
+
+    // Jumlah frame pesan yang terakhir dikirim; satu siklus yang dilewati menghemat sebanyak ini
+    void setFramesPerReport(uint32_t frames) { framesPerReport = frames; }
+
+    bool alarmActive() const { return inAlarm; }
+    const WsnReportStats &stats() const { return counters; }
+
+    // State dan counter ke/dari RTC memory agar kebijakan berlanjut setelah deep sleep.
+    // offset dalam byte (lihat wsnRtcWrite); loadRtc false jika kosong/rusak.
+    bool saveRtc(uint32_t offset) const {
+        Snapshot snapshot;
+        memset(&snapshot, 0, sizeof(snapshot));
+        snapshot.magic = WSN_REPORT_RTC_MAGIC;
+        snapshot.reported = reported;
+        snapshot.inAlarm = inAlarm;
+        snapshot.lastTemperature = lastTemperature;
+        snapshot.lastHumidity = lastHumidity;
+        snapshot.lastReportMs = lastReportMs;
+        snapshot.framesPerReport = framesPerReport;
+        snapshot.counters = counters;
+        snapshot.crc = snapshotCrc(snapshot);
+        return wsnRtcWrite(offset, &snapshot, sizeof(snapshot));
+    }
+
+    bool loadRtc(uint32_t offset) {
+        Snapshot snapshot;
+        if (!wsnRtcRead(offset, &snapshot, sizeof(snapshot)) || snapshot.magic != WSN_REPORT_RTC_MAGIC ||
+            snapshot.crc != snapshotCrc(snapshot)) {
+            return false;
+        }
+        reported = snapshot.reported;
+        inAlarm = snapshot.inAlarm;
+        lastTemperature = snapshot.lastTemperature;
+        lastHumidity = snapshot.lastHumidity;
+        lastReportMs = snapshot.lastReportMs;
+        framesPerReport = snapshot.framesPerReport;
+        counters = snapshot.counters;
+        return true;
+    }
+
+private:
+    struct Snapshot {
+        uint32_t magic;
+        uint16_t crc;
+        uint8_t reported;
+        uint8_t inAlarm;
+        int16_t lastTemperature;
+        int16_t lastHumidity;
+        uint32_t lastReportMs;
+        uint32_t framesPerReport;
+        WsnReportStats counters;
+    };
+
+    static uint16_t snapshotCrc(const Snapshot &snapshot) {
+        const uint8_t *p = &snapshot.reported;
+        return wsnCrc16(p, sizeof(snapshot) - (size_t)(p - (const uint8_t *)&snapshot));
+    }
+
+    static int32_t distance(int16_t a, int16_t b) {
+        int32_t d = (int32_t)a - b;
+        return d < 0 ? -d : d;
+    }
+
+    WsnReportConfig config;
+    WsnReportStats counters;
+    bool reported;
+    bool inAlarm;
+    int16_t lastTemperature = 0;
+    int16_t lastHumidity = 0;
+    uint32_t lastReportMs = 0;
+    uint32_t framesPerReport = 1;
+};
+
+// Satu pembacaan dari generator DHT22 (dibuat tanpa prefix), dalam perseratus.
+// Pengganti dht.readTemperature()/readHumidity() di node tanpa sensor terpasang.
+inline void wsnReportSample(WsnDht22Payload &sensor, int16_t &temperature, int16_t &humidity) {
+    uint8_t record[WsnDht22Payload::RECORD_SIZE];
+    if (sensor.read(record, sizeof(record)) < sizeof(record)) {
+        sensor.rewind();
+        sensor.read(record, sizeof(record));
+    }
+    temperature = (int16_t)(sensor.temperature() * 10);
+    humidity = (int16_t)(sensor.humidity() * 10);
+}
+
+// Konfigurasi node sender: deadband default, alarm di atas 32.00 C atau 85.00 %RH
+inline WsnReportConfig wsnReportSenderConfig(uint32_t heartbeatMs) {
+    WsnReportConfig config;
+    config.heartbeatMs = heartbeatMs;
+    config.temperatureAlarmHigh = 3200;
+    config.humidityAlarmHigh = 8500;
+    return config;
+}
+
+struct WsnReportCycle {
+    int16_t temperature;
+    int16_t humidity;
+    WsnReportReason reason;
+    bool send;  // false = siklus dilewati: tanpa enkripsi, radio tidak dinyalakan
+};
+
+// Awal siklus sender: satu pembacaan dari generator DHT22 sintetis (isi pesan tetap dari sumber
+// payload sketch), lalu keputusan kebijakan. policy nullptr = hanya sampling untuk batch, selalu
+// dikirim.
+inline WsnReportCycle wsnReportCycle(WsnReportPolicy *policy, uint32_t nowMs) {
+    static WsnDht22Payload sensor(SIZE_MAX, 7, nullptr);
+    WsnReportCycle cycle;
+    wsnReportSample(sensor, cycle.temperature, cycle.humidity);
+    cycle.reason = policy != nullptr ? policy->evaluate(cycle.temperature, cycle.humidity, nowMs) : WSN_REPORT_NONE;
+    cycle.send = policy == nullptr || cycle.reason != WSN_REPORT_NONE;
+    return cycle;
+}
+
+// Sama, dengan satu baris laporan per siklus ke out (Serial) jika kebijakan aktif
+template <typename Out>
+WsnReportCycle wsnReportCycle(WsnReportPolicy *policy, uint32_t nowMs, Out &out) {
+    WsnReportCycle cycle = wsnReportCycle(policy, nowMs);
+    if (policy != nullptr) {
+        const WsnReportStats &stats = policy->stats();
+        out.print("Report ");
+        out.print(wsnReportReasonName(cycle.reason));
+        out.print(": T ");
+        out.print(cycle.temperature);
+        out.print(" H ");
+        out.print(cycle.humidity);
+        out.print(", dihindari ");
+        out.print(stats.encryptAvoided);
+        out.print(" enkripsi, ");
+        out.print(stats.radioWakeupsAvoided);
+        out.println(" frame");
+    }
+    return cycle;
+}
+
+// Sama, sebagai record WsnLog dengan format
+// "Report %s: T %d H %d, dihindari %u enkripsi, %u frame"
+inline WsnReportCycle wsnReportCycle(WsnReportPolicy *policy, uint32_t nowMs, uint8_t logId) {
+    WsnReportCycle cycle = wsnReportCycle(policy, nowMs);
+    if (policy != nullptr) {
+        const WsnReportStats &stats = policy->stats();
+        wsnLog(logId, wsnReportReasonName(cycle.reason), cycle.temperature, cycle.humidity, stats.encryptAvoided,
+               stats.radioWakeupsAvoided);
+    }
+    return cycle;
+}
+
+#endif // WSN_REPORT_POLICY_H
@@ -0,0 +1,281 @@
+#ifndef WSN_SECURE_LINK_H
+#define WSN_SECURE_LINK_H
+
+// Pipeline sender/receiver generik: cipher, mode, framing dan storage sebagai parameter template.
+//
+//   WsnSecureLink<Cipher, Mode, Framing, Storage>
+//     Cipher   inti cipher dari WsnStream.h (WsnChaCha20Core, WsnSnowVCore, WsnAes256Core, ...)
+//     Mode     WsnKeystreamMode, WsnCbcMode, WsnEcbMode, atau WsnPoly1305Mode (AEAD, tag di
+//              belakang ciphertext: [header][IV][ciphertext][tag], header aplikasi = AAD)
+//     Framing  WsnMessageIvFraming (IV per pesan di depan ciphertext) atau WsnFixedIvFraming,
+//              masing-masing dengan ukuran frame dan byte header aplikasi (mis. ID cipher)
+//     Storage  tujuan plaintext di receiver: WsnNullStorage, WsnFileStorage, WsnDecodedStorage<...>
+//
+// Semua diselesaikan saat compile: enkripsi + fragmentasi satu loop tanpa fungsi virtual, buffer
+// satu frame di stack. Pesan di kabel sama dengan sketch lama:
+//   <WsnChaCha20Core, WsnKeystreamMode, WsnMessageIvFraming<>>  chacha_sender (AEAD_TAG 0)
+//   <WsnSnowVCore, WsnKeystreamMode, WsnMessageIvFraming<>>     snowv_sender_fix MESSAGE_IV 1
+//   <WsnAes256Core, WsnCbcMode, WsnMessageIvFraming<>>          AES256_Sender_Fix MESSAGE_IV 1
+//   <WsnClefia256Core, WsnCbcMode, WsnMessageIvFraming<>>       clefia_sender MESSAGE_IV 1
+//   <WsnClefia256Core, WsnEcbMode, WsnFixedIvFraming<>>         clefia_sender MESSAGE_IV 0
+// Tag WsnPoly1305Mode ikut mengalir ke frame terakhir (atau frame tambahan), jadi seal tetap satu
+// pass per frame. Format AEAD_TAG 1 chacha_sender (tag di header frame pertama) berbeda dan tetap
+// memakai chacha20Poly1305Seal/Open satu pesan.
+
+#include "WsnLz.h"
+#include "WsnNonce.h"
+#include "WsnPayload.h"
+#include "WsnSensorCodec.h"
+#include "WsnStream.h"
+
+// IV = nonce counter (WsnNonce.h) per pesan, lewat Mode::prepareIv, dikirim di depan ciphertext.
+// HeaderSize byte link.header ditulis paling depan: [header][IV][ciphertext]
+template <size_t FrameSize = 250, size_t HeaderSize = 0>
+struct WsnMessageIvFraming {
+    static const bool SendsIv = true;
+    static const size_t FrameBytes = FrameSize;
+    static const size_t HeaderBytes = HeaderSize;
+};
+
+// IV tetap dari begin(), tidak dikirim (MESSAGE_IV 0 di sketch lama)
+template <size_t FrameSize = 250, size_t HeaderSize = 0>
+struct WsnFixedIvFraming {
+    static const bool SendsIv = false;
+    static const size_t FrameBytes = FrameSize;
+    static const size_t HeaderBytes = HeaderSize;
+};
+
+// ---- Storage: store(plaintext, len, available) dipanggil sekali per pesan yang berhasil dibuka.
+// available >= len = byte hasil dekripsi sebelum padding dibuang (lihat WsnDecodedStorage) ----
+
+struct WsnNullStorage {
+    bool store(const uint8_t *, size_t, size_t) { return true; }
+};
+
+// Satu file per pesan: prefix + indeks + ".txt", seperti receiver lama.
+// Fs: objek apa saja dengan open(nama, mode) yang mengembalikan file dengan write/close (SD, LittleFS)
+template <typename Fs, typename OpenMode>
+class WsnFileStorage {
+public:
+    WsnFileStorage(Fs &fs, const char *prefix, OpenMode mode) : fs(fs), prefix(prefix), mode(mode) {}
+
+    bool store(const uint8_t *data, size_t len, size_t = 0) {
+        char name[64];
+        snprintf(name, sizeof(name), "%s%u.txt", prefix, (unsigned)fileIndex);
+        auto file = fs.open(name, mode);
+        if (!file) return false;
+        size_t written = file.write(data, len);
+        file.close();
+        if (written != len) return false;
+        fileIndex++;
+        return true;
+    }
+
+    uint32_t index() const { return fileIndex; }
+
+private:
+    Fs &fs;
+    const char *prefix;
+    OpenMode mode;
+    uint32_t fileIndex = 0;
+};
+
+// Pesan LZ dibuka dulu, lalu sensor codec, baru diteruskan ke Inner dalam bentuk teks.
+// LZ dibaca dari seluruh byte hasil dekripsi: pesan LZ yang kebetulan kelipatan blok tidak
+// diberi padding, dan byte terakhirnya bisa salah terbaca sebagai padding PKCS7 (LZ mengabaikan
+// sisa byte setelah token terakhir). TrimZeroPadding: teks biasa dari cipher dengan padding nol
+// (CLEFIA) dibuang nol di akhirnya, seperti clefia_receiver.
+template <class Inner, bool TrimZeroPadding = false>
+class WsnDecodedStorage {
+public:
+    template <typename... Args>
+    explicit WsnDecodedStorage(Args &&...args) : inner(args...) {}
+
+    bool store(const uint8_t *data, size_t len, size_t available) {
+        size_t lzLen;
+        uint8_t *unpacked = wsnLzDecompressAlloc(data, available > len ? available : len, lzLen, &lzStats);
+        lastLz = unpacked != nullptr;
+        if (lastLz) {
+            data = unpacked;
+            len = lzLen;
+        }
+        size_t textLen;
+        char *text = wsnSensorDecodeAlloc(data, len, textLen);
+        if (text != nullptr) {
+            data = (const uint8_t *)text;
+            len = textLen;
+        } else if (TrimZeroPadding && !lastLz) {
+            while (len > 0 && data[len - 1] == 0x00) len--;
+        }
+        bool ok = inner.store(data, len, len);
+        free(text);
+        free(unpacked);
+        return ok;
+    }
+
+    Inner inner;
+    bool lastLz = false;  // pesan terakhir dikompres LZ; statistiknya di lzStats
+    WsnLzStats lzStats = {};
+};
+
+// ---- Link ----
+
+template <class Cipher, template <class> class Mode, class Framing, class Storage = WsnNullStorage>
+class WsnSecureLink {
+public:
+    typedef Mode<Cipher> Engine;
+    static const size_t IvBytes = Framing::SendsIv ? Engine::IvSize : 0;
+    static const size_t HeaderBytes = Framing::HeaderBytes;
+    static const size_t PrefixBytes = HeaderBytes + IvBytes;
+    static const size_t TagBytes = Engine::TagSize;
+    static const size_t FrameBytes = Framing::FrameBytes;
+    static_assert(PrefixBytes < FrameBytes, "header + IV harus muat di frame pertama");
+    static_assert(TagBytes <= WSN_STREAM_MAX_TAIL, "tag harus muat di sisa buffer frame");
+
+    template <typename... Args>
+    explicit WsnSecureLink(Args &&...args) : storage(args...) {}
+
+    // Key schedule sekali. WsnMessageIvFraming: nonces wajib (sudah begin()); WsnFixedIvFraming: fixedIv
+    void begin(const uint8_t *key, WsnNonceManager *nonces, const uint8_t *fixedIv = nullptr) {
+        engine.setKey(key);
+        nonceSource = nonces;
+        memset(iv, 0, sizeof(iv));
+        if (fixedIv != nullptr) memcpy(iv, fixedIv, Engine::IvSize);
+    }
+
+    // Panjang pesan di kabel (header + IV + ciphertext + tag) untuk len byte plaintext
+    static size_t wireLength(size_t len) { return PrefixBytes + Engine::outputLength(len) + TagBytes; }
+    static size_t frameCount(size_t len) { return (wireLength(len) + FrameBytes - 1) / FrameBytes; }
+
+    // Enkripsi + fragmentasi satu pass. sink(frame, n) dipanggil per frame (mis. esp_now_send),
+    // return false menghentikan pesan. Waktu cipher saja (tanpa sink) di lastEncryptMicros
+    template <typename Sink>
+    bool seal(const uint8_t *message, size_t len, Sink &&sink) {
+        MemoryReader reader = {message};
+        return sealFrom(reader, len, sink);
+    }
+
+    // Plaintext dibaca langsung dari source per frame, tanpa buffer seukuran pesan
+    template <typename Sink>
+    bool seal(WsnPayloadSource &source, Sink &&sink) {
+        source.rewind();
+        SourceReader reader = {source, {0}};
+        return sealFrom(reader, source.size(), sink);
+    }
+
+    // Receiver: pesan utuh [header][IV][ciphertext][tag] didekripsi di tempat; plaintext mulai
+    // message[0]. Header dibaca pemanggil sebelumnya. false jika pesan terlalu pendek / bukan
+    // kelipatan blok, atau tag AEAD salah (plaintext dihapus, rejected bertambah)
+    bool open(uint8_t *message, size_t len, size_t &plaintextLen) {
+        if (len < PrefixBytes + TagBytes) return false;
+        size_t cipherLen = len - PrefixBytes - TagBytes;
+        if (Engine::outputLength(cipherLen) != cipherLen) return false;
+        if (IvBytes) memcpy(iv, message + HeaderBytes, IvBytes);
+
+        uint32_t start = wsnMicros();
+        engine.start(iv, WSN_STREAM_DECRYPT);
+        engine.aad(message, HeaderBytes);
+        size_t written = engine.update(message + PrefixBytes, message, cipherLen);
+        written += engine.final(message + written);
+        lastDecryptMicros = wsnMicros() - start;
+        decryptedLen = cipherLen;
+
+        if (TagBytes) {
+            uint8_t expected[TagBytes ? TagBytes : 1];
+            engine.tag(expected);
+            if (!wsnTagEqual(expected, message + PrefixBytes + cipherLen, TagBytes)) {
+                memset(message, 0, cipherLen);
+                rejected++;
+                return false;
+            }
+        }
+        plaintextLen = written;
+        return true;
+    }
+
+    // open + storage.store
+    bool receive(uint8_t *message, size_t len) {
+        size_t plaintextLen;
+        if (!open(message, len, plaintextLen)) return false;
+        return storage.store(message, plaintextLen, decryptedLen);
+    }
+
+    Storage storage;
+    uint8_t header[HeaderBytes ? HeaderBytes : 1];  // diisi pemanggil sebelum seal
+    uint32_t lastEncryptMicros = 0;
+    uint32_t lastDecryptMicros = 0;
+    uint32_t rejected = 0;  // pesan AEAD dengan tag salah
+    const uint8_t *lastIv() const { return iv; }
+
+private:
+    struct MemoryReader {
+        const uint8_t *next;
+        const uint8_t *read(size_t n) {
+            const uint8_t *p = next;
+            next += n;
+            return p;
+        }
+    };
+
+    struct SourceReader {
+        WsnPayloadSource &source;
+        uint8_t buffer[FrameBytes];
+        const uint8_t *read(size_t n) {
+            size_t got = wsnPayloadReadAll(source, buffer, n);
+            if (got < n) memset(buffer + got, 0, n - got);
+            return buffer;
+        }
+    };
+
+    template <typename Reader, typename Sink>
+    bool sealFrom(Reader &reader, size_t len, Sink &sink) {
+        if (Framing::SendsIv) {
+            if (nonceSource == nullptr || !nonceSource->next(iv, Engine::IvSize)) return false;
+            engine.prepareIv(iv);
+        }
+        // Block mode: update bisa menulis sampai 15 byte melewati sisa frame, final sampai 16 byte
+        uint8_t frame[FrameBytes + WSN_STREAM_MAX_TAIL];
+        size_t fill = PrefixBytes;
+        memcpy(frame, header, HeaderBytes);
+        memcpy(frame + HeaderBytes, iv, IvBytes);
+
+        uint32_t cipherMicros = 0;
+        uint32_t start = wsnMicros();
+        engine.start(iv, WSN_STREAM_ENCRYPT);
+        engine.aad(header, HeaderBytes);
+        size_t remaining = len;
+        while (remaining) {
+            size_t take = FrameBytes - fill;
+            if (take > remaining) take = remaining;
+            fill += engine.update(reader.read(take), frame + fill, take);
+            remaining -= take;
+            if (fill >= FrameBytes) {
+                cipherMicros += wsnMicros() - start;
+                if (!sink(frame, FrameBytes)) return false;
+                fill -= FrameBytes;
+                memmove(frame, frame + FrameBytes, fill);
+                start = wsnMicros();
+            }
+        }
+        fill += engine.final(frame + fill);
+        engine.tag(frame + fill);
+        fill += TagBytes;
+        cipherMicros += wsnMicros() - start;
+        lastEncryptMicros = cipherMicros;
+
+        while (fill) {
+            size_t n = fill < FrameBytes ? fill : FrameBytes;
+            if (!sink(frame, n)) return false;
+            fill -= n;
+            memmove(frame, frame + n, fill);
+        }
+        return true;
+    }
+
+    Engine engine;
+    size_t decryptedLen = 0;
+    WsnNonceManager *nonceSource = nullptr;
+    uint8_t iv[Engine::IvSize ? Engine::IvSize : 1];
+};
+
+#endif // WSN_SECURE_LINK_H
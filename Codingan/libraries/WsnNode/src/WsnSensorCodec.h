@@ -0,0 +1,330 @@
+#ifndef WSN_SENSOR_CODEC_H
+#define WSN_SENSOR_CODEC_H
+
+// Codec biner untuk rekaman DHT22 "TT.TT,HH.HH" sebelum dienkripsi.
+//
+// Nilai disimpan fixed-point seperseratus (30.80 C -> 3080), sama persis dengan teks asli.
+// Rekaman ke-i dengan i % keyframeInterval == 0 adalah keyframe (nilai absolut), sisanya
+// selisih terhadap rekaman sebelumnya dengan zigzag varint:
+//
+//   keyframe : varint(zigzag(t)) varint(h)
+//   delta    : varint(zigzag(dh) << 2 | min(zigzag(dt), 3)) [varint(zigzag(dt) - 3)]
+//
+// Suhu jarang berubah, jadi rekaman yang tidak berubah = 1 byte (0x00) dan perubahan
+// kelembapan sampai +-0.31 %RH tetap 1 byte. Setiap pesan dimulai dengan keyframe,
+// sehingga pesan bisa di-decode sendiri walau pesan sebelumnya hilang.
+//
+// Layout pesan:
+//   [0xD5][keyframeInterval][count u16 LE][varint firstIndex][prefixLen][prefix]
+//   [rekaman x count][suffixLen][suffix]
+//
+// Prefix/suffix menyimpan teks di luar rekaman ("Data Suhu: ", "dataEnd") supaya
+// wsnSensorDecodeText menghasilkan teks yang identik byte per byte.
+// Byte pertama 0xD5 bukan ASCII, jadi receiver bisa membedakan pesan biner dari teks biasa.
+// Decoder host: visualisasi data/sensor_decode.py.
+
+#include "WsnPlatform.h"
+
+#define WSN_SENSOR_MAGIC 0xD5
+// Batas atas hasil wsnSensorEncodeText: rekaman 11 byte teks selalu <= 6 byte biner,
+// ditambah header (maks 9) dan dua byte panjang prefix/suffix
+#define WSN_SENSOR_MAX_ENCODED(textLen) ((textLen) + 11)
+
+struct WsnSensorReading {
+    int16_t temperature100;  // 0.01 C
+    int16_t humidity100;     // 0.01 %RH
+};
+
+inline uint32_t wsnZigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+inline int32_t wsnUnzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// Mengembalikan byte yang ditulis, 0 jika tidak muat
+inline size_t wsnVarintWrite(uint8_t *out, size_t cap, uint32_t v) {
+    size_t n = 0;
+    do {
+        if (n == cap) return 0;
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        out[n++] = v ? (uint8_t)(b | 0x80) : b;
+    } while (v);
+    return n;
+}
+
+// Mengembalikan byte yang dibaca, 0 jika terpotong atau lebih dari 5 byte
+inline size_t wsnVarintRead(const uint8_t *in, size_t len, uint32_t &v) {
+    v = 0;
+    for (size_t n = 0; n < len && n < 5; n++) {
+        v |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80)) return n + 1;
+    }
+    return 0;
+}
+
+class WsnSensorEncoder {
+public:
+    // Semua method mengembalikan false jika buffer penuh; isi buffer lalu tidak valid
+    bool begin(uint8_t *buffer, size_t capacity, uint32_t firstIndex = 0, uint8_t keyframeInterval = 32,
+               const char *prefix = "", size_t prefixLen = 0) {
+        out = buffer;
+        cap = capacity;
+        len = 0;
+        count = 0;
+        interval = keyframeInterval ? keyframeInterval : 1;
+        if (cap < 4 || prefixLen > 255) return false;
+        out[0] = WSN_SENSOR_MAGIC;
+        out[1] = interval;
+        len = 4;
+        return putVarint(firstIndex) && putBytes(prefix, prefixLen);
+    }
+
+    bool add(const WsnSensorReading &r) {
+        if (count == 0xFFFF) return false;
+        bool ok;
+        if (count % interval == 0) {
+            ok = putVarint(wsnZigzag(r.temperature100)) && putVarint((uint16_t)r.humidity100);
+        } else {
+            uint32_t dt = wsnZigzag(r.temperature100 - last.temperature100);
+            uint32_t dh = wsnZigzag(r.humidity100 - last.humidity100);
+            ok = putVarint(dh << 2 | (dt < 3 ? dt : 3)) && (dt < 3 || putVarint(dt - 3));
+        }
+        if (!ok) return false;
+        last = r;
+        count++;
+        return true;
+    }
+
+    // Mengembalikan panjang pesan, 0 jika tidak muat
+    size_t finish(const char *suffix = "", size_t suffixLen = 0) {
+        if (suffixLen > 255 || !putBytes(suffix, suffixLen)) return 0;
+        out[2] = (uint8_t)count;
+        out[3] = (uint8_t)(count >> 8);
+        return len;
+    }
+
+    uint16_t records() const { return count; }
+
+private:
+    bool putVarint(uint32_t v) {
+        size_t n = wsnVarintWrite(out + len, cap - len, v);
+        len += n;
+        return n != 0;
+    }
+
+    bool putBytes(const char *data, size_t n) {
+        if (cap - len < n + 1) return false;
+        out[len++] = (uint8_t)n;
+        memcpy(out + len, data, n);
+        len += n;
+        return true;
+    }
+
+    uint8_t *out = nullptr;
+    size_t cap = 0;
+    size_t len = 0;
+    uint16_t count = 0;
+    uint8_t interval = 1;
+    WsnSensorReading last = {0, 0};
+};
+
+class WsnSensorDecoder {
+public:
+    bool begin(const uint8_t *data, size_t length) {
+        in = data;
+        len = length;
+        pos = 4;
+        index = 0;
+        if (len < 4 || in[0] != WSN_SENSOR_MAGIC || in[1] == 0) return false;
+        interval = in[1];
+        count = (uint16_t)(in[2] | in[3] << 8);
+        return getVarint(firstIndex) && getBytes(&prefix, prefixLen);
+    }
+
+    // false setelah rekaman terakhir atau jika data rusak
+    bool next(WsnSensorReading &r) {
+        if (index == count) return false;
+        uint32_t a, b;
+        if (index % interval == 0) {
+            if (!getVarint(a) || !getVarint(b)) return false;
+            last.temperature100 = (int16_t)wsnUnzigzag(a);
+            last.humidity100 = (int16_t)b;
+        } else {
+            if (!getVarint(a)) return false;
+            uint32_t dt = a & 3;
+            if (dt == 3) {
+                if (!getVarint(b)) return false;
+                dt += b;
+            }
+            last.temperature100 = (int16_t)(last.temperature100 + wsnUnzigzag(dt));
+            last.humidity100 = (int16_t)(last.humidity100 + wsnUnzigzag(a >> 2));
+        }
+        r = last;
+        index++;
+        return true;
+    }
+
+    // Dipanggil setelah next() mengembalikan false pada rekaman terakhir
+    bool suffix(const uint8_t **data, size_t &n) {
+        return index == count && getBytes(data, n);
+    }
+
+    uint32_t first() const { return firstIndex; }
+    uint16_t records() const { return count; }
+    const uint8_t *prefixData() const { return prefix; }
+    size_t prefixLength() const { return prefixLen; }
+
+private:
+    bool getVarint(uint32_t &v) {
+        size_t n = wsnVarintRead(in + pos, len - pos, v);
+        pos += n;
+        return n != 0;
+    }
+
+    bool getBytes(const uint8_t **data, size_t &n) {
+        if (pos >= len || len - pos - 1 < in[pos]) return false;
+        n = in[pos];
+        *data = in + pos + 1;
+        pos += 1 + n;
+        return true;
+    }
+
+    const uint8_t *in = nullptr;
+    size_t len = 0;
+    size_t pos = 0;
+    uint16_t count = 0;
+    uint16_t index = 0;
+    uint8_t interval = 1;
+    uint32_t firstIndex = 0;
+    const uint8_t *prefix = nullptr;
+    size_t prefixLen = 0;
+    WsnSensorReading last = {0, 0};
+};
+
+inline bool wsnSensorIsEncoded(const uint8_t *data, size_t len) {
+    return len >= 4 && data[0] == WSN_SENSOR_MAGIC;
+}
+
+// Parse satu rekaman "[-]D+.DD" ; mengembalikan byte yang dipakai, 0 jika bukan angka
+inline size_t wsnSensorParseValue(const char *text, size_t len, int16_t &value) {
+    size_t i = 0;
+    bool negative = i < len && text[i] == '-';
+    if (negative) i++;
+    int32_t whole = 0;
+    size_t digits = 0;
+    while (i < len && text[i] >= '0' && text[i] <= '9' && digits < 3) {
+        whole = whole * 10 + (text[i++] - '0');
+        digits++;
+    }
+    if (!digits || i + 3 > len || text[i] != '.' || text[i + 1] < '0' || text[i + 1] > '9' ||
+        text[i + 2] < '0' || text[i + 2] > '9') {
+        return 0;
+    }
+    int32_t v = whole * 100 + (text[i + 1] - '0') * 10 + (text[i + 2] - '0');
+    // Bentuk yang tidak akan ditulis ulang persis sama ("05.30", "-0.00") dibiarkan sebagai teks
+    if (v > 32767 || (digits > 1 && text[negative ? 1 : 0] == '0') || (negative && v == 0)) return 0;
+    value = (int16_t)(negative ? -v : v);
+    return i + 3;
+}
+
+inline size_t wsnSensorParseRecord(const char *text, size_t len, WsnSensorReading &r) {
+    size_t a = wsnSensorParseValue(text, len, r.temperature100);
+    if (!a || a >= len || text[a] != ',') return 0;
+    size_t b = wsnSensorParseValue(text + a + 1, len - a - 1, r.humidity100);
+    return b ? a + 1 + b : 0;
+}
+
+// Teks plaintext lama ("Data Suhu: 30.80,73.8030.80,73.80...dataEnd") -> pesan biner.
+// Mengembalikan panjang pesan, atau 0 jika tidak muat / prefix/suffix > 255 byte
+// (pemanggil lalu mengirim teks apa adanya).
+inline size_t wsnSensorEncodeText(const char *text, size_t len, uint8_t *out, size_t cap, uint32_t firstIndex = 0,
+                                  uint8_t keyframeInterval = 32) {
+    WsnSensorReading r;
+    size_t start = 0;
+    while (start < len && !wsnSensorParseRecord(text + start, len - start, r)) start++;
+
+    WsnSensorEncoder encoder;
+    if (!encoder.begin(out, cap, firstIndex, keyframeInterval, text, start)) return 0;
+    size_t pos = start;
+    while (pos < len) {
+        size_t n = wsnSensorParseRecord(text + pos, len - pos, r);
+        if (!n) break;
+        if (!encoder.add(r)) return 0;
+        pos += n;
+    }
+    return encoder.finish(text + pos, len - pos);
+}
+
+inline size_t wsnSensorFormatValue(char *out, int16_t value) {
+    int32_t v = value;
+    return (size_t)sprintf(out, "%s%ld.%02ld", v < 0 ? "-" : "", (long)((v < 0 ? -v : v) / 100),
+                           (long)((v < 0 ? -v : v) % 100));
+}
+
+// Kebalikan wsnSensorEncodeText. Mengembalikan panjang teks (tanpa '\0'), 0 jika rusak
+// atau tidak muat. out == nullptr: hanya menghitung panjang (cap diabaikan).
+inline size_t wsnSensorDecodeText(const uint8_t *data, size_t len, char *out, size_t cap) {
+    WsnSensorDecoder decoder;
+    if (!decoder.begin(data, len)) return 0;
+    if (!out) cap = (size_t)-1;
+    size_t n = 0;
+    const uint8_t *chunk = decoder.prefixData();
+    size_t chunkLen = decoder.prefixLength();
+
+    WsnSensorReading r;
+    char record[16];
+    for (;;) {
+        if (cap - n < chunkLen + 1) return 0;
+        if (out) memcpy(out + n, chunk, chunkLen);
+        n += chunkLen;
+        if (!decoder.next(r)) break;
+        size_t m = wsnSensorFormatValue(record, r.temperature100);
+        record[m++] = ',';
+        m += wsnSensorFormatValue(record + m, r.humidity100);
+        chunk = (const uint8_t *)record;
+        chunkLen = m;
+    }
+
+    if (!decoder.suffix(&chunk, chunkLen) || cap - n < chunkLen + 1) return 0;
+    if (out) {
+        memcpy(out + n, chunk, chunkLen);
+        out[n + chunkLen] = '\0';
+    }
+    return n + chunkLen;
+}
+
+// Untuk sender: teks plaintext -> pesan biner baru di heap (pemanggil wajib free()).
+// nullptr jika teks tidak berisi rekaman sensor atau heap habis; kirim teksnya apa adanya.
+// nextIndex = indeks rekaman pertama, dimajukan sebanyak rekaman yang di-encode.
+inline uint8_t *wsnSensorEncodeAlloc(const char *text, size_t len, size_t &encodedLen, uint32_t &nextIndex) {
+    size_t cap = WSN_SENSOR_MAX_ENCODED(len);
+    uint8_t *encoded = (uint8_t *)malloc(cap);
+    if (encoded == nullptr) return nullptr;
+    encodedLen = wsnSensorEncodeText(text, len, encoded, cap, nextIndex);
+    uint16_t records = encodedLen ? (uint16_t)(encoded[2] | encoded[3] << 8) : 0;
+    if (!records) {
+        free(encoded);
+        return nullptr;
+    }
+    nextIndex += records;
+    return encoded;
+}
+
+// Untuk receiver: hasil dekripsi -> teks asli baru di heap, diakhiri '\0' (pemanggil wajib free()).
+// nullptr jika data bukan pesan WsnSensorCodec (mis. sender masih mengirim teks) atau rusak.
+// Byte setelah suffix (padding blok cipher) diabaikan.
+inline char *wsnSensorDecodeAlloc(const uint8_t *data, size_t len, size_t &textLen) {
+    if (!wsnSensorIsEncoded(data, len)) return nullptr;
+    // Dua lintasan: hitung panjang dulu supaya heap yang dipakai pas sebesar teks asli
+    size_t cap = wsnSensorDecodeText(data, len, nullptr, 0) + 1;
+    if (cap == 1) return nullptr;
+    char *text = (char *)malloc(cap);
+    if (text == nullptr) return nullptr;
+    textLen = wsnSensorDecodeText(data, len, text, cap);
+    return text;
+}
+
+#endif // WSN_SENSOR_CODEC_H
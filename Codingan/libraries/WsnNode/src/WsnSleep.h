@@ -0,0 +1,350 @@
+#ifndef WSN_SLEEP_H
+#define WSN_SLEEP_H
+
+// Penjadwal daya: node aktif sebentar tiap periodMs, sisanya tidur sedalam mungkin.
+//
+// Sisa waktu periode setelah siklus aktif menentukan mode (dibatasi config.deepest):
+//   >= deepMinMs   deep sleep  : CPU mati, hanya RTC; bangun = reboot ke setup() (GPIO16 -> RST)
+//   >= lightMinMs  light sleep : CPU dan radio dijeda, RAM tetap
+//   lainnya        modem sleep : radio mati (WiFi.forceSleepBegin), CPU menunggu
+// Setelah light/modem sleep radio dinyalakan ulang lewat startRadio() (config.initRadio), lalu
+// config.onWake dipanggil. State pipeline yang didaftarkan dengan keep() (batch, kebijakan
+// laporan) disimpan ke RTC memory sebelum deep sleep dan dipulihkan oleh begin(); begitu juga
+// state scheduler sendiri (waktu node, peer, residensi). Counter nonce disimpan WsnNonce.h
+// sendiri di setiap pesan.
+//
+// Residensi (ms per mode) dan estimasi arus rata-rata dihitung di node maupun di host. Di host
+// tidak ada yang benar-benar tidur: jam virtual dimajukan, dan deep sleep berarti pemanggil
+// menjalankan ulang begin() (simulasi reboot), lihat code/host/sleep_sim.cpp.
+//
+// Tata letak RTC memory: lihat WsnPlatform.h.
+
+#include "WsnPlatform.h"
+#include "WsnFraming.h"
+
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+extern "C" {
+#include <user_interface.h>
+}
+#include <espnow.h>
+#elif defined(ESP32)
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_sleep.h>
+#include <esp_wifi.h>
+#endif
+
+#define WSN_RTC_STATE_MAGIC 0x31525357UL  // "WSR1"
+#define WSN_SLEEP_MAX_PARTS 4
+
+enum WsnPowerState : uint8_t {
+    WSN_POWER_ACTIVE = 0,
+    WSN_POWER_MODEM_SLEEP,
+    WSN_POWER_LIGHT_SLEEP,
+    WSN_POWER_DEEP_SLEEP,
+    WSN_POWER_STATE_COUNT
+};
+
+inline const char *wsnPowerStateName(WsnPowerState state) {
+    static const char *const names[WSN_POWER_STATE_COUNT] = {"active", "modem", "light", "deep"};
+    return state < WSN_POWER_STATE_COUNT ? names[state] : "?";
+}
+
+// Arus tipikal ESP8266 (datasheet Espressif, 3.3 V): aktif termasuk TX/RX rata-rata,
+// dan lama bangun dari tiap mode (dihitung sebagai waktu aktif)
+struct WsnSleepConfig {
+    uint32_t periodMs = 2000;
+    WsnPowerState deepest = WSN_POWER_LIGHT_SLEEP;
+    uint32_t deepMinMs = 5000;
+    uint32_t lightMinMs = 20;
+    float currentMa[WSN_POWER_STATE_COUNT] = {70.0f, 15.0f, 0.9f, 0.02f};
+    uint32_t wakeMs[WSN_POWER_STATE_COUNT] = {0, 2, 5, 180};
+    bool (*initRadio)() = nullptr;  // esp_now_init + role + callback milik sketch
+    void (*onWake)() = nullptr;
+    void (*onDeepSleep)() = nullptr;
+};
+
+// Konfigurasi node sender: light sleep, atau deep sleep jika deep (GPIO16 -> RST, periode >= 5 s)
+inline WsnSleepConfig wsnSleepSenderConfig(uint32_t periodMs, bool deep, bool (*initRadio)()) {
+    WsnSleepConfig config;
+    config.periodMs = periodMs;
+    config.deepest = deep ? WSN_POWER_DEEP_SLEEP : WSN_POWER_LIGHT_SLEEP;
+    config.initRadio = initRadio;
+    return config;
+}
+
+// Objek dengan saveRtc(offset)/loadRtc(offset) (WsnBatch, WsnReportPolicy) yang ikut melewati
+// deep sleep; dibuat dengan wsnSleepPart dan didaftarkan ke scheduler dengan keep()
+struct WsnSleepPart {
+    void *object;
+    uint32_t offset;
+    bool (*save)(const void *object, uint32_t offset);
+    bool (*load)(void *object, uint32_t offset);
+};
+
+template <typename T>
+WsnSleepPart wsnSleepPart(T &object, uint32_t offset) {
+    WsnSleepPart part;
+    part.object = &object;
+    part.offset = offset;
+    part.save = [](const void *o, uint32_t off) { return static_cast<const T *>(o)->saveRtc(off); };
+    part.load = [](void *o, uint32_t off) { return static_cast<T *>(o)->loadRtc(off); };
+    return part;
+}
+
+// Disimpan di RTC memory; bertahan selama deep sleep
+struct WsnRtcState {
+    uint32_t magic;
+    uint16_t crc;  // CRC-16 semua field setelah ini
+    uint8_t channel;
+    uint8_t peerValid;
+    uint8_t peerMac[6];
+    uint16_t reserved;
+    uint32_t bootCount;
+    uint32_t elapsedMs;  // waktu node sejak power on, melewati deep sleep
+    uint32_t residencyMs[WSN_POWER_STATE_COUNT];
+};
+
+static_assert(sizeof(WsnRtcState) <= WSN_RTC_NONCE_OFFSET, "WsnRtcState melebihi slot RTC");
+
+class WsnSleepScheduler {
+public:
+    explicit WsnSleepScheduler(const WsnSleepConfig &config = WsnSleepConfig()) : config(config) {
+        memset(&rtcState, 0, sizeof(rtcState));
+    }
+
+    // Sebelum begin(); maksimal WSN_SLEEP_MAX_PARTS
+    void keep(const WsnSleepPart &part) {
+        if (partCount < WSN_SLEEP_MAX_PARTS) parts[partCount++] = part;
+    }
+
+    // Awal setup(). true jika state RTC valid (bangun dari deep sleep) dan bagian keep() sudah
+    // dipulihkan; false saat power on, state lalu dikosongkan.
+    bool begin() {
+        bool resumed = wsnRtcRead(WSN_RTC_STATE_OFFSET, &rtcState, sizeof(rtcState)) &&
+                       rtcState.magic == WSN_RTC_STATE_MAGIC && rtcState.crc == checksum();
+        if (!resumed) {
+            memset(&rtcState, 0, sizeof(rtcState));
+            rtcState.magic = WSN_RTC_STATE_MAGIC;
+        }
+        rtcState.bootCount++;
+        wakeMs = wsnMillis();
+        // Boot setelah deep sleep tidak terlihat oleh millis(); dihitung dari model
+        if (resumed) {
+            addActive(config.wakeMs[WSN_POWER_DEEP_SLEEP]);
+            for (uint8_t i = 0; i < partCount; i++) parts[i].load(parts[i].object, parts[i].offset);
+        }
+        save();
+        return resumed;
+    }
+
+    WsnRtcState &rtc() { return rtcState; }
+    const WsnRtcState &rtc() const { return rtcState; }
+
+    void setPeer(const uint8_t mac[6], uint8_t channel) {
+        memcpy(rtcState.peerMac, mac, 6);
+        rtcState.channel = channel;
+        rtcState.peerValid = 1;
+    }
+
+    // Waktu node (ms) yang tetap naik melewati deep sleep; pakai untuk timestamp batch/laporan
+    uint32_t nowMs() const { return rtcState.elapsedMs + (wsnMillis() - wakeMs) + pendingActiveMs; }
+
+    // Host: menambah waktu aktif hasil model (mis. durasi enkripsi + kirim) ke siklus ini
+    void addActiveMs(uint32_t ms) { pendingActiveMs += ms; }
+
+    // Akhir siklus: tidur sampai periode berikutnya dimulai. Deep sleep di node tidak kembali.
+    WsnPowerState sleep() {
+        uint32_t active = (wsnMillis() - wakeMs) + pendingActiveMs;
+        pendingActiveMs = 0;
+        addActive(active);
+        uint32_t remaining = config.periodMs > active ? config.periodMs - active : 0;
+
+        WsnPowerState state = WSN_POWER_ACTIVE;
+        if (remaining >= config.deepMinMs && config.deepest >= WSN_POWER_DEEP_SLEEP) state = WSN_POWER_DEEP_SLEEP;
+        else if (remaining >= config.lightMinMs && config.deepest >= WSN_POWER_LIGHT_SLEEP) state = WSN_POWER_LIGHT_SLEEP;
+        else if (remaining && config.deepest >= WSN_POWER_MODEM_SLEEP) state = WSN_POWER_MODEM_SLEEP;
+
+        // Waktu bangun dipotong dari tidur dan dihitung aktif, supaya periode tetap
+        uint32_t wake = config.wakeMs[state] < remaining ? config.wakeMs[state] : remaining;
+        uint32_t sleepMs = remaining - wake;
+        rtcState.residencyMs[state] += sleepMs;
+        rtcState.elapsedMs += sleepMs;
+
+        if (state == WSN_POWER_DEEP_SLEEP) {
+            for (uint8_t i = 0; i < partCount; i++) parts[i].save(parts[i].object, parts[i].offset);
+            if (config.onDeepSleep) config.onDeepSleep();
+            save();
+            enterDeepSleep(sleepMs);
+            return state;  // hanya di host
+        }
+        enterSleep(state, sleepMs);
+        wakeMs = wsnMillis();
+#if !defined(ARDUINO)
+        // Di node waktu bangun terukur sebagai aktif di siklus berikutnya; di host dari model
+        addActive(wake);
+#endif
+        if (state != WSN_POWER_ACTIVE) {
+            if (config.initRadio) startRadio();
+            if (config.onWake) config.onWake();
+        }
+        save();
+        return state;
+    }
+
+    // Radio + ESP-NOW sender, dipakai di setup() dan otomatis setelah light/modem sleep: kanal
+    // peer dari RTC tanpa scan, config.initRadio, lalu peer didaftarkan ulang (esp_now_deinit
+    // menghapusnya). Peer dari RTC dipakai jika ada (bangun dari deep sleep), selain itu mac di
+    // kanal channel. Gagal = restart, sama di setup maupun setelah bangun: sender tanpa radio
+    // tidak berguna, dan setelah restart jalur yang sama dicoba dari awal.
+    void startRadio(const uint8_t mac[6], uint8_t channel) {
+        if (!rtcState.peerValid) setPeer(mac, channel);
+        startRadio();
+    }
+
+    void startRadio();
+
+    // Arus rata-rata (mA) sejak power on dari residensi dan config.currentMa
+    float averageCurrentMa() const {
+        float charge = 0;
+        uint32_t total = 0;
+        for (int s = 0; s < WSN_POWER_STATE_COUNT; s++) {
+            charge += rtcState.residencyMs[s] * config.currentMa[s];
+            total += rtcState.residencyMs[s];
+        }
+        return total ? charge / total : 0;
+    }
+
+    template <typename Out>
+    void printResidency(Out &out) const {
+        uint32_t total = 0;
+        for (int s = 0; s < WSN_POWER_STATE_COUNT; s++) total += rtcState.residencyMs[s];
+        char line[80];
+        for (int s = 0; s < WSN_POWER_STATE_COUNT; s++) {
+            snprintf(line, sizeof(line), "%-7s %10lu ms %6.2f%% %8.3f mA\n", wsnPowerStateName((WsnPowerState)s),
+                     (unsigned long)rtcState.residencyMs[s], total ? 100.0 * rtcState.residencyMs[s] / total : 0.0,
+                     (double)config.currentMa[s]);
+            out.print(line);
+        }
+        snprintf(line, sizeof(line), "rata-rata %.3f mA, boot %lu\n", (double)averageCurrentMa(),
+                 (unsigned long)rtcState.bootCount);
+        out.print(line);
+    }
+
+private:
+    uint16_t checksum() const {
+        const uint8_t *p = (const uint8_t *)&rtcState.channel;
+        return wsnCrc16(p, sizeof(rtcState) - (size_t)(p - (const uint8_t *)&rtcState));
+    }
+
+    void save() {
+        rtcState.crc = checksum();
+        wsnRtcWrite(WSN_RTC_STATE_OFFSET, &rtcState, sizeof(rtcState));
+    }
+
+    void addActive(uint32_t ms) {
+        rtcState.residencyMs[WSN_POWER_ACTIVE] += ms;
+        rtcState.elapsedMs += ms;
+    }
+
+    static void enterDeepSleep(uint32_t ms) {
+#if defined(ESP8266)
+        ESP.deepSleep((uint64_t)ms * 1000, WAKE_RF_DEFAULT);
+#elif defined(ESP32)
+        esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+        esp_deep_sleep_start();
+#else
+        (void)ms;
+#endif
+    }
+
+    static void enterSleep(WsnPowerState state, uint32_t ms) {
+#if defined(ESP8266)
+        if (state == WSN_POWER_LIGHT_SLEEP) {
+            // Light sleep dengan timer: radio harus NULL_MODE dulu; CPU benar-benar berhenti di delay()
+            wifi_station_disconnect();
+            wifi_set_opmode_current(NULL_MODE);
+            wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+            wifi_fpm_open();
+            wifi_fpm_do_sleep(ms * 1000);
+            delay(ms + 1);
+            wifi_fpm_close();
+        } else if (state == WSN_POWER_MODEM_SLEEP) {
+            WiFi.forceSleepBegin();
+            delay(ms);
+            WiFi.forceSleepWake();
+        } else {
+            delay(ms);
+        }
+#elif defined(ESP32)
+        if (state == WSN_POWER_LIGHT_SLEEP) {
+            esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+            esp_light_sleep_start();
+        } else if (state == WSN_POWER_MODEM_SLEEP) {
+            esp_wifi_stop();
+            delay(ms);
+            esp_wifi_start();
+        } else {
+            delay(ms);
+        }
+#elif defined(ARDUINO)
+        (void)state;
+        delay(ms);
+#else
+        (void)state;
+        (void)ms;
+#endif
+    }
+
+    WsnSleepConfig config;
+    WsnRtcState rtcState;
+    WsnSleepPart parts[WSN_SLEEP_MAX_PARTS];
+    uint8_t partCount = 0;
+    uint32_t wakeMs = 0;
+    uint32_t pendingActiveMs = 0;
+};
+
+#if defined(ESP8266) || defined(ESP32)
+// Radio siap untuk esp_now_init() tanpa mencoba konek ke AP tersimpan, di kanal peer dari RTC.
+// Dipanggil startRadio() sebelum config.initRadio.
+inline void wsnRadioQuickBegin(const WsnRtcState &rtc) {
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+    if (rtc.peerValid && rtc.channel) {
+#if defined(ESP8266)
+        wifi_set_channel(rtc.channel);
+#else
+        esp_wifi_set_channel(rtc.channel, WIFI_SECOND_CHAN_NONE);
+#endif
+    }
+}
+
+inline void WsnSleepScheduler::startRadio() {
+    wsnRadioQuickBegin(rtcState);
+    esp_now_deinit();
+    bool ok = config.initRadio == nullptr || config.initRadio();
+    if (ok && rtcState.peerValid && !esp_now_is_peer_exist(rtcState.peerMac)) {
+#if defined(ESP8266)
+        ok = esp_now_add_peer(rtcState.peerMac, ESP_NOW_ROLE_SLAVE, rtcState.channel, NULL, 0) == 0;
+#else
+        esp_now_peer_info_t peer;
+        memset(&peer, 0, sizeof(peer));
+        memcpy(peer.peer_addr, rtcState.peerMac, 6);
+        peer.channel = rtcState.channel;
+        ok = esp_now_add_peer(&peer) == ESP_OK;
+#endif
+    }
+    if (!ok) {
+        Serial.println("ESP-NOW start failed, restart");
+        Serial.flush();
+        ESP.restart();
+    }
+}
+#else
+// Host: tidak ada radio
+inline void WsnSleepScheduler::startRadio() {}
+#endif
+
+#endif // WSN_SLEEP_H
@@ -0,0 +1,69 @@
+#ifndef WSN_SNOWV_H
+#define WSN_SNOWV_H
+
+// Generator keystream "Snow-V" seperti di snowv_sender_fix / snow-v_receiver_fix:
+// LFSR 12 word (key 256 bit + IV 128 bit) dan FSM 3 word, satu word keystream per clock.
+// Ini konstruksi sederhana yang dipakai di sketch, bukan SNOW-V lengkap dari
+// spesifikasinya (tanpa AES round dan tanpa fase inisialisasi), dan dipertahankan
+// apa adanya supaya tetap kompatibel dengan node yang sudah ada.
+
+#include "WsnPlatform.h"
+#include "WsnProfile.h"
+
+struct SnowVState {
+    uint32_t LFSR[12];
+    uint32_t FSM[3];
+};
+
+inline void snowVInit(SnowVState &s, const uint8_t key[32], const uint8_t iv[16]) {
+    WSN_PROFILE_SCOPE(WSN_PROF_KEY_SETUP);
+    for (int i = 0; i < 8; i++) {
+        s.LFSR[i] = wsnLoad32(key + 4 * i);
+    }
+    for (int i = 0; i < 4; i++) {
+        s.LFSR[8 + i] = wsnLoad32(iv + 4 * i);
+    }
+    s.FSM[0] = s.FSM[1] = s.FSM[2] = 0;
+}
+
+// Satu clock: menghasilkan satu word keystream
+inline uint32_t snowVClock(SnowVState &s) {
+    uint32_t f = (s.FSM[0] + s.LFSR[0]) ^ s.FSM[2];
+    s.FSM[2] = s.FSM[1];
+    s.FSM[1] = s.FSM[0];
+    s.FSM[0] = f;
+
+    uint32_t top = s.LFSR[11];
+    for (int j = 11; j > 0; j--) {
+        s.LFSR[j] = s.LFSR[j - 1];
+    }
+    s.LFSR[0] = top ^ f;
+    return f;
+}
+
+inline void snowVKeystream(SnowVState &s, uint8_t *keystream, size_t len) {
+    for (size_t i = 0; i < len; i += 4) {
+        wsnStore32(keystream + i, snowVClock(s));
+    }
+}
+
+inline void snowVEncryptDecrypt(const uint8_t *input, uint8_t *output, size_t len,
+                                const uint8_t key[32], const uint8_t iv[16]) {
+    SnowVState s;
+    snowVInit(s, key, iv);
+
+    uint8_t keystream[64];
+    size_t i = 0;
+    while (i < len) {
+        {
+            WSN_PROFILE_SCOPE(WSN_PROF_KEYSTREAM);
+            snowVKeystream(s, keystream, 64);
+        }
+        WSN_PROFILE_SCOPE(WSN_PROF_XOR);
+        for (size_t j = 0; j < 64 && i < len; ++j, ++i) {
+            output[i] = input[i] ^ keystream[j];
+        }
+    }
+}
+
+#endif // WSN_SNOWV_H
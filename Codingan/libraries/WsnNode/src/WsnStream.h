@@ -0,0 +1,353 @@
+#ifndef WSN_STREAM_H
+#define WSN_STREAM_H
+
+// Antarmuka streaming seragam untuk keempat cipher: init(key, iv) / update(in, out, n) / final(out).
+//
+// update boleh dipanggil dengan potongan berukuran sembarang (per pembacaan sensor, per fragmen
+// ESP-NOW); gabungan output sama persis dengan fungsi satu-pesan (chacha20EncryptDecrypt,
+// snowVEncryptDecrypt, aes256CbcEncrypt, clefia256EcbEncrypt). State keystream / sisa blok
+// disimpan di objek, jadi memori tidak lagi sebanding dengan ukuran pesan.
+//
+// Nilai kembali update/final = byte yang ditulis ke out.
+//   - stream cipher (ChaCha20, Snow-V): update selalu n, final 0; in dan out boleh sama
+//   - block cipher (AES-256-CBC, CLEFIA-256): hanya blok penuh yang keluar, sisa < 16 byte
+//     ditahan; out harus muat n + 15 byte (update) dan 16 byte (final). Dekripsi menahan
+//     blok terakhir sampai final supaya padding bisa dibuang. in == out boleh, out di depan in tidak.
+//
+// Setiap stream = mode (WsnKeystreamMode, WsnCbcMode, WsnEcbMode, WsnPoly1305Mode) atas inti
+// cipher. Inti hanya berisi primitif, jadi cipher baru cukup menyediakan inti:
+//   keystream: KeySize, IvSize, KeystreamSize, begin(key, iv), keystream(out)
+//   blok:      KeySize, BlockSize (16), Padding, setKey(key), encryptBlock(in, out), decryptBlock(in, out)
+// Semua dipanggil langsung (template), tanpa fungsi virtual.
+//
+// Mode AEAD (TagSize > 0): aad(data, n) sebelum update pertama, tag(out) setelah final. Tag
+// dihitung sambil jalan dan baru ada di akhir, jadi dikirim di belakang ciphertext (frame
+// terakhir) dan frame pertama bisa dikirim sebelum seluruh pesan dienkripsi. Mode lain punya
+// TagSize 0 dan aad/tag kosong.
+
+#include "WsnAes256.h"
+#include "WsnChaCha20.h"
+#include "WsnChaChaPoly.h"
+#include "WsnClefia256.h"
+#include "WsnSnowV.h"
+
+enum WsnStreamDirection : uint8_t {
+    WSN_STREAM_ENCRYPT = 0,
+    WSN_STREAM_DECRYPT
+};
+
+// Byte tambahan maksimum yang bisa ditulis update/final di luar n byte input
+#define WSN_STREAM_MAX_TAIL 16
+
+// ---- Inti cipher ----
+
+struct WsnChaCha20Core {
+    static const size_t KeySize = 32;
+    static const size_t IvSize = 12;
+    static const size_t KeystreamSize = 64;
+
+    // counter blok pertama 1, sama dengan sketch (blok 0 untuk kunci Poly1305)
+    void begin(const uint8_t key[32], const uint8_t nonce[12], uint32_t counter = 1) {
+        chacha20InitState(state, key, nonce, counter);
+    }
+
+    void keystream(uint8_t out[64]) {
+        uint32_t block[16];
+        chacha20Block(block, state);
+        state[12]++;
+        for (int w = 0; w < 16; w++) wsnStore32(out + 4 * w, block[w]);
+    }
+
+    uint32_t state[16];
+};
+
+struct WsnSnowVCore {
+    static const size_t KeySize = 32;
+    static const size_t IvSize = 16;
+    static const size_t KeystreamSize = 64;  // sama dengan snowVEncryptDecrypt
+
+    void begin(const uint8_t key[32], const uint8_t iv[16]) { snowVInit(state, key, iv); }
+    void keystream(uint8_t out[64]) { snowVKeystream(state, out, KeystreamSize); }
+
+    SnowVState state;
+};
+
+// Padding seperti aes256ApplyPadding: nilai PKCS7, tanpa blok tambahan jika sudah kelipatan 16
+struct WsnPkcs7Padding {
+    static void pad(uint8_t block[16], size_t used) { aes256ApplyPadding(block, used, WSN_AES_BLOCK_SIZE); }
+    static size_t unpad(const uint8_t block[16]) { return aes256RemovePadding(block, WSN_AES_BLOCK_SIZE); }
+};
+
+// Zero padding seperti clefia_sender; nol di akhir dibuang pemanggil seperti sebelumnya
+struct WsnZeroPadding {
+    static void pad(uint8_t block[16], size_t used) { memset(block + used, 0, 16 - used); }
+    static size_t unpad(const uint8_t *) { return 16; }
+};
+
+struct WsnAes256Core {
+    static const size_t KeySize = 32;
+    static const size_t BlockSize = WSN_AES_BLOCK_SIZE;
+    typedef WsnPkcs7Padding Padding;
+
+    void setKey(const uint8_t key[32]) { aes256SetKey(ctx, key); }
+    void encryptBlock(const uint8_t in[16], uint8_t out[16]) const { aes256EncryptBlock(ctx, in, out); }
+    void decryptBlock(const uint8_t in[16], uint8_t out[16]) const { aes256DecryptBlock(ctx, in, out); }
+
+    Aes256Context ctx;
+};
+
+struct WsnClefia256Core {
+    static const size_t KeySize = 32;
+    static const size_t BlockSize = WSN_CLEFIA_BLOCK_SIZE;
+    typedef WsnZeroPadding Padding;
+
+    void setKey(const uint8_t key[32]) { clefia256SetKey(ctx, key); }
+    void encryptBlock(const uint8_t in[16], uint8_t out[16]) const { clefia256EncryptBlock(ctx, in, out); }
+    void decryptBlock(const uint8_t in[16], uint8_t out[16]) const { clefia256DecryptBlock(ctx, in, out); }
+
+    Clefia256Context ctx;
+};
+
+// ---- Mode ----
+
+// XOR dengan keystream Core::KeystreamSize byte; enkripsi dan dekripsi sama
+template <class Core>
+class WsnKeystreamMode {
+public:
+    static const size_t IvSize = Core::IvSize;
+    static const size_t TagSize = 0;
+
+    // init = setKey + start; argumen tambahan diteruskan ke Core::begin (mis. counter ChaCha20)
+    template <typename... Extra>
+    void init(const uint8_t *key, const uint8_t *iv, Extra... extra) {
+        core.begin(key, iv, extra...);
+        used = Core::KeystreamSize;
+    }
+
+    // Kunci disimpan; state keystream dibuat ulang per pesan dari kunci + IV
+    void setKey(const uint8_t *key) { memcpy(savedKey, key, Core::KeySize); }
+    void start(const uint8_t *iv, WsnStreamDirection = WSN_STREAM_ENCRYPT) { init(savedKey, iv); }
+
+    // Nonce counter (WsnNonce.h) dipakai langsung sebagai IV
+    void prepareIv(uint8_t *) const {}
+    static size_t outputLength(size_t len) { return len; }
+
+    size_t update(const uint8_t *input, uint8_t *output, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            if (used == Core::KeystreamSize) {
+                WSN_PROFILE_SCOPE(WSN_PROF_KEYSTREAM);
+                core.keystream(keystream);
+                used = 0;
+            }
+            output[i] = input[i] ^ keystream[used++];
+        }
+        return n;
+    }
+
+    size_t final(uint8_t *) { return 0; }
+    void aad(const uint8_t *, size_t) {}
+    void tag(uint8_t *) {}
+
+private:
+    Core core;
+    uint8_t savedKey[Core::KeySize];
+    uint8_t keystream[Core::KeystreamSize];
+    size_t used = Core::KeystreamSize;
+};
+
+// Block cipher 16 byte dengan padding Core::Padding; Chained = CBC, tanpa = ECB (IV diabaikan)
+template <class Core, bool Chained>
+class WsnBlockMode {
+public:
+    static const size_t IvSize = Chained ? Core::BlockSize : 0;
+    static const size_t TagSize = 0;
+
+    void init(const uint8_t *key, const uint8_t *iv, WsnStreamDirection dir = WSN_STREAM_ENCRYPT) {
+        setKey(key);
+        start(iv, dir);
+    }
+
+    // Key schedule sekali, lalu start per pesan
+    void setKey(const uint8_t *key) { core.setKey(key); }
+
+    void start(const uint8_t *iv, WsnStreamDirection dir = WSN_STREAM_ENCRYPT) {
+        if (Chained) memcpy(chain, iv, Core::BlockSize);
+        direction = dir;
+        buffered = 0;
+    }
+
+    // IV CBC harus tidak bisa ditebak: blok nonce dienkripsi dengan kunci pesan (SP 800-38A lampiran C)
+    void prepareIv(uint8_t *iv) const {
+        if (Chained) core.encryptBlock(iv, iv);
+    }
+
+    static size_t outputLength(size_t len) {
+        return (len + Core::BlockSize - 1) / Core::BlockSize * Core::BlockSize;
+    }
+
+    size_t update(const uint8_t *input, uint8_t *output, size_t n) {
+        size_t written = 0;
+        while (n) {
+            // Dekripsi: blok penuh terakhir ditahan sampai ada data lagi atau final
+            if (buffered == Core::BlockSize) {
+                written += process(output + written);
+                continue;
+            }
+            size_t take = Core::BlockSize - buffered;
+            if (take > n) take = n;
+            memcpy(pending + buffered, input, take);
+            buffered += take;
+            input += take;
+            n -= take;
+            if (buffered == Core::BlockSize && direction == WSN_STREAM_ENCRYPT) written += process(output + written);
+        }
+        return written;
+    }
+
+    size_t final(uint8_t *output) {
+        if (direction == WSN_STREAM_ENCRYPT) {
+            if (!buffered) return 0;
+            Core::Padding::pad(pending, buffered);
+            buffered = Core::BlockSize;
+            return process(output);
+        }
+        if (buffered != Core::BlockSize) return 0;  // ciphertext bukan kelipatan 16
+        process(output);
+        return Core::Padding::unpad(output);
+    }
+
+    void aad(const uint8_t *, size_t) {}
+    void tag(uint8_t *) {}
+
+private:
+    size_t process(uint8_t *output) {
+        if (direction == WSN_STREAM_ENCRYPT) {
+            if (Chained) {
+                for (size_t j = 0; j < Core::BlockSize; j++) pending[j] ^= chain[j];
+            }
+            core.encryptBlock(pending, output);
+            if (Chained) memcpy(chain, output, Core::BlockSize);
+        } else {
+            core.decryptBlock(pending, output);
+            if (Chained) {
+                for (size_t j = 0; j < Core::BlockSize; j++) output[j] ^= chain[j];
+                memcpy(chain, pending, Core::BlockSize);
+            }
+        }
+        buffered = 0;
+        return Core::BlockSize;
+    }
+
+    Core core;
+    uint8_t pending[Core::BlockSize];
+    uint8_t chain[Core::BlockSize];
+    size_t buffered = 0;
+    WsnStreamDirection direction = WSN_STREAM_ENCRYPT;
+};
+
+// Blok keystream pertama untuk kunci Poly1305. ChaCha20 mulai dari counter 0 seperti RFC 8439,
+// jadi WsnPoly1305Mode<WsnChaCha20Core> = ChaCha20-Poly1305 standar (AAD = header aplikasi)
+template <class Core>
+struct WsnAeadKeystream {
+    static void begin(Core &core, const uint8_t *key, const uint8_t *iv) { core.begin(key, iv); }
+};
+
+template <>
+struct WsnAeadKeystream<WsnChaCha20Core> {
+    static void begin(WsnChaCha20Core &core, const uint8_t *key, const uint8_t *iv) { core.begin(key, iv, 0); }
+};
+
+// AEAD keystream + Poly1305 (konstruksi RFC 8439): 32 byte pertama blok keystream pertama =
+// kunci Poly1305, sisa blok itu dibuang, lalu XOR seperti WsnKeystreamMode. MAC atas AAD dan
+// ciphertext (bukan plaintext), jadi dekripsi bisa jalan per frame dan tag dicek di akhir;
+// pemanggil tidak boleh memakai plaintext sebelum tag cocok. Untuk inti selain ChaCha20
+// (mis. Snow-V) konstruksinya sama tetapi bukan AEAD terstandar.
+template <class Core>
+class WsnPoly1305Mode {
+public:
+    static const size_t IvSize = Core::IvSize;
+    static const size_t TagSize = WSN_POLY1305_TAG_SIZE;
+    static_assert(Core::KeystreamSize >= 32, "blok keystream harus memuat kunci Poly1305");
+
+    void setKey(const uint8_t *key) { memcpy(savedKey, key, Core::KeySize); }
+
+    void start(const uint8_t *iv, WsnStreamDirection dir = WSN_STREAM_ENCRYPT) {
+        WsnAeadKeystream<Core>::begin(core, savedKey, iv);
+        core.keystream(keystream);
+        poly1305Init(mac, keystream);
+        used = Core::KeystreamSize;
+        direction = dir;
+        aadLen = 0;
+        textLen = 0;
+        aadOpen = true;
+    }
+
+    void init(const uint8_t *key, const uint8_t *iv, WsnStreamDirection dir = WSN_STREAM_ENCRYPT) {
+        setKey(key);
+        start(iv, dir);
+    }
+
+    void prepareIv(uint8_t *) const {}
+    static size_t outputLength(size_t len) { return len; }
+
+    void aad(const uint8_t *data, size_t n) {
+        poly1305Update(mac, data, n);
+        aadLen += n;
+    }
+
+    size_t update(const uint8_t *input, uint8_t *output, size_t n) {
+        closeAad();
+        // Dekripsi: ciphertext masuk MAC sebelum in == out ditimpa
+        if (direction == WSN_STREAM_DECRYPT) poly1305Update(mac, input, n);
+        for (size_t i = 0; i < n; i++) {
+            if (used == Core::KeystreamSize) {
+                WSN_PROFILE_SCOPE(WSN_PROF_KEYSTREAM);
+                core.keystream(keystream);
+                used = 0;
+            }
+            output[i] = input[i] ^ keystream[used++];
+        }
+        if (direction == WSN_STREAM_ENCRYPT) poly1305Update(mac, output, n);
+        textLen += n;
+        return n;
+    }
+
+    size_t final(uint8_t *) { return 0; }
+
+    // Setelah final: tag atas AAD dan ciphertext
+    void tag(uint8_t out[WSN_POLY1305_TAG_SIZE]) {
+        closeAad();
+        chacha20Poly1305End(mac, aadLen, textLen, out);
+    }
+
+private:
+    void closeAad() {
+        if (!aadOpen) return;
+        poly1305PadZeros(mac);
+        aadOpen = false;
+    }
+
+    Core core;
+    WsnPoly1305 mac;
+    uint8_t savedKey[Core::KeySize];
+    uint8_t keystream[Core::KeystreamSize];
+    size_t used = Core::KeystreamSize;
+    size_t aadLen = 0;
+    size_t textLen = 0;
+    bool aadOpen = true;
+    WsnStreamDirection direction = WSN_STREAM_ENCRYPT;
+};
+
+template <class Core>
+using WsnCbcMode = WsnBlockMode<Core, true>;
+template <class Core>
+using WsnEcbMode = WsnBlockMode<Core, false>;
+
+typedef WsnKeystreamMode<WsnChaCha20Core> WsnChaCha20Stream;
+typedef WsnKeystreamMode<WsnSnowVCore> WsnSnowVStream;
+typedef WsnCbcMode<WsnAes256Core> WsnAes256CbcStream;
+typedef WsnEcbMode<WsnClefia256Core> WsnClefia256Stream;     // clefia_sender MESSAGE_IV 0
+typedef WsnCbcMode<WsnClefia256Core> WsnClefia256CbcStream;  // clefia_sender MESSAGE_IV 1
+typedef WsnPoly1305Mode<WsnChaCha20Core> WsnChaChaPolyStream;  // ChaCha20-Poly1305, tag di belakang
+
+#endif // WSN_STREAM_H
@@ -0,0 +1,111 @@
+#ifndef WSN_XCHACHA20_H
+#define WSN_XCHACHA20_H
+
+// XChaCha20 (draft-irtf-cfrg-xchacha): nonce 192 bit, aman dipilih acak.
+//
+//   subkey = HChaCha20(key, nonce[0, 16))
+//   XChaCha20(key, nonce) = ChaCha20(subkey, 0^32 || nonce[16, 24))
+//
+// HChaCha20 sama mahalnya dengan satu blok ChaCha20. XChaCha20Context menyimpan subkey untuk
+// prefix 16 byte terakhir, jadi selama prefix sama (satu sesi WsnSessionNonce) biaya per pesan
+// sama dengan ChaCha20 biasa; receiver juga hanya menghitung ulang saat sender memulai sesi baru.
+//
+// WsnSessionNonce: prefix 128 bit acak per boot + counter pesan 64 bit di RAM. Tidak perlu
+// state persisten (RTC/flash) seperti WsnNonce.h: setelah deep sleep atau power off sesi baru
+// memakai prefix acak baru, peluang tabrakan prefix ~2^-64 setelah 2^32 sesi.
+
+#include "WsnChaChaPoly.h"
+
+#define WSN_XCHACHA_NONCE_SIZE 24
+
+// 20 round tanpa penjumlahan state awal; keluaran word 0-3 dan 12-15
+inline void hchacha20(uint8_t subkey[32], const uint8_t key[32], const uint8_t nonce[16]) {
+    uint32_t x[16];
+    chacha20InitState(x, key, nonce + 4, wsnLoad32(nonce));
+    chacha20Rounds(x);
+    for (int i = 0; i < 4; i++) {
+        wsnStore32(subkey + 4 * i, x[i]);
+        wsnStore32(subkey + 16 + 4 * i, x[12 + i]);
+    }
+}
+
+// Nonce ChaCha20 96 bit dari 8 byte terakhir nonce XChaCha20
+inline void xchacha20InnerNonce(uint8_t inner[12], const uint8_t nonce[WSN_XCHACHA_NONCE_SIZE]) {
+    memset(inner, 0, 4);
+    memcpy(inner + 4, nonce + 16, 8);
+}
+
+struct XChaCha20Context {
+    uint8_t key[32];
+    uint8_t prefix[16];   // nonce[0, 16) milik subkey di cache
+    uint8_t subkey[32];
+    bool valid;
+    uint32_t derivations; // jumlah HChaCha20 yang benar-benar dihitung
+};
+
+inline void xchacha20SetKey(XChaCha20Context &ctx, const uint8_t key[32]) {
+    memcpy(ctx.key, key, 32);
+    ctx.valid = false;
+    ctx.derivations = 0;
+}
+
+// Subkey untuk nonce; HChaCha20 hanya jika prefix berbeda dari pesan sebelumnya
+inline const uint8_t *xchacha20Subkey(XChaCha20Context &ctx, const uint8_t nonce[WSN_XCHACHA_NONCE_SIZE]) {
+    if (!ctx.valid || memcmp(ctx.prefix, nonce, 16) != 0) {
+        WSN_PROFILE_SCOPE(WSN_PROF_KEY_SETUP);
+        hchacha20(ctx.subkey, ctx.key, nonce);
+        memcpy(ctx.prefix, nonce, 16);
+        ctx.valid = true;
+        ctx.derivations++;
+    }
+    return ctx.subkey;
+}
+
+inline void xchacha20EncryptDecrypt(XChaCha20Context &ctx, const uint8_t *input, uint8_t *output, size_t len,
+                                    const uint8_t nonce[WSN_XCHACHA_NONCE_SIZE], uint32_t counter) {
+    uint8_t inner[12];
+    xchacha20InnerNonce(inner, nonce);
+    chacha20EncryptDecrypt(input, output, len, xchacha20Subkey(ctx, nonce), inner, counter);
+}
+
+// XChaCha20-Poly1305 (AEAD_XChaCha20_Poly1305 di draft yang sama)
+inline void xchacha20Poly1305Seal(XChaCha20Context &ctx, const uint8_t nonce[WSN_XCHACHA_NONCE_SIZE],
+                                  const uint8_t *aad, size_t aadLen, const uint8_t *input, uint8_t *output,
+                                  size_t len, uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    uint8_t inner[12];
+    xchacha20InnerNonce(inner, nonce);
+    chacha20Poly1305Seal(xchacha20Subkey(ctx, nonce), inner, aad, aadLen, input, output, len, tag);
+}
+
+inline bool xchacha20Poly1305Open(XChaCha20Context &ctx, const uint8_t nonce[WSN_XCHACHA_NONCE_SIZE],
+                                  const uint8_t *aad, size_t aadLen, const uint8_t *input, uint8_t *output,
+                                  size_t len, const uint8_t tag[WSN_POLY1305_TAG_SIZE]) {
+    uint8_t inner[12];
+    xchacha20InnerNonce(inner, nonce);
+    return chacha20Poly1305Open(xchacha20Subkey(ctx, nonce), inner, aad, aadLen, input, output, len, tag);
+}
+
+// Nonce 24 byte: [0, 16) prefix acak per sesi, [16, 24) counter pesan little-endian
+class WsnSessionNonce {
+public:
+    // Awal setup(), setelah radio menyala (RNG hardware); memulai sesi baru
+    void begin() {
+        wsnRandomBytes(prefix, sizeof(prefix));
+        counterValue = 0;
+    }
+
+    void next(uint8_t nonce[WSN_XCHACHA_NONCE_SIZE]) {
+        memcpy(nonce, prefix, sizeof(prefix));
+        wsnStore32(nonce + 16, (uint32_t)counterValue);
+        wsnStore32(nonce + 20, (uint32_t)(counterValue >> 32));
+        counterValue++;
+    }
+
+    uint64_t counter() const { return counterValue; }
+
+private:
+    uint8_t prefix[16];
+    uint64_t counterValue = 0;
+};
+
+#endif // WSN_XCHACHA20_H
@@ -1,10 +1,29 @@
+import sys
+
 import matplotlib.pyplot as plt
 import numpy as np
+import pandas as pd
 
 algorithms = ['ChaCha20', 'Snow-V',  'Clefia', 'AES-CBC']
 time_10kb = [10994.4, 11257.9, 92659.3, 115393.9]
 time_5kb = [5662, 5663.9, 46563.1, 58884.8]  
 
+# Opsional: ambil median dari output cipher_bench (CSV) alih-alih angka di atas
+#   python computationTime.py bench_esp8266.csv
+if len(sys.argv) > 1:
+    bench = pd.read_csv(sys.argv[1], comment='#').set_index(['cipher', 'bytes'])['median_us']
+    ciphers = ['chacha20', 'snowv', 'clefia256', 'aes256cbc']
+    time_5kb = [round(bench[(c, 5011)], 1) for c in ciphers]
+    time_10kb = [round(bench[(c, 10011)], 1) for c in ciphers]
+
+    # Perbandingan semua kernel (termasuk AEAD) pada beban 5 KB / 10 KB
+    table = pd.read_csv(sys.argv[1], comment='#')
+    table = table[table['bytes'].isin([5011, 10011])]
+    columns = ['cipher', 'bytes', 'median_us', 'mb_per_s']
+    if 'uj_per_byte' in table:
+        columns.append('uj_per_byte')
+    print(table[columns].to_string(index=False))
+
 bar_width = 0.4
 
 # Posisi untuk bar 5KB dan 10KB
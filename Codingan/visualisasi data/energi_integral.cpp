@@ -0,0 +1,222 @@
+// Versi native dari energi_integral.py untuk trace "time,power" yang besar.
+//
+// Satu pass O(n) per file: total energi Left Rectangle, Right Rectangle dan
+// Trapezoid, plus (opsional) kurva energi kumulatif ke CSV. File dibaca lewat
+// mmap per jendela 64 MB sehingga memori tetap konstan untuk capture berukuran GB.
+//
+// Build : g++ -O2 -std=c++17 -o energi_integral energi_integral.cpp
+// Pakai : ./energi_integral chacha_10kb_fix.csv aes_10kb_fix.csv
+//         ./energi_integral -c kumulatif.csv -e 10 data/chacha_2ms.csv
+//
+// Format input sama dengan load_data(): kolom waktu (ms) dan daya (mW) dipisah
+// koma. Baris kosong, header, dan baris berawalan '#' (laporan jendela dari
+// ina_power_2ms) dilewati.
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const size_t MAP_WINDOW = 64UL << 20;
+
+struct EnergyTotals {
+    size_t samples = 0;
+    size_t skipped = 0;
+    double firstTime = 0;   // detik
+    double lastTime = 0;    // detik
+    double left = 0;        // Joule
+    double right = 0;
+    double trapezoid = 0;
+};
+
+class EnergyIntegrator {
+public:
+    EnergyIntegrator(FILE *cumulativeOut, size_t every) : out(cumulativeOut), every(every ? every : 1) {}
+
+    // time dalam ms, power dalam mW (sama seperti CSV dari ina_power_2ms)
+    void addSample(double time_ms, double power_mW) {
+        double t = time_ms / 1000.0;
+        double p = power_mW / 1000.0;
+        if (totals.samples == 0) {
+            totals.firstTime = t;
+        } else {
+            double dt = t - prevTime;
+            totals.left += prevPower * dt;
+            totals.right += p * dt;
+            totals.trapezoid += (prevPower + p) * 0.5 * dt;
+        }
+        prevTime = t;
+        prevPower = p;
+        totals.lastTime = t;
+
+        if (out && totals.samples % every == 0) {
+            fprintf(out, "%.6f,%.9f,%.9f,%.9f\n", t, totals.left, totals.right, totals.trapezoid);
+        }
+        totals.samples++;
+    }
+
+    // Pastikan titik terakhir selalu ada di kurva kumulatif
+    void finish() {
+        if (out && totals.samples > 0 && (totals.samples - 1) % every != 0) {
+            fprintf(out, "%.6f,%.9f,%.9f,%.9f\n", prevTime, totals.left, totals.right, totals.trapezoid);
+        }
+    }
+
+    void parseLine(const char *begin, const char *end) {
+        while (begin < end && (*begin == ' ' || *begin == '\t')) begin++;
+        if (begin == end || *begin == '#' || *begin == '\r') return;
+
+        double time_ms, power_mW;
+        auto first = std::from_chars(begin, end, time_ms);
+        if (first.ec != std::errc() || first.ptr == end || *first.ptr != ',') {
+            totals.skipped++;
+            return;
+        }
+        const char *second = first.ptr + 1;
+        while (second < end && *second == ' ') second++;
+        auto last = std::from_chars(second, end, power_mW);
+        if (last.ec != std::errc()) {
+            totals.skipped++;
+            return;
+        }
+        addSample(time_ms, power_mW);
+    }
+
+    EnergyTotals totals;
+
+private:
+    FILE *out;
+    size_t every;
+    double prevTime = 0;
+    double prevPower = 0;
+};
+
+// Baca file per jendela mmap. Baris yang terpotong di batas jendela disimpan
+// di `carry` (paling panjang satu baris) lalu disambung dengan jendela berikutnya.
+bool processFile(const char *path, EnergyIntegrator &integrator) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror(path);
+        close(fd);
+        return false;
+    }
+
+    std::string carry;
+    size_t fileSize = st.st_size;
+    for (size_t offset = 0; offset < fileSize; offset += MAP_WINDOW) {
+        size_t length = fileSize - offset < MAP_WINDOW ? fileSize - offset : MAP_WINDOW;
+        void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, offset);
+        if (mapped == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return false;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL);
+
+        const char *data = (const char *)mapped;
+        const char *end = data + length;
+        const char *line = data;
+
+        if (!carry.empty()) {
+            const char *newline = (const char *)memchr(line, '\n', end - line);
+            if (newline) {
+                carry.append(line, newline);
+                integrator.parseLine(carry.data(), carry.data() + carry.size());
+                carry.clear();
+                line = newline + 1;
+            } else {
+                carry.append(line, end);
+                line = end;
+            }
+        }
+
+        while (line < end) {
+            const char *newline = (const char *)memchr(line, '\n', end - line);
+            if (!newline) {
+                carry.assign(line, end);
+                break;
+            }
+            integrator.parseLine(line, newline);
+            line = newline + 1;
+        }
+
+        munmap(mapped, length);
+    }
+    if (!carry.empty()) {
+        integrator.parseLine(carry.data(), carry.data() + carry.size());
+    }
+
+    close(fd);
+    return true;
+}
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+            "Penggunaan: %s [-c kumulatif.csv] [-e N] file.csv [file.csv ...]\n"
+            "  -c FILE  tulis energi kumulatif (time_sec,left,right,trapezoid)\n"
+            "  -e N     tulis satu baris kumulatif setiap N sampel (default 1)\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    const char *cumulativePath = nullptr;
+    size_t every = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "c:e:h")) != -1) {
+        switch (opt) {
+        case 'c': cumulativePath = optarg; break;
+        case 'e': every = strtoul(optarg, nullptr, 10); break;
+        default:
+            printUsage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind >= argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    FILE *cumulative = nullptr;
+    if (cumulativePath) {
+        cumulative = fopen(cumulativePath, "w");
+        if (!cumulative) {
+            perror(cumulativePath);
+            return 1;
+        }
+        static char outBuffer[1 << 20];
+        setvbuf(cumulative, outBuffer, _IOFBF, sizeof(outBuffer));
+        fprintf(cumulative, "time_sec,left_J,right_J,trapezoid_J\n");
+    }
+
+    int status = 0;
+    for (int i = optind; i < argc; i++) {
+        if (cumulative) fprintf(cumulative, "# %s\n", argv[i]);
+        EnergyIntegrator integrator(cumulative, every);
+        if (!processFile(argv[i], integrator)) {
+            status = 1;
+            continue;
+        }
+        integrator.finish();
+
+        const EnergyTotals &t = integrator.totals;
+        printf("%s\n", argv[i]);
+        printf("  Samples: %zu (skipped %zu), duration %.3f s\n", t.samples, t.skipped, t.lastTime - t.firstTime);
+        printf("  Total Energy (Left Rectangle Rule): %.9f Joules\n", t.left);
+        printf("  Total Energy (Right Rectangle Rule): %.9f Joules\n", t.right);
+        printf("  Total Energy (Trapezoid Rule): %.9f Joules\n", t.trapezoid);
+    }
+
+    if (cumulative) fclose(cumulative);
+    return status;
+}
@@ -57,11 +57,9 @@ def main(file_path):
     cumulative_energy_left = np.cumsum(df['power_watt'][:-1] * delta_t)
     cumulative_energy_right = np.cumsum(df['power_watt'][1:] * delta_t)
     
-    # Untuk trapezoid, kita perlu menghitung kumulatif berdasarkan aturan trapezoid
-    # Menghitung kumulatif energi trapezoid di setiap langkah
-    cumulative_energy_trapezoid = np.zeros(len(df['time_sec']))
-    for i in range(1, len(df['time_sec'])):
-        cumulative_energy_trapezoid[i] = np.trapz(df['power_watt'][:i+1], df['time_sec'][:i+1])
+    # Kumulatif trapezoid dalam satu pass (O(n)); untuk trace besar pakai energi_integral.cpp
+    power = df['power_watt'].to_numpy()
+    cumulative_energy_trapezoid = np.concatenate(([0.0], np.cumsum((power[:-1] + power[1:]) / 2 * delta_t)))
 
     plt.subplot(2, 1, 2)
     plt.plot(df['time_sec'][1:], cumulative_energy_left, label='Left Rectangle Rule', color='red')
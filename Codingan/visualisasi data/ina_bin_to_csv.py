@@ -0,0 +1,75 @@
+import struct
+import sys
+from datetime import datetime, timedelta, timezone
+
+# Konversi file biner dari inaTOsdcard.ino (sensor_data.bin) ke CSV
+# dengan kolom yang sama seperti logger lama.
+
+SECTOR_SIZE = 512
+HEADER_FORMAT = '<4sHHHHHHIqI'
+SAMPLE_FORMAT = '<IhHH'
+SECTOR_FLAG_OVERRUN = 0x01
+
+
+def read_header(f):
+    sector = f.read(SECTOR_SIZE)
+    fields = struct.unpack_from(HEADER_FORMAT, sector)
+    if fields[0] != b'INA1':
+        raise ValueError('Bukan file INA1')
+    keys = ['magic', 'version', 'sample_size', 'samples_per_sector', 'current_lsb_uA',
+            'power_lsb_mW', 'shunt_mOhm', 'sample_interval_us', 'epoch_us', 'micros_ref']
+    return dict(zip(keys, fields))
+
+
+def iter_samples(f, header):
+    sample_size = header['sample_size']
+    sequence = None
+    while True:
+        sector = f.read(SECTOR_SIZE)
+        if len(sector) < SECTOR_SIZE:
+            break
+        seq, count, flags = struct.unpack_from('<HBB', sector)
+        if flags & SECTOR_FLAG_OVERRUN:
+            print(f'Peringatan: sampel hilang sebelum sektor {seq}', file=sys.stderr)
+        if sequence is not None and seq != (sequence + 1) & 0xFFFF:
+            print(f'Peringatan: sektor {seq} tidak berurutan', file=sys.stderr)
+        sequence = seq
+        for i in range(count):
+            yield struct.unpack_from(SAMPLE_FORMAT, sector, 4 + i * sample_size)
+
+
+def convert(input_file, output_file):
+    with open(input_file, 'rb') as f, open(output_file, 'w', newline='') as out:
+        header = read_header(f)
+        current_lsb_mA = header['current_lsb_uA'] / 1000
+        shunt_ohm = header['shunt_mOhm'] / 1000
+        start = datetime.fromtimestamp(header['epoch_us'] / 1e6, tz=timezone.utc)
+
+        out.write('Timestamp,Power (mW),Bus Voltage (V),Load Voltage (V),Current (mA)\n')
+
+        # micros() wrap setiap ~71 menit, jadi waktu di-unwrap secara inkremental
+        last_us = header['micros_ref']
+        elapsed_us = 0
+        rows = 0
+        for timestamp_us, current_raw, bus_raw, power_raw in iter_samples(f, header):
+            elapsed_us += (timestamp_us - last_us) & 0xFFFFFFFF
+            last_us = timestamp_us
+
+            current_mA = current_raw * current_lsb_mA
+            busvoltage = bus_raw * 0.004
+            power_mW = power_raw * header['power_lsb_mW']
+            loadvoltage = busvoltage + current_mA * shunt_ohm / 1000
+
+            t = start + timedelta(microseconds=elapsed_us)
+            timestamp = t.strftime('%H:%M:%S.') + f'{t.microsecond // 1000:03d}'
+            out.write(f'{timestamp},{power_mW:.2f},{busvoltage:.2f},{loadvoltage:.2f},{current_mA:.2f}\n')
+            rows += 1
+
+    print(f'{rows} sampel ditulis ke {output_file}.')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Penggunaan: python ina_bin_to_csv.py sensor_data.bin sensor_data.csv')
+        sys.exit(1)
+    convert(sys.argv[1], sys.argv[2])
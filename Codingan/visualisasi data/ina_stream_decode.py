@@ -0,0 +1,148 @@
+import struct
+import sys
+
+# Decoder stream biner dari ina_power_2ms.ino (HIGH_RATE_MODE 1).
+# Input: file hasil capture serial mentah, atau port serial langsung (butuh pyserial).
+# Output: CSV "time,power" seperti data lama (waktu dalam ms, daya dalam mW),
+# dengan resolusi waktu mikrodetik (3 angka desimal pada kolom ms).
+# Laporan jendela energi dari meter ditulis ke <output>_windows.csv.
+#
+# Penggunaan:
+#   python ina_stream_decode.py capture.bin chacha_fast.csv
+#   python ina_stream_decode.py COM5 chacha_fast.csv      (Ctrl+C untuk berhenti)
+
+FRAME_TYPE_SAMPLES = 0x01
+FRAME_TYPE_WINDOW = 0x02
+WINDOW_FORMAT = '<BHIIQI'
+BATCH_HEADER = '<BBBI'
+SAMPLE_FORMAT = '<HHH'
+POWER_LSB_MW = 2
+SERIAL_BAUD_RATE = 921600
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError('Frame COBS rusak')
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def iter_frames(chunks):
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer += chunk
+        while True:
+            end = buffer.find(b'\x00')
+            if end < 0:
+                break
+            frame = bytes(buffer[:end])
+            del buffer[:end + 1]
+            if frame:
+                yield frame
+
+
+def iter_samples(chunks, stats, on_window=None):
+    last_seq = None
+    for encoded in iter_frames(chunks):
+        try:
+            frame = cobs_decode(encoded)
+        except ValueError:
+            stats['bad'] += 1
+            continue
+        payload, crc = frame[:-2], frame[-2:]
+        if len(frame) < 9 or crc16(payload) != struct.unpack('<H', crc)[0]:
+            stats['bad'] += 1
+            continue
+        if payload[0] == FRAME_TYPE_WINDOW:
+            if on_window is not None:
+                on_window(struct.unpack_from(WINDOW_FORMAT, payload)[1:])
+            continue
+        frame_type, seq, count, base_us = struct.unpack_from(BATCH_HEADER, payload)
+        if frame_type != FRAME_TYPE_SAMPLES:
+            continue
+        if last_seq is not None and seq != (last_seq + 1) & 0xFF:
+            stats['lost'] += (seq - last_seq - 1) & 0xFF
+        last_seq = seq
+        offset = struct.calcsize(BATCH_HEADER)
+        for i in range(count):
+            dt_us, power_raw, bus_raw = struct.unpack_from(SAMPLE_FORMAT, payload, offset + i * 6)
+            yield (base_us + dt_us) & 0xFFFFFFFF, power_raw, bus_raw
+
+
+def open_source(name):
+    try:
+        f = open(name, 'rb')
+    except OSError:
+        import serial  # pyserial
+        f = serial.Serial(name, SERIAL_BAUD_RATE, timeout=1)
+    return f
+
+
+def read_chunks(f):
+    while True:
+        chunk = f.read(4096)
+        if not chunk:
+            if hasattr(f, 'in_waiting'):
+                continue
+            break
+        yield chunk
+
+
+def decode(source, output_file):
+    stats = {'bad': 0, 'lost': 0}
+    rows = 0
+    windows_file = output_file.rsplit('.', 1)[0] + '_windows.csv'
+    f = open_source(source)
+    try:
+        with open(output_file, 'w', newline='') as out, open(windows_file, 'w', newline='') as win:
+            win.write('window,duration_us,samples,energy_J,mean_mW,peak_mW\n')
+
+            def on_window(report):
+                index, duration_us, samples, energy_nJ, peak_uW = report
+                energy_J = energy_nJ * 1e-9
+                mean_mW = energy_J / (duration_us * 1e-6) * 1000 if duration_us else 0.0
+                line = f'{index},{duration_us},{samples},{energy_J:.9f},{mean_mW:.4f},{peak_uW / 1000:.4f}'
+                win.write(line + '\n')
+                print('window', line)
+
+            # micros() wrap setiap ~71 menit, unwrap agar waktu tetap naik
+            wraps = 0
+            last_us = None
+            for time_us, power_raw, bus_raw in iter_samples(read_chunks(f), stats, on_window):
+                if last_us is not None and time_us < last_us and last_us - time_us > 0x80000000:
+                    wraps += 1
+                last_us = time_us
+                time_ms = (time_us + wraps * 0x100000000) / 1000
+                out.write(f'{time_ms:.3f},{power_raw * POWER_LSB_MW:.4f}\n')
+                rows += 1
+    except KeyboardInterrupt:
+        pass
+    finally:
+        f.close()
+
+    print(f'{rows} sampel ditulis ke {output_file} '
+          f'(frame rusak: {stats["bad"]}, batch hilang: {stats["lost"]}).')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Penggunaan: python ina_stream_decode.py <capture.bin|PORT> <output.csv>')
+        sys.exit(1)
+    decode(sys.argv[1], sys.argv[2])
@@ -0,0 +1,80 @@
+import argparse
+
+import numpy as np
+import pandas as pd
+
+# Breakdown latensi end-to-end dari log serial receiver (LATENCY_TRACE 1 di chacha_receiver).
+# Setiap pesan menghasilkan satu baris:
+#   lat,seq,encrypt,queue,send,first_air,last_air,reassembly,store,total,offset,rtt
+# (semua dalam mikrodetik; offset/rtt = estimasi sinkronisasi clock saat pesan diproses).
+# Baris lain di log diabaikan.
+#
+# Contoh:
+#   python latency_report.py receiver_log.txt
+#   python latency_report.py receiver_log.txt --csv latency_chacha.csv
+
+STAGES = ['encrypt', 'queue', 'send', 'first_air', 'last_air', 'reassembly', 'store', 'total']
+COLUMNS = ['seq'] + STAGES + ['offset_us', 'rtt_us']
+
+
+def load_records(file_path):
+    rows = []
+    with open(file_path, errors='replace') as f:
+        for line in f:
+            if not line.startswith('lat,'):
+                continue
+            fields = line.strip().split(',')[1:]
+            if len(fields) != len(COLUMNS):
+                continue  # baris terpotong di log serial
+            try:
+                rows.append([int(v) for v in fields])
+            except ValueError:
+                continue
+    return pd.DataFrame(rows, columns=COLUMNS)
+
+
+def summarize(records):
+    rows = []
+    for stage in STAGES:
+        values = records[stage].to_numpy(dtype=float) / 1000
+        rows.append({
+            'stage': stage,
+            'count': len(values),
+            'mean_ms': values.mean(),
+            'p50_ms': np.percentile(values, 50),
+            'p95_ms': np.percentile(values, 95),
+            'p99_ms': np.percentile(values, 99),
+            'max_ms': values.max(),
+        })
+    return pd.DataFrame(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Ringkasan latensi per stage dari log receiver')
+    parser.add_argument('files', nargs='+')
+    parser.add_argument('--csv', help='simpan ringkasan ke CSV')
+    args = parser.parse_args()
+
+    summaries = []
+    for file_path in args.files:
+        records = load_records(file_path)
+        if records.empty:
+            print(f'{file_path}: tidak ada baris "lat,"; pastikan LATENCY_TRACE 1 di sender dan receiver')
+            continue
+        # Pesan yang hilang terlihat dari lompatan nomor urut
+        lost = int((records['seq'].diff().dropna() - 1).clip(lower=0).sum())
+        print(f'{file_path}: {len(records)} pesan, {lost} hilang, '
+              f'rtt sinkronisasi median {records["rtt_us"].median():.0f} us')
+        summary = summarize(records)
+        print(summary.to_string(index=False, float_format=lambda v: f'{v:.3f}'))
+        print()
+        summary.insert(0, 'file', file_path)
+        summaries.append(summary)
+
+    if args.csv and summaries:
+        pd.concat(summaries).to_csv(args.csv, index=False)
+        print(f'Ringkasan disimpan ke {args.csv}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,154 @@
+import argparse
+import re
+import struct
+import sys
+
+from ina_stream_decode import crc16, cobs_decode, iter_frames, read_chunks
+
+# Decoder log biner dari sketch yang memakai WsnLog.h (chacha_sender, snowv_sender_fix, ...).
+# Tabel format dibaca langsung dari X-macro WSN_LOG_FORMATS di source sketch, jadi ID dan
+# teks selalu sinkron dengan firmware yang di-flash.
+#
+# Byte yang bukan frame log (Serial.println biasa, dump profil) dicetak apa adanya.
+#
+# Penggunaan:
+#   python log_decode.py COM3 --formats ../code/ChaCha20/chacha_sender/chacha_sender.ino
+#   python log_decode.py capture.bin --formats snowv_sender_fix.ino --time > log.txt
+
+ID_DROPPED = 0xFF
+SERIAL_BAUD_RATE = 115200
+
+ENTRY_PATTERN = re.compile(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+SPEC_PATTERN = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diouxXeEfgGcsb%])')
+
+
+def load_formats(path):
+    with open(path, errors='replace') as f:
+        source = f.read()
+    start = source.find('#define WSN_LOG_FORMATS')
+    if start < 0:
+        raise SystemExit(f'{path}: tidak ada #define WSN_LOG_FORMATS')
+    # Definisi makro berakhir di baris pertama tanpa backslash
+    end = start
+    while True:
+        newline = source.find('\n', end)
+        if newline < 0 or not source[:newline].rstrip().endswith('\\'):
+            break
+        end = newline + 1
+    block = source[start:newline if newline >= 0 else len(source)]
+    formats = [bytes(fmt, 'utf-8').decode('unicode_escape') for _, fmt in ENTRY_PATTERN.findall(block)]
+    formats_by_id = dict(enumerate(formats))
+    formats_by_id[ID_DROPPED] = '[log] %u record dibuang (ring penuh)'
+    return formats_by_id
+
+
+def parse_args(payload):
+    args = []
+    i = 5
+    while i < len(payload):
+        tag = chr(payload[i])
+        if tag in 'uif':
+            code = {'u': '<I', 'i': '<i', 'f': '<f'}[tag]
+            args.append(struct.unpack_from(code, payload, i + 1)[0])
+            i += 5
+        elif tag in 'sb':
+            n = payload[i + 1]
+            raw = payload[i + 2:i + 2 + n]
+            args.append(raw.decode('utf-8', errors='replace') if tag == 's' else raw.hex().upper())
+            i += 2 + n
+        else:
+            raise ValueError(f'tag argumen tidak dikenal {tag!r}')
+    return args
+
+
+def render(fmt, args):
+    values = iter(args)
+
+    def substitute(match):
+        flags, conv = match.groups()
+        if conv == '%':
+            return '%'
+        value = next(values, '?')
+        if conv == 'b':
+            conv = 's'
+        if conv in 'dioxXuc' and not isinstance(value, int):
+            return str(value)
+        return ('%' + flags + conv.replace('u', 'd')) % value
+
+    return SPEC_PATTERN.sub(substitute, fmt)
+
+
+def decode_frame(encoded):
+    frame = cobs_decode(encoded)
+    payload, crc = frame[:-2], frame[-2:]
+    if len(frame) < 7 or crc16(payload) != struct.unpack('<H', crc)[0]:
+        raise ValueError('CRC salah')
+    return payload
+
+
+def split_frame(segment):
+    """Teks biasa bisa menempel di depan frame (tanpa 0x00 di antaranya).
+
+    Posisi awal frame dicari dari depan; yang pertama lolos COBS + CRC dianggap frame.
+    Frame sendiri boleh berisi byte '\n', jadi newline tidak bisa dipakai sebagai batas.
+    """
+    for start in range(len(segment)):
+        try:
+            return segment[:start], decode_frame(segment[start:])
+        except (ValueError, IndexError, struct.error):
+            continue
+    return segment, None
+
+
+def decode(chunks, formats, show_time, out):
+    stats = {'records': 0, 'bad': 0}
+    for segment in iter_frames(chunks):
+        text, payload = split_frame(segment)
+        if payload is None:
+            stats['bad'] += 1
+        if text:
+            text = text.decode('utf-8', errors='replace')
+            out.write(text if text.endswith('\n') or payload is None else text + '\n')
+        if payload is None:
+            continue
+
+        record_id = payload[0]
+        timestamp_us = struct.unpack_from('<I', payload, 1)[0]
+        try:
+            line = render(formats.get(record_id, f'[log] id {record_id} tidak dikenal %s'), parse_args(payload))
+        except (ValueError, IndexError, struct.error, TypeError) as e:
+            stats['bad'] += 1
+            line = f'[log] record id {record_id} rusak: {e}'
+        if show_time:
+            line = f'{timestamp_us / 1e6:12.6f} {line}'
+        out.write(line + '\n')
+        stats['records'] += 1
+    return stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode log biner WsnLog dari serial atau file capture')
+    parser.add_argument('source', help='port serial (COM3, /dev/ttyUSB0) atau file capture mentah')
+    parser.add_argument('--formats', required=True, help='source sketch berisi #define WSN_LOG_FORMATS')
+    parser.add_argument('--baud', type=int, default=SERIAL_BAUD_RATE)
+    parser.add_argument('--time', action='store_true', help='awali tiap baris dengan micros() node (detik)')
+    args = parser.parse_args()
+
+    formats = load_formats(args.formats)
+    try:
+        f = open(args.source, 'rb')
+    except OSError:
+        import serial  # pyserial
+        f = serial.Serial(args.source, args.baud, timeout=1)
+    try:
+        stats = decode(read_chunks(f), formats, args.time, sys.stdout)
+    except KeyboardInterrupt:
+        stats = None
+    finally:
+        f.close()
+    if stats:
+        print(f'# {stats["records"]} record, {stats["bad"]} frame rusak', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,70 @@
+import argparse
+import sys
+
+import sensor_decode
+
+# Decoder pesan terkompresi WsnLz.h (LZ_COMPRESS 1 di sender) di host.
+# Input: file berisi satu pesan hasil dekripsi. Jika hasil dekompresi adalah pesan
+# WsnSensorCodec (SENSOR_CODEC 1 juga aktif), langsung diteruskan ke sensor_decode.
+#
+# Penggunaan:
+#   python lz_decode.py pesan.bin               (cetak teks asli)
+#   python lz_decode.py pesan.bin -o asli.bin   (simpan hasil dekompresi apa adanya)
+
+MAGIC = 0xC7
+MIN_MATCH = 3
+
+
+def decompress(data):
+    if len(data) < 2 or data[0] != MAGIC:
+        raise ValueError('bukan pesan WsnLz')
+    r = sensor_decode.Reader(data)
+    r.pos = 1
+    total = r.varint()
+    out = bytearray()
+    while len(out) < total:
+        token = r.byte()
+        if not token & 0x80:
+            count = token + 1
+            if r.pos + count > len(data):
+                raise ValueError('pesan terpotong')
+            out += data[r.pos:r.pos + count]
+            r.pos += count
+        else:
+            offset = ((token & 3) << 8 | r.byte()) + 1
+            count = ((token >> 2) & 31) + MIN_MATCH
+            if count == 31 + MIN_MATCH:
+                count = 34 + r.byte()
+            if offset > len(out):
+                raise ValueError('offset di luar jendela')
+            # Per byte: sumber boleh tumpang tindih dengan tujuan
+            for _ in range(count):
+                out.append(out[-offset])
+    if len(out) != total:
+        raise ValueError('panjang tidak cocok')
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode pesan terkompresi WsnLz')
+    parser.add_argument('files', nargs='+')
+    parser.add_argument('-o', '--output', help='tulis hasil dekompresi (satu file input)')
+    args = parser.parse_args()
+
+    for path in args.files:
+        with open(path, 'rb') as f:
+            data = f.read()
+        plain = decompress(data)
+        print(f'# {path}: {len(data)} byte -> {len(plain)} byte', file=sys.stderr)
+        if args.output:
+            with open(args.output, 'wb') as f:
+                f.write(plain)
+        elif plain and plain[0] == sensor_decode.MAGIC:
+            _, prefix, readings, suffix = sensor_decode.decode(plain)
+            sys.stdout.write(sensor_decode.to_text(prefix, readings, suffix) + '\n')
+        else:
+            sys.stdout.write(plain.decode('latin-1') + '\n')
+
+
+if __name__ == '__main__':
+    main()
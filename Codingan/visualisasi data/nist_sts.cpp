@@ -0,0 +1,549 @@
+// Battery uji keacakan NIST SP 800-22 (rev. 1a) untuk dump ciphertext berukuran besar.
+//
+// Pengganti native untuk nist.py / shannon&chi.py: input di-stream per sekuens n bit,
+// setiap pasangan (sekuens, uji) dikerjakan paralel oleh thread pool, dan jumlah
+// sekuens yang sedang diproses dibatasi sehingga memori konstan.
+//
+// Uji: Frequency (monobit), Block Frequency, Runs, Longest Run of Ones, DFT (spectral),
+// Serial, Approximate Entropy, Cumulative Sums (forward/backward).
+// Per uji dilaporkan proporsi sekuens yang lolos (alpha 0.01) dan uniformitas p-value
+// (chi-square 10 bin), sama seperti laporan finalAnalysisReport dari NIST STS.
+//
+// Build : g++ -O2 -std=c++17 -pthread -o nist_sts nist_sts.cpp
+// Pakai : ./nist_sts chacha_ciphertext.bin
+//         ./nist_sts --hex -n 100000 serial_log.txt   (ambil digit hex dari log serial)
+//
+// DFT memakai FFT radix-2, sehingga uji ini memakai 2^floor(log2 n) bit pertama
+// tiap sekuens (default n = 2^20 sudah pangkat dua).
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+typedef std::vector<uint8_t> Bits;  // satu bit per byte (0/1)
+
+const double ALPHA = 0.01;
+
+// ---------------------------------------------------------------------------
+// Fungsi gamma tidak lengkap (Cephes), dipakai oleh semua uji berbasis chi-square
+
+double igamc(double a, double x);
+
+double igam(double a, double x) {
+    if (x <= 0 || a <= 0) return 0.0;
+    if (x > 1.0 && x > a) return 1.0 - igamc(a, x);
+
+    double ax = a * std::log(x) - x - std::lgamma(a);
+    if (ax < -709.78) return 0.0;
+    ax = std::exp(ax);
+
+    double r = a, c = 1.0, ans = 1.0;
+    do {
+        r += 1.0;
+        c *= x / r;
+        ans += c;
+    } while (c / ans > 1e-15);
+    return ans * ax / a;
+}
+
+double igamc(double a, double x) {
+    if (x <= 0 || a <= 0) return 1.0;
+    if (x < 1.0 || x < a) return 1.0 - igam(a, x);
+
+    double ax = a * std::log(x) - x - std::lgamma(a);
+    if (ax < -709.78) return 0.0;
+    ax = std::exp(ax);
+
+    const double big = 4.503599627370496e15, biginv = 2.22044604925031308085e-16;
+    double y = 1.0 - a, z = x + y + 1.0, c = 0.0;
+    double pkm2 = 1.0, qkm2 = x, pkm1 = x + 1.0, qkm1 = z * x;
+    double ans = pkm1 / qkm1, t;
+    do {
+        c += 1.0;
+        y += 1.0;
+        z += 2.0;
+        double yc = y * c;
+        double pk = pkm1 * z - pkm2 * yc;
+        double qk = qkm1 * z - qkm2 * yc;
+        if (qk != 0) {
+            double r = pk / qk;
+            t = std::fabs((ans - r) / r);
+            ans = r;
+        } else {
+            t = 1.0;
+        }
+        pkm2 = pkm1; pkm1 = pk;
+        qkm2 = qkm1; qkm1 = qk;
+        if (std::fabs(pk) > big) {
+            pkm2 *= biginv; pkm1 *= biginv;
+            qkm2 *= biginv; qkm1 *= biginv;
+        }
+    } while (t > 1e-15);
+    return ans * ax;
+}
+
+double normalCdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// ---------------------------------------------------------------------------
+// Uji SP 800-22. Setiap fungsi mengembalikan satu atau lebih p-value.
+
+std::vector<double> frequencyTest(const Bits &e) {
+    double n = e.size();
+    long sum = 0;
+    for (uint8_t b : e) sum += b ? 1 : -1;
+    double sObs = std::fabs((double)sum) / std::sqrt(n);
+    return {std::erfc(sObs / std::sqrt(2.0))};
+}
+
+std::vector<double> blockFrequencyTest(const Bits &e, size_t M) {
+    size_t N = e.size() / M;
+    double chi2 = 0;
+    for (size_t i = 0; i < N; i++) {
+        size_t ones = 0;
+        for (size_t j = 0; j < M; j++) ones += e[i * M + j];
+        double pi = (double)ones / M - 0.5;
+        chi2 += pi * pi;
+    }
+    chi2 *= 4.0 * M;
+    return {igamc(N / 2.0, chi2 / 2.0)};
+}
+
+std::vector<double> runsTest(const Bits &e) {
+    double n = e.size();
+    size_t ones = 0;
+    for (uint8_t b : e) ones += b;
+    double pi = ones / n;
+    // Prasyarat uji frequency; bila gagal p-value = 0
+    if (std::fabs(pi - 0.5) >= 2.0 / std::sqrt(n)) return {0.0};
+
+    size_t runs = 1;
+    for (size_t k = 1; k < e.size(); k++) runs += e[k] != e[k - 1];
+    double num = std::fabs(runs - 2.0 * n * pi * (1 - pi));
+    double den = 2.0 * std::sqrt(2.0 * n) * pi * (1 - pi);
+    return {std::erfc(num / den)};
+}
+
+std::vector<double> longestRunTest(const Bits &e) {
+    size_t n = e.size();
+    size_t M, K;
+    int vMin;
+    std::vector<double> pi;
+    if (n < 6272) {
+        M = 8; K = 3; vMin = 1;
+        pi = {0.21484375, 0.3671875, 0.23046875, 0.1875};
+    } else if (n < 750000) {
+        M = 128; K = 5; vMin = 4;
+        pi = {0.1174035788, 0.242955959, 0.249363483, 0.17517706, 0.102701071, 0.112398847};
+    } else {
+        M = 10000; K = 6; vMin = 10;
+        pi = {0.0882, 0.2092, 0.2483, 0.1933, 0.1208, 0.0675, 0.0727};
+    }
+
+    size_t N = n / M;
+    std::vector<size_t> v(K + 1, 0);
+    for (size_t i = 0; i < N; i++) {
+        int longest = 0, run = 0;
+        for (size_t j = 0; j < M; j++) {
+            run = e[i * M + j] ? run + 1 : 0;
+            longest = std::max(longest, run);
+        }
+        int bin = std::min(std::max(longest - vMin, 0), (int)K);
+        v[bin]++;
+    }
+    double chi2 = 0;
+    for (size_t i = 0; i <= K; i++) {
+        double expected = N * pi[i];
+        chi2 += (v[i] - expected) * (v[i] - expected) / expected;
+    }
+    return {igamc(K / 2.0, chi2 / 2.0)};
+}
+
+void fft(std::vector<std::complex<double>> &a) {
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double angle = -2 * M_PI / len;
+        std::complex<double> wlen(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1);
+            for (size_t j = 0; j < len / 2; j++) {
+                std::complex<double> u = a[i + j], v = a[i + j + len / 2] * w;
+                a[i + j] = u + v;
+                a[i + j + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+std::vector<double> dftTest(const Bits &e) {
+    size_t n = 1;
+    while (n * 2 <= e.size()) n *= 2;
+    std::vector<std::complex<double>> x(n);
+    for (size_t i = 0; i < n; i++) x[i] = e[i] ? 1.0 : -1.0;
+    fft(x);
+
+    double T = std::sqrt(std::log(1.0 / 0.05) * n);
+    double N0 = 0.95 * n / 2.0;
+    size_t N1 = 0;
+    for (size_t i = 0; i < n / 2; i++) N1 += std::abs(x[i]) < T;
+    double d = (N1 - N0) / std::sqrt(n * 0.95 * 0.05 / 4.0);
+    return {std::erfc(std::fabs(d) / std::sqrt(2.0))};
+}
+
+// Frekuensi pola m-bit yang overlapping, dengan m-1 bit awal disambung ke akhir
+std::vector<size_t> patternCounts(const Bits &e, int m) {
+    std::vector<size_t> counts((size_t)1 << m, 0);
+    if (m == 0) return counts;
+    size_t n = e.size();
+    size_t mask = ((size_t)1 << m) - 1;
+    size_t pattern = 0;
+    for (int i = 0; i < m - 1; i++) pattern = (pattern << 1) | e[i];
+    for (size_t i = m - 1; i < n + m - 1; i++) {
+        pattern = ((pattern << 1) | e[i % n]) & mask;
+        counts[pattern]++;
+    }
+    return counts;
+}
+
+double psiSquared(const Bits &e, int m) {
+    if (m <= 0) return 0.0;
+    std::vector<size_t> counts = patternCounts(e, m);
+    double n = e.size(), sum = 0;
+    for (size_t c : counts) sum += (double)c * c;
+    return sum * std::pow(2.0, m) / n - n;
+}
+
+std::vector<double> serialTest(const Bits &e, int m) {
+    double psim0 = psiSquared(e, m);
+    double psim1 = psiSquared(e, m - 1);
+    double psim2 = psiSquared(e, m - 2);
+    double del1 = psim0 - psim1;
+    double del2 = psim0 - 2.0 * psim1 + psim2;
+    return {igamc(std::pow(2.0, m - 1) / 2, del1 / 2.0), igamc(std::pow(2.0, m - 2) / 2, del2 / 2.0)};
+}
+
+double phi(const Bits &e, int m) {
+    if (m == 0) return 0.0;
+    std::vector<size_t> counts = patternCounts(e, m);
+    double n = e.size(), sum = 0;
+    for (size_t c : counts) {
+        if (c) sum += (c / n) * std::log(c / n);
+    }
+    return sum;
+}
+
+std::vector<double> approximateEntropyTest(const Bits &e, int m) {
+    double n = e.size();
+    double apEn = phi(e, m) - phi(e, m + 1);
+    double chi2 = 2.0 * n * (std::log(2.0) - apEn);
+    return {igamc(std::pow(2.0, m - 1), chi2 / 2.0)};
+}
+
+double cusumPValue(double z, double n) {
+    double sqrtN = std::sqrt(n);
+    double sum1 = 0, sum2 = 0;
+    for (long k = (long)std::floor((-n / z + 1) / 4); k <= (long)std::floor((n / z - 1) / 4); k++) {
+        sum1 += normalCdf((4 * k + 1) * z / sqrtN) - normalCdf((4 * k - 1) * z / sqrtN);
+    }
+    for (long k = (long)std::floor((-n / z - 3) / 4); k <= (long)std::floor((n / z - 1) / 4); k++) {
+        sum2 += normalCdf((4 * k + 3) * z / sqrtN) - normalCdf((4 * k + 1) * z / sqrtN);
+    }
+    return 1.0 - sum1 + sum2;
+}
+
+std::vector<double> cumulativeSumsTest(const Bits &e) {
+    long s = 0, forward = 0, sMin = 0, sMax = 0;
+    for (uint8_t b : e) {
+        s += b ? 1 : -1;
+        forward = std::max(forward, std::labs(s));
+        sMin = std::min(sMin, s);
+        sMax = std::max(sMax, s);
+    }
+    // Maksimum |S| dari belakang = max(S_n - S_k) untuk semua k, termasuk k = 0
+    long backward = std::max(s - sMin, sMax - s);
+    double n = e.size();
+    return {cusumPValue(forward, n), cusumPValue(backward, n)};
+}
+
+// ---------------------------------------------------------------------------
+// Thread pool dan agregasi hasil
+
+struct TestSpec {
+    const char *name;
+    std::function<std::vector<double>(const Bits &)> run;
+    std::vector<std::vector<double>> pValues;  // [sub-uji][sekuens]
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads) {
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread &t : workers) t.join();
+    }
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push(std::move(job));
+        }
+        available.notify_one();
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+};
+
+// Membatasi jumlah sekuens yang sedang diuji agar memori tidak tumbuh dengan ukuran input
+class InFlightLimit {
+public:
+    explicit InFlightLimit(size_t limit) : limit(limit) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [this] { return count < limit; });
+        count++;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count--;
+        }
+        released.notify_all();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [this] { return count == 0; });
+    }
+
+private:
+    size_t limit;
+    size_t count = 0;
+    std::mutex mutex;
+    std::condition_variable released;
+};
+
+// Pembaca input biner atau hex yang menghasilkan satu sekuens n bit per panggilan
+class BitSource {
+public:
+    BitSource(FILE *file, bool hex) : file(file), hex(hex) {}
+
+    bool next(Bits &bits, size_t n) {
+        bits.resize(n);
+        size_t filled = 0;
+        while (filled < n) {
+            int byte = nextByte();
+            if (byte < 0) return false;
+            for (int b = 7; b >= 0 && filled < n; b--) bits[filled++] = (byte >> b) & 1;
+        }
+        return true;
+    }
+
+private:
+    int nextByte() {
+        if (!hex) return fgetc(file);
+        int hi = nextNibble();
+        if (hi < 0) return -1;
+        int lo = nextNibble();
+        if (lo < 0) return -1;
+        return (hi << 4) | lo;
+    }
+
+    int nextNibble() {
+        for (;;) {
+            int c = fgetc(file);
+            if (c == EOF) return -1;
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        }
+    }
+
+    FILE *file;
+    bool hex;
+};
+
+void printUsage(const char *program) {
+    fprintf(stderr,
+            "Penggunaan: %s [--hex] [-n bit] [-j thread] file [file ...]\n"
+            "  -n N     panjang sekuens dalam bit (default 1048576)\n"
+            "  -j N     jumlah thread (default: semua core)\n"
+            "  -M N     ukuran blok Block Frequency (default 128)\n"
+            "  -s m     panjang pola Serial (default 16)\n"
+            "  -a m     panjang pola Approximate Entropy (default 10)\n"
+            "  --hex    input berupa teks hex (karakter lain diabaikan)\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    size_t n = 1 << 20;
+    size_t blockM = 128;
+    int serialM = 16, apenM = 10;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool hex = false;
+
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&](void) -> const char * {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--hex") hex = true;
+        else if (arg == "-n") n = strtoul(value(), nullptr, 10);
+        else if (arg == "-j") threads = std::max(1ul, strtoul(value(), nullptr, 10));
+        else if (arg == "-M") blockM = strtoul(value(), nullptr, 10);
+        else if (arg == "-s") serialM = atoi(value());
+        else if (arg == "-a") apenM = atoi(value());
+        else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else files.push_back(argv[i]);
+    }
+    if (files.empty() || n < 128) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<TestSpec> tests = {
+        {"Frequency", frequencyTest, {}},
+        {"BlockFrequency", [=](const Bits &e) { return blockFrequencyTest(e, blockM); }, {}},
+        {"Runs", runsTest, {}},
+        {"LongestRun", longestRunTest, {}},
+        {"FFT", dftTest, {}},
+        {"Serial", [=](const Bits &e) { return serialTest(e, serialM); }, {}},
+        {"ApproximateEntropy", [=](const Bits &e) { return approximateEntropyTest(e, apenM); }, {}},
+        {"CumulativeSums", cumulativeSumsTest, {}},
+    };
+    std::mutex resultMutex;
+
+    ThreadPool pool(threads);
+    InFlightLimit limit(threads * 2);
+    size_t sequences = 0;
+
+    for (const char *path : files) {
+        FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, hex ? "r" : "rb");
+        if (!file) {
+            perror(path);
+            return 1;
+        }
+        static char readBuffer[1 << 20];
+        setvbuf(file, readBuffer, _IOFBF, sizeof(readBuffer));
+
+        BitSource source(file, hex);
+        for (;;) {
+            auto bits = std::make_shared<Bits>();
+            if (!source.next(*bits, n)) break;
+            limit.acquire();
+            auto remaining = std::make_shared<std::atomic<size_t>>(tests.size());
+            for (TestSpec &test : tests) {
+                pool.submit([&, bits, remaining, spec = &test] {
+                    std::vector<double> p = spec->run(*bits);
+                    {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        if (spec->pValues.size() < p.size()) spec->pValues.resize(p.size());
+                        for (size_t i = 0; i < p.size(); i++) spec->pValues[i].push_back(p[i]);
+                    }
+                    if (--*remaining == 0) limit.release();
+                });
+            }
+            sequences++;
+        }
+        if (file != stdin) fclose(file);
+    }
+    limit.waitIdle();
+
+    if (sequences == 0) {
+        fprintf(stderr, "Input lebih pendek dari satu sekuens (%zu bit)\n", n);
+        return 1;
+    }
+
+    // Rentang proporsi yang dapat diterima: (1-alpha) +- 3 sqrt(alpha(1-alpha)/m)
+    double pHat = 1.0 - ALPHA;
+    double margin = 3.0 * std::sqrt(pHat * ALPHA / sequences);
+    printf("%zu sekuens x %zu bit, %u thread\n", sequences, n, threads);
+    printf("Proporsi minimum lolos: %.4f\n\n", pHat - margin);
+    printf("%-22s %10s %10s %12s %s\n", "Test", "P-value", "Proportion", "Uniformity", "Result");
+
+    bool allPass = true;
+    for (TestSpec &test : tests) {
+        for (size_t sub = 0; sub < test.pValues.size(); sub++) {
+            std::vector<double> &p = test.pValues[sub];
+            size_t passed = std::count_if(p.begin(), p.end(), [](double v) { return v >= ALPHA; });
+            double proportion = (double)passed / p.size();
+
+            // Uniformitas p-value: chi-square 10 bin (butuh >= 10 sekuens agar bermakna)
+            size_t bins[10] = {};
+            for (double v : p) bins[std::min(9, (int)(v * 10))]++;
+            double expected = p.size() / 10.0, chi2 = 0;
+            for (size_t b : bins) chi2 += (b - expected) * (b - expected) / expected;
+            double uniformity = igamc(9 / 2.0, chi2 / 2.0);
+
+            bool pass = proportion >= pHat - margin && (p.size() < 10 || uniformity >= 0.0001);
+            allPass &= pass;
+
+            std::string name = test.name;
+            if (test.pValues.size() > 1) name += "[" + std::to_string(sub + 1) + "]";
+            double shown = p.size() == 1 ? p[0] : uniformity;
+            printf("%-22s %10.6f %5zu/%-4zu %12.6f %s\n", name.c_str(), shown, passed, p.size(),
+                   p.size() < 10 ? NAN : uniformity, pass ? "PASS" : "FAIL");
+        }
+    }
+    printf("\nP-value = p-value sekuens tunggal, atau uniformitas bila ada banyak sekuens.\n");
+    return allPass ? 0 : 2;
+}
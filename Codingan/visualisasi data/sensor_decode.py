@@ -0,0 +1,119 @@
+import argparse
+import csv
+import sys
+
+# Decoder pesan biner WsnSensorCodec.h (SENSOR_CODEC 1 di sender) di host.
+# Input: file berisi satu pesan hasil dekripsi (mis. dump dari receiver), atau beberapa
+# file sekaligus. Output: teks asli ("Data Suhu: 30.80,73.80...") atau CSV per rekaman.
+#
+# Penggunaan:
+#   python sensor_decode.py pesan.bin                 (cetak teks asli)
+#   python sensor_decode.py pesan_*.bin --csv out.csv (index,temperature,humidity)
+
+MAGIC = 0xD5
+
+
+def zigzag_decode(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def byte(self):
+        if self.pos >= len(self.data):
+            raise ValueError('pesan terpotong')
+        self.pos += 1
+        return self.data[self.pos - 1]
+
+    def varint(self):
+        value = 0
+        for shift in range(0, 35, 7):
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return value
+        raise ValueError('varint terlalu panjang')
+
+    def chunk(self):
+        n = self.byte()
+        if self.pos + n > len(self.data):
+            raise ValueError('pesan terpotong')
+        self.pos += n
+        return self.data[self.pos - n:self.pos]
+
+
+def to_int16(v):
+    v &= 0xFFFF
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def decode(data):
+    """Mengembalikan (first_index, prefix, [(t100, h100), ...], suffix)."""
+    if len(data) < 4 or data[0] != MAGIC or data[1] == 0:
+        raise ValueError('bukan pesan WsnSensorCodec')
+    interval = data[1]
+    count = data[2] | data[3] << 8
+    r = Reader(data)
+    r.pos = 4
+    first_index = r.varint()
+    prefix = r.chunk()
+    readings = []
+    t = h = 0
+    for i in range(count):
+        if i % interval == 0:
+            t = to_int16(zigzag_decode(r.varint()))
+            h = to_int16(r.varint())
+        else:
+            a = r.varint()
+            dt = a & 3
+            if dt == 3:
+                dt += r.varint()
+            t = to_int16(t + zigzag_decode(dt))
+            h = to_int16(h + zigzag_decode(a >> 2))
+        readings.append((t, h))
+    suffix = r.chunk()
+    return first_index, prefix, readings, suffix
+
+
+def format_value(v):
+    sign = '-' if v < 0 else ''
+    return f'{sign}{abs(v) // 100}.{abs(v) % 100:02d}'
+
+
+def to_text(prefix, readings, suffix):
+    body = ''.join(f'{format_value(t)},{format_value(h)}' for t, h in readings)
+    return prefix.decode('latin-1') + body + suffix.decode('latin-1')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode pesan biner sensor DHT22 (WsnSensorCodec)')
+    parser.add_argument('files', nargs='+')
+    parser.add_argument('--csv', help='tulis rekaman ke CSV alih-alih teks')
+    args = parser.parse_args()
+
+    writer = None
+    if args.csv:
+        out = open(args.csv, 'w', newline='')
+        writer = csv.writer(out)
+        writer.writerow(['file', 'index', 'temperature', 'humidity'])
+
+    for path in args.files:
+        with open(path, 'rb') as f:
+            data = f.read()
+        first_index, prefix, readings, suffix = decode(data)
+        if writer:
+            for i, (t, h) in enumerate(readings):
+                writer.writerow([path, first_index + i, t / 100, h / 100])
+        else:
+            sys.stdout.write(to_text(prefix, readings, suffix) + '\n')
+        print(f'# {path}: {len(data)} byte -> {len(readings)} rekaman', file=sys.stderr)
+
+    if writer:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()